@@ -156,6 +156,30 @@ namespace DarkMode
 		maxValue          ///< Sentinel value for internal validation (not intended for use).
 	};
 
+	/**
+	 * @brief Defines resource types counted by the library.
+	 *
+	 * Can be used in `DarkMode::getResourceCount` with static_cast<int>(ResourceType::'value').
+	 *
+	 * @see DarkMode::getResourceCount()
+	 */
+	enum class ResourceType : unsigned char
+	{
+		brush,        ///< GDI brushes.
+		pen,          ///< GDI pens.
+		font,         ///< GDI fonts.
+		dc,           ///< Memory device contexts.
+		bitmap,       ///< GDI bitmaps.
+		theme,        ///< Open `HTHEME` handles.
+		hook,         ///< Hook reference counts.
+		subclass,     ///< Installed subclasses of all subclass IDs.
+		stateBytes,   ///< Bytes of per-control state (subclass reference data).
+		textBytes,    ///< Bytes of per-thread scratch text buffers used while painting.
+		bufferReallocs, ///< Back buffer (re)allocations in the current second, peak is the highest rate.
+		region,       ///< GDI regions.
+		maxValue      ///< Sentinel value for internal validation (not intended for use).
+	};
+
 	enum class DarkModeType : unsigned char
 	{
 		light = 0,  ///< Light mode appearance.
@@ -406,6 +430,12 @@ namespace DarkMode
 	using fnGetLibInfo = auto (*)(int libInfoType) -> int;
 	inline fnGetLibInfo getLibInfo = nullptr;
 
+	using fnGetResourceCount = auto (*)(int resourceType, bool isPeak) -> int;
+	inline fnGetResourceCount getResourceCount = nullptr;
+
+	using fnGetSubclassCount = auto (*)(int subclassIndex, bool isPeak) -> int;
+	inline fnGetSubclassCount getSubclassCount = nullptr;
+
 	using fnInitDarkModeConfig = void (*)(UINT dmType);
 	inline fnInitDarkModeConfig initDarkModeConfig = nullptr;
 
@@ -424,6 +454,9 @@ namespace DarkMode
 	using fnSetColorizeTitleBarConfig = void (*)(bool colorize);
 	inline fnSetColorizeTitleBarConfig setColorizeTitleBarConfig = nullptr;
 
+	using fnSetAntialiasedShapesConfig = void (*)(bool enable);
+	inline fnSetAntialiasedShapesConfig setAntialiasedShapesConfig = nullptr;
+
 	using fnSetDarkModeConfigEx = void (*)(UINT dmType);
 	inline fnSetDarkModeConfigEx setDarkModeConfigEx = nullptr;
 
@@ -754,6 +787,29 @@ namespace DarkMode
 	using fnSetChildCtrlsTheme = void (*)(HWND hParent);
 	inline fnSetChildCtrlsTheme setChildCtrlsTheme = nullptr;
 
+	using fnEnableThemePlanCache = void (*)(bool enable);
+	inline fnEnableThemePlanCache enableThemePlanCache = nullptr;
+
+	using fnClearThemePlanCache = void (*)();
+	inline fnClearThemePlanCache clearThemePlanCache = nullptr;
+
+	using fnEnableDeferredChildSubclass = void (*)(bool enable);
+	inline fnEnableDeferredChildSubclass enableDeferredChildSubclass = nullptr;
+
+	using fnSetOpaqueWindow = void (*)(HWND hWnd, bool opaque);
+	inline fnSetOpaqueWindow setOpaqueWindow = nullptr;
+
+	using fnSetOpaqueClass = void (*)(const wchar_t* className, bool opaque);
+	inline fnSetOpaqueClass setOpaqueClass = nullptr;
+
+	using fnSetChildCtrlsMaxDepth = void (*)(UINT maxDepth);
+	inline fnSetChildCtrlsMaxDepth setChildCtrlsMaxDepth = nullptr;
+
+	using ThemeAsyncDoneProc = void (CALLBACK*)(HWND hParent, LPARAM lParam);
+
+	using fnSetChildCtrlsSubclassAndThemeAsync = void (*)(HWND hParent, bool subclass, bool theme, UINT sliceMs, ThemeAsyncDoneProc doneProc, LPARAM lParam);
+	inline fnSetChildCtrlsSubclassAndThemeAsync setChildCtrlsSubclassAndThemeAsync = nullptr;
+
 	using fnSetWindowEraseBgSubclass = void (*)(HWND hWnd);
 	inline fnSetWindowEraseBgSubclass setWindowEraseBgSubclass = nullptr;
 
@@ -841,6 +897,9 @@ namespace DarkMode
 	using fnSetDarkWndNotifySafe = void (*)(HWND hWnd);
 	inline fnSetDarkWndNotifySafe setDarkWndNotifySafe = nullptr;
 
+	using fnSetDarkWndNotifySafeAsync = void (*)(HWND hWnd, bool setSettingChangeSubclass, bool useWin11Features, ThemeAsyncDoneProc doneProc, LPARAM lParam);
+	inline fnSetDarkWndNotifySafeAsync setDarkWndNotifySafeAsync = nullptr;
+
 	using fnEnableThemeDialogTexture = void (*)(HWND hWnd, bool theme);
 	inline fnEnableThemeDialogTexture enableThemeDialogTexture = nullptr;
 
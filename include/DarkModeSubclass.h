@@ -168,6 +168,33 @@ namespace DarkMode
 		classic = 3 ///< Classic (non-themed or system) appearance.
 	};
 
+	/**
+	 * @brief Defines resource types counted by the library.
+	 *
+	 * Can be used in `DarkMode::getResourceCount` with static_cast<int>(ResourceType::'value').
+	 *
+	 * @see DarkMode::getResourceCount()
+	 */
+	enum class ResourceType : unsigned char
+	{
+		brush,        ///< GDI brushes.
+		pen,          ///< GDI pens.
+		font,         ///< GDI fonts.
+		dc,           ///< Memory device contexts.
+		bitmap,       ///< GDI bitmaps.
+		theme,        ///< Open `HTHEME` handles.
+		hook,         ///< Hook reference counts.
+		subclass,     ///< Installed subclasses of all subclass IDs.
+		stateBytes,   ///< Bytes of per-control state (subclass reference data).
+		textBytes,    ///< Bytes of per-thread scratch text buffers used while painting.
+		bufferReallocs, ///< Back buffer (re)allocations in the current second, peak is the highest rate.
+		region,       ///< GDI regions.
+		maxValue      ///< Sentinel value for internal validation (not intended for use).
+	};
+
+	/// Callback invoked when asynchronous child control theming is finished.
+	using ThemeAsyncDoneProc = void (CALLBACK*)(HWND hParent, LPARAM lParam);
+
 #ifdef __cplusplus
 	extern "C" {
 #endif
@@ -182,6 +209,28 @@ namespace DarkMode
 	 */
 	[[nodiscard]] int getLibInfo(int libInfoType);
 
+	/**
+	 * @brief Returns current or peak count of resources held by the library.
+	 *
+	 * Counters are always enabled, they are updated with relaxed atomics.
+	 *
+	 * @param resourceType The type of resource to query.
+	 * @param isPeak `true` for high-water mark, `false` for current count.
+	 * @return Resource count, or 0 for invalid type.
+	 *
+	 * @see ResourceType
+	 */
+	[[nodiscard]] DMLIB_API int getResourceCount(int resourceType, bool isPeak);
+
+	/**
+	 * @brief Returns current or peak count of installed subclasses for single subclass ID.
+	 *
+	 * @param subclassIndex Zero-based index of internal subclass ID, negative value to get number of indices.
+	 * @param isPeak `true` for high-water mark, `false` for current count.
+	 * @return Subclass count, number of indices for negative index, or 0 for invalid index.
+	 */
+	[[nodiscard]] DMLIB_API int getSubclassCount(int subclassIndex, bool isPeak);
+
 	// ========================================================================
 	// Config
 	// ========================================================================
@@ -216,6 +265,9 @@ namespace DarkMode
 	/// Sets dialog colors on title bar on Windows 11 setting.
 	DMLIB_API void setColorizeTitleBarConfig(bool colorize);
 
+	/// Sets whether rounded rectangles are painted with antialiased corners.
+	DMLIB_API void setAntialiasedShapesConfig(bool enable);
+
 	/// Applies dark mode settings based on the given configuration type. (DarkModeType values)
 	DMLIB_API void setDarkModeConfigEx(UINT dmType);
 
@@ -471,6 +523,21 @@ namespace DarkMode
 	/// Applies theming to all child controls of a parent window.
 	DMLIB_API void setChildCtrlsTheme(HWND hParent);
 
+	/// Enables or disables caching of child control theme plans.
+	DMLIB_API void enableThemePlanCache(bool enable);
+	/// Clears all cached child control theme plans.
+	DMLIB_API void clearThemePlanCache();
+	/// Enables or disables deferred subclassing of hidden child controls.
+	DMLIB_API void enableDeferredChildSubclass(bool enable);
+	/// Marks or unmarks a window as opaque for child control theming.
+	DMLIB_API void setOpaqueWindow(HWND hWnd, bool opaque);
+	/// Marks or unmarks a window class as opaque for child control theming.
+	DMLIB_API void setOpaqueClass(const wchar_t* className, bool opaque);
+	/// Sets maximum depth of child control enumeration.
+	DMLIB_API void setChildCtrlsMaxDepth(UINT maxDepth);
+	/// Applies theming and/or subclassing to child controls asynchronously in time slices.
+	DMLIB_API void setChildCtrlsSubclassAndThemeAsync(HWND hParent, bool subclass, bool theme, UINT sliceMs, ThemeAsyncDoneProc doneProc, LPARAM lParam);
+
 	// ========================================================================
 	// Window, Parent, And Other Subclassing
 	// ========================================================================
@@ -548,6 +615,8 @@ namespace DarkMode
 	DMLIB_API void setDarkWndNotifySafeEx(HWND hWnd, bool setSettingChangeSubclass, bool useWin11Features);
 	/// Applies visual styles; ctl color message, child controls, and custom drawing subclassings with Windows 11 features.
 	DMLIB_API void setDarkWndNotifySafe(HWND hWnd);
+	/// Asynchronous variant of `DarkMode::setDarkWndNotifySafeEx` for windows with large child trees.
+	DMLIB_API void setDarkWndNotifySafeAsync(HWND hWnd, bool setSettingChangeSubclass, bool useWin11Features, ThemeAsyncDoneProc doneProc, LPARAM lParam);
 
 	/// Enables or disables theme-based dialog background textures in classic mode.
 	DMLIB_API void enableThemeDialogTexture(HWND hWnd, bool theme);
@@ -28,16 +28,26 @@
 #include <uxtheme.h>
 #include <vsstyle.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "DmlibColor.h"
 #include "DmlibDpi.h"
+#include "DmlibGlyph.h"
 #include "DmlibHook.h"
 #if !defined(_DARKMODELIB_NO_INI_CONFIG)
 #include "DmlibIni.h"
 #endif
+#include "DmlibPaintHelper.h"
+#include "DmlibResource.h"
+#include "DmlibSlice.h"
 #include "DmlibSubclass.h"
 #include "DmlibSubclassControl.h"
 #include "DmlibSubclassWindow.h"
@@ -135,6 +145,54 @@ int DarkMode::getLibInfo(int libInfoType)
 	return -1; // should never happen
 }
 
+/**
+ * @brief Returns current or peak count of resources held by the library.
+ *
+ * Covers GDI objects, theme handles, hooks, installed subclasses,
+ * and bytes of per-control state and scratch text buffers created by the library.
+ * `ResourceType::bufferReallocs` is a rate, back buffer allocations per second.
+ *
+ * @param[in] resourceType  The type of resource to query, see @ref ResourceType.
+ * @param[in] isPeak        `true` for high-water mark, `false` for current count.
+ * @return Resource count, or 0 for invalid type.
+ *
+ * @see DarkMode::getSubclassCount()
+ */
+int DarkMode::getResourceCount(int resourceType, bool isPeak)
+{
+	if (resourceType < 0 || resourceType >= static_cast<int>(ResourceType::maxValue))
+	{
+		return 0;
+	}
+	return static_cast<int>(dmlib_resource::getCount(static_cast<ResourceType>(resourceType), isPeak));
+}
+
+/**
+ * @brief Returns current or peak count of installed subclasses for single subclass ID.
+ *
+ * @param[in] subclassIndex Zero-based index of internal subclass ID,
+ *                          negative value to get number of indices.
+ * @param[in] isPeak        `true` for high-water mark, `false` for current count.
+ * @return Subclass count, number of indices for negative index, or 0 for invalid index.
+ *
+ * @see DarkMode::getResourceCount()
+ */
+int DarkMode::getSubclassCount(int subclassIndex, bool isPeak)
+{
+	if (subclassIndex < 0)
+	{
+		return static_cast<int>(dmlib_subclass::kSubclassIDCount);
+	}
+
+	if (static_cast<size_t>(subclassIndex) >= dmlib_subclass::kSubclassIDCount)
+	{
+		return 0;
+	}
+
+	const auto subID = static_cast<dmlib_subclass::SubclassID>(static_cast<size_t>(dmlib_subclass::SubclassID::button) + static_cast<size_t>(subclassIndex));
+	return static_cast<int>(isPeak ? dmlib_subclass::getPeakLiveCount(subID) : dmlib_subclass::getLiveCount(subID));
+}
+
 /**
  * @brief Describes how the application responds to the system theme.
  *
@@ -200,6 +258,7 @@ namespace // anonymous
 		WinMode m_windowsMode = WinMode::disabled;
 		bool m_isInit = false;
 		bool m_isInitExperimental = false;
+		bool m_isDeferredSubclass = false;
 
 #if !defined(_DARKMODELIB_NO_INI_CONFIG)
 		std::wstring m_iniName;
@@ -266,12 +325,18 @@ void DarkMode::setThemeColors(const Colors* colors)
 	if (colors != nullptr)
 	{
 		getTheme().updateTheme(*colors);
+		dmlib_glyph::clearAtlas();
+		dmlib_subclass::clearCheckboxIcons();
+		dmlib_subclass::invalidatePaintCaches();
 	}
 }
 
 void DarkMode::updateThemeBrushesAndPens()
 {
 	getTheme().updateTheme();
+	dmlib_glyph::clearAtlas();
+	dmlib_subclass::clearCheckboxIcons();
+	dmlib_subclass::invalidatePaintCaches();
 }
 
 COLORREF DarkMode::getBackgroundColor()         { return getTheme().getColors().background; }
@@ -557,6 +622,23 @@ void DarkMode::setColorizeTitleBarConfig(bool colorize)
 	g_dmCfg.m_colorizeTitleBar = colorize;
 }
 
+/**
+ * @brief Sets whether rounded rectangles are painted with antialiased corners.
+ *
+ * When enabled, back buffers are 32-bpp DIB sections and rounded rectangles,
+ * frames and fills are rasterized directly into their pixels.
+ * Shapes which cannot be rasterized this way are still painted with GDI.
+ * Disabled by default.
+ *
+ * @param[in] enable `true` to paint antialiased rounded rectangles.
+ *
+ * @see dmlib_paint::paintRoundRect()
+ */
+void DarkMode::setAntialiasedShapesConfig(bool enable)
+{
+	dmlib_paint::enableRaster(enable);
+}
+
 #if !defined(_DARKMODELIB_NO_INI_CONFIG)
 /**
  * @brief Initializes dark mode configuration and colors from an INI file.
@@ -695,6 +777,48 @@ static void initOptions(const std::wstring& iniName)
 }
 #endif // !defined(_DARKMODELIB_NO_INI_CONFIG)
 
+/**
+ * @struct CheckboxIcon
+ * @brief Rendered checkbox state icon shared by list view and tree view state image lists.
+ *
+ * Icons are keyed by (DPI, dark/light, checkbox state ID) and copied
+ * into each control's image list via `ImageList_ReplaceIcon`.
+ */
+struct CheckboxIcon
+{
+	UINT m_dpi = USER_DEFAULT_SCREEN_DPI;
+	bool m_isDark = false;
+	int m_iStateId = 0;
+	HICON m_hIcon = nullptr;
+};
+
+namespace // anonymous
+{
+	/// Process-wide cache of rendered checkbox state icons.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<CheckboxIcon> m_icons;
+	} g_checkboxIconCache;
+} // anonymous namespace
+
+/**
+ * @brief Destroys all cached checkbox state icons.
+ *
+ * Called from `dmlib_subclass::invalidateThemeCache()` on dark mode configuration
+ * and system theme changes, and on theme color changes.
+ * Icons are rendered again on next use.
+ */
+void dmlib_subclass::clearCheckboxIcons() noexcept
+{
+	const std::lock_guard<std::mutex> lock(g_checkboxIconCache.m_mutex);
+	for (const auto& icon : g_checkboxIconCache.m_icons)
+	{
+		::DestroyIcon(icon.m_hIcon);
+	}
+	g_checkboxIconCache.m_icons.clear();
+}
+
 /**
  * @brief Applies dark mode settings based on the given configuration type.
  *
@@ -711,6 +835,7 @@ static void initOptions(const std::wstring& iniName)
 void DarkMode::setDarkModeConfigEx(UINT dmType)
 {
 	DarkMode::initDarkModeConfig(dmType);
+	dmlib_subclass::invalidateThemeCache();
 
 	const bool useDark = g_dmCfg.m_dmType == DarkModeType::dark;
 	dmlib_win32api::SetDarkMode(useDark, true);
@@ -1109,14 +1234,14 @@ static void setBtnCtrlSubclassAndTheme(HWND hWnd, DarkModeParams p) noexcept
 			{
 				if (p.m_theme)
 				{
-					::SetWindowTheme(hWnd, p.m_themeClassName, nullptr);
+					dmlib_subclass::setWindowTheme(hWnd, p.m_themeClassName, nullptr);
 				}
 				break;
 			}
 
 			if (DarkMode::isAtLeastWindows11() && p.m_theme)
 			{
-				::SetWindowTheme(hWnd, p.m_themeClassName, nullptr);
+				dmlib_subclass::setWindowTheme(hWnd, p.m_themeClassName, nullptr);
 			}
 
 			if (p.m_subclass)
@@ -1142,7 +1267,7 @@ static void setBtnCtrlSubclassAndTheme(HWND hWnd, DarkModeParams p) noexcept
 		{
 			if (p.m_theme)
 			{
-				::SetWindowTheme(hWnd, p.m_themeClassName, nullptr);
+				dmlib_subclass::setWindowTheme(hWnd, p.m_themeClassName, nullptr);
 			}
 			break;
 		}
@@ -1200,7 +1325,7 @@ static void setUpDownCtrlSubclassAndTheme(HWND hWnd, DarkModeParams p) noexcept
 {
 	if (p.m_theme)
 	{
-		::SetWindowTheme(hWnd, p.m_themeClassName, nullptr);
+		dmlib_subclass::setWindowTheme(hWnd, p.m_themeClassName, nullptr);
 	}
 
 	if (p.m_subclass)
@@ -1214,27 +1339,27 @@ static void setUpDownCtrlSubclassAndTheme(HWND hWnd, DarkModeParams p) noexcept
  *
  * @param[in] hWnd Handle to the tab control.
  *
- * @see dmlib_subclass::TabPaintSubclass()
+ * @see dmlib_subclass::TabSubclass()
  * @see removeTabCtrlPaintSubclass()
  */
 static void setTabCtrlPaintSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass<dmlib_subclass::TabData>(hWnd, dmlib_subclass::TabPaintSubclass, dmlib_subclass::SubclassID::tabPaint);
+	dmlib_subclass::setTabBehavior(hWnd, dmlib_subclass::TabBehavior::paint);
 }
 
 /**
  * @brief Removes the owner drawn subclass from a tab control.
  *
- * Cleans up the `TabData` instance and detaches the control's subclass proc.
+ * Clears `paint` behavior, `TabData` instance is cleaned up when no behavior is left.
  *
  * @param[in] hWnd Handle to the previously subclassed tab control.
  *
- * @see dmlib_subclass::TabPaintSubclass()
+ * @see dmlib_subclass::TabSubclass()
  * @see setTabCtrlPaintSubclass()
  */
 static void removeTabCtrlPaintSubclass(HWND hWnd) noexcept
 {
-	dmlib_subclass::RemoveSubclass<dmlib_subclass::TabData>(hWnd, dmlib_subclass::TabPaintSubclass, dmlib_subclass::SubclassID::tabPaint);
+	dmlib_subclass::removeTabBehavior(hWnd, dmlib_subclass::TabBehavior::paint);
 }
 
 /**
@@ -1245,12 +1370,12 @@ static void removeTabCtrlPaintSubclass(HWND hWnd) noexcept
  *
  * @param[in] hWnd Handle to the tab control.
  *
- * @see dmlib_subclass::TabUpDownSubclass()
+ * @see dmlib_subclass::TabSubclass()
  * @see DarkMode::removeTabCtrlUpDownSubclass()
  */
 void DarkMode::setTabCtrlUpDownSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass(hWnd, dmlib_subclass::TabUpDownSubclass, dmlib_subclass::SubclassID::tabUpDown);
+	dmlib_subclass::setTabBehavior(hWnd, dmlib_subclass::TabBehavior::upDown);
 }
 
 /**
@@ -1260,19 +1385,19 @@ void DarkMode::setTabCtrlUpDownSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed tab control.
  *
- * @see dmlib_subclass::TabUpDownSubclass()
+ * @see dmlib_subclass::TabSubclass()
  * @see DarkMode::setTabCtrlUpDownSubclass()
  */
 void DarkMode::removeTabCtrlUpDownSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass(hWnd, dmlib_subclass::TabUpDownSubclass, dmlib_subclass::SubclassID::tabUpDown);
+	dmlib_subclass::removeTabBehavior(hWnd, dmlib_subclass::TabBehavior::upDown);
 }
 
 /**
  * @brief Applies owner drawn and up-down (spinner) child detection subclassings for a tab control.
  *
- * Applies both @ref DarkMode::TabPaintSubclass() for custom drawing
- * and @ref DarkMode::TabUpDownSubclass() for detecting and subclassing
+ * Enables both `paint` behavior of @ref dmlib_subclass::TabSubclass() for custom drawing
+ * and `upDown` behavior for detecting and subclassing
  * the associated up-down (spinner) control.
  *
  * @param[in] hWnd Handle to the tab control.
@@ -1405,7 +1530,7 @@ static void setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(HWND hWnd, DarkM
 		if (p.m_theme && (isListBox || hasScrollBar))
 		{
 			// dark scroll bars for list box or edit control
-			::SetWindowTheme(hWnd, p.m_themeClassName, nullptr);
+			dmlib_subclass::setWindowTheme(hWnd, p.m_themeClassName, nullptr);
 		}
 
 		const auto nExStyle = ::GetWindowLongPtr(hWnd, GWL_EXSTYLE);
@@ -1417,7 +1542,7 @@ static void setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(HWND hWnd, DarkM
 			DarkMode::setCustomBorderForListBoxOrEditCtrlSubclass(hWnd);
 		}
 
-		if (::GetWindowSubclass(hWnd, dmlib_subclass::CustomBorderSubclass, static_cast<UINT_PTR>(dmlib_subclass::SubclassID::customBorder), nullptr) == TRUE)
+		if (dmlib_subclass::isSubclassRegistered(hWnd, dmlib_subclass::SubclassID::customBorder))
 		{
 			const bool enableClientEdge = !DarkMode::isEnabled();
 			DarkMode::setWindowExStyle(hWnd, enableClientEdge, WS_EX_CLIENTEDGE);
@@ -1510,7 +1635,7 @@ static void setComboBoxCtrlSubclassAndTheme(HWND hWnd, DarkModeParams p)
 			}
 
 			// dark scroll bar for list box of combo box
-			::SetWindowTheme(cbi.hwndList, p.m_themeClassName, nullptr);
+			dmlib_subclass::setWindowTheme(cbi.hwndList, p.m_themeClassName, nullptr);
 		}
 
 		if (!dmlib_subclass::isThemePrefered() && p.m_subclass)
@@ -1719,8 +1844,8 @@ void DarkMode::removeHeaderCtrlSubclass(HWND hWnd)
 /**
  * @brief Applies owner drawn subclassing to a status bar control.
  *
- * Retrieves the status bar system font and passes it to the subclass data
- * (`StatusBarData`).
+ * The subclass data (`StatusBarData`) retrieves the status bar system font
+ * from the shared font cache.
  *
  * @param[in] hWnd Handle to the status bar control.
  *
@@ -1731,8 +1856,7 @@ void DarkMode::removeHeaderCtrlSubclass(HWND hWnd)
  */
 void DarkMode::setStatusBarCtrlSubclass(HWND hWnd)
 {
-	const auto lf = LOGFONT{ dmlib_dpi::getSysFontForDpi(::GetParent(hWnd), dmlib_dpi::FontType::status) };
-	dmlib_subclass::SetSubclass<dmlib_subclass::StatusBarData>(hWnd, dmlib_subclass::StatusBarSubclass, dmlib_subclass::SubclassID::statusBar, ::CreateFontIndirectW(&lf));
+	dmlib_subclass::SetSubclass<dmlib_subclass::StatusBarData>(hWnd, dmlib_subclass::StatusBarSubclass, dmlib_subclass::SubclassID::statusBar, hWnd);
 }
 
 /**
@@ -1834,7 +1958,7 @@ static void setProgressBarCtrlSubclass(HWND hWnd, DarkModeParams p) noexcept
 		}
 		else if (doesWin11SupportDarkThemeStyle())
 		{
-			::SetWindowTheme(hWnd, DarkMode::isExperimentalActive() ? L"DarkMode_CopyEngine" : nullptr, nullptr);
+			dmlib_subclass::setWindowTheme(hWnd, DarkMode::isExperimentalActive() ? L"DarkMode_CopyEngine" : nullptr, nullptr);
 		}
 	}
 
@@ -2155,16 +2279,193 @@ static void setMonthCalendarCtrlTheme(HWND hWnd, DarkModeParams p) noexcept
 	}
 }
 
+namespace // anonymous
+{
+	/// Child enumeration limits, windows and classes whose subtree is skipped.
+	struct
+	{
+		std::vector<HWND> m_opaqueWnds;
+		std::vector<std::wstring> m_opaqueClasses;
+		UINT m_maxDepth = 0;
+	} g_childEnumCfg;
+} // anonymous namespace
+
 /**
- * @brief Callback function used to enumerate and apply theming/subclassing to child controls.
+ * @brief Callback invoked for each child window by `enumChildCtrls`.
  *
- * Called in `setChildCtrlsSubclassAndTheme()` and `setChildCtrlsTheme()`
- * to inspect each child window's class name and apply appropriate theming
- * and/or subclassing logic based on control type.
+ * `className` is the window class name of `hWnd` if it was already retrieved
+ * for the opaque class check, otherwise it is empty.
+ * Returns `false` to stop the enumeration.
+ */
+using ChildCtrlProc = bool (*)(HWND hWnd, const std::wstring& className, LPARAM lParam);
+
+/**
+ * @brief Checks if window is marked as opaque for child enumeration.
+ *
+ * @param[in]   hWnd        Handle to the window.
+ * @param[in]   className   Window class name of `hWnd`, must be retrieved if opaque classes are set.
+ * @return `true` if window was set as opaque or has opaque window class.
+ *
+ * @see DarkMode::setOpaqueWindow()
+ * @see DarkMode::setOpaqueClass()
+ */
+[[nodiscard]] static bool isOpaqueWnd(HWND hWnd, const std::wstring& className)
+{
+	const auto& wnds = g_childEnumCfg.m_opaqueWnds;
+	if (std::find(wnds.begin(), wnds.end(), hWnd) != wnds.end())
+	{
+		return true;
+	}
+
+	const auto& classes = g_childEnumCfg.m_opaqueClasses;
+	return std::find(classes.begin(), classes.end(), className) != classes.end();
+}
+
+/**
+ * @brief Recursively walks child windows, not descending into opaque windows.
+ *
+ * Opaque window itself is passed to `enumProc`, only its descendants are skipped.
+ * Children of each level are collected before `enumProc` is invoked,
+ * windows destroyed meanwhile are skipped.
+ * Class name is retrieved only when opaque classes are set and is passed
+ * to `enumProc`, so it does not need to be retrieved again.
+ *
+ * @param[in]   hParent     Handle to the parent window.
+ * @param[in]   depth       Depth of the children of `hParent`, starting from 1.
+ * @param[in]   enumProc    Callback invoked for each visited child window.
+ * @param[in]   lParam      Application-defined value passed to `enumProc`.
+ * @return `false` if `enumProc` stopped the enumeration.
+ */
+static bool walkChildCtrls(HWND hParent, UINT depth, ChildCtrlProc enumProc, LPARAM lParam)
+{
+	const bool checkClass = !g_childEnumCfg.m_opaqueClasses.empty();
+	const bool canDescend = g_childEnumCfg.m_maxDepth == 0 || depth < g_childEnumCfg.m_maxDepth;
+
+	// `enumProc` can create, destroy or reorder siblings,
+	// snapshot the level instead of following `GW_HWNDNEXT` links
+	std::vector<HWND> children;
+	for (HWND hChild = ::GetWindow(hParent, GW_CHILD);
+		hChild != nullptr;
+		hChild = ::GetWindow(hChild, GW_HWNDNEXT))
+	{
+		children.push_back(hChild);
+	}
+
+	for (HWND hChild : children)
+	{
+		if (::IsWindow(hChild) == FALSE)
+		{
+			continue;
+		}
+
+		const std::wstring className = checkClass ? dmlib_subclass::getWndClassName(hChild) : std::wstring{};
+		if (!enumProc(hChild, className, lParam))
+		{
+			return false;
+		}
+
+		if (canDescend
+			&& !isOpaqueWnd(hChild, className)
+			&& !walkChildCtrls(hChild, depth + 1, enumProc, lParam))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @struct ChildCtrlEnumParams
+ * @brief Adapts `ChildCtrlProc` callback for `EnumChildWindows`.
+ */
+struct ChildCtrlEnumParams
+{
+	ChildCtrlProc m_enumProc = nullptr;
+	LPARAM m_lParam = 0;
+};
+
+/**
+ * @brief `EnumChildWindows` callback forwarding to `ChildCtrlProc` without class name.
  *
  * @param[in]   hWnd    Handle to the window being enumerated.
- * @param[in]   lParam  Pointer to a `DarkModeParams` structure containing theming flags and settings.
- * @return `TRUE`   to continue enumeration.
+ * @param[in]   lParam  Pointer to `ChildCtrlEnumParams`.
+ * @return `FALSE` if the forwarded callback stopped the enumeration.
+ */
+static BOOL CALLBACK ChildCtrlEnumProc(HWND hWnd, LPARAM lParam)
+{
+	const auto& ep = *reinterpret_cast<ChildCtrlEnumParams*>(lParam);
+	return ep.m_enumProc(hWnd, std::wstring{}, ep.m_lParam) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Enumerates child windows with respect to opaque windows and maximum depth.
+ *
+ * Replacement for `EnumChildWindows` used by child control theming.
+ * Falls back to `EnumChildWindows` when no limits are set.
+ *
+ * @param[in]   hParent     Handle to the parent window.
+ * @param[in]   enumProc    Callback invoked for each child window.
+ * @param[in]   lParam      Application-defined value passed to `enumProc`.
+ *
+ * @see DarkMode::setOpaqueWindow()
+ * @see DarkMode::setOpaqueClass()
+ * @see DarkMode::setChildCtrlsMaxDepth()
+ */
+static void enumChildCtrls(HWND hParent, ChildCtrlProc enumProc, LPARAM lParam)
+{
+	if (g_childEnumCfg.m_opaqueWnds.empty()
+		&& g_childEnumCfg.m_opaqueClasses.empty()
+		&& g_childEnumCfg.m_maxDepth == 0)
+	{
+		ChildCtrlEnumParams ep{ enumProc, lParam };
+		::EnumChildWindows(hParent, ChildCtrlEnumProc, reinterpret_cast<LPARAM>(&ep));
+		return;
+	}
+
+	walkChildCtrls(hParent, 1, enumProc, lParam);
+}
+
+/**
+ * @enum CtrlKind
+ * @brief Control kinds resolved from the window class name during child enumeration.
+ *
+ * Used to separate class name lookup from the actual theming/subclassing logic,
+ * so that resolved kinds can be stored in theme plans and replayed later.
+ *
+ * @see getCtrlKind()
+ * @see applyCtrlKind()
+ */
+enum class CtrlKind : unsigned char
+{
+	unknown,
+	button,
+	staticText,
+	comboBox,
+	edit,
+	listBox,
+	listView,
+	treeView,
+	rebar,
+	toolbar,
+	upDown,
+	tab,
+	statusBar,
+	scrollBar,
+	comboBoxEx,
+	progressBar,
+	sysLink,
+	trackbar,
+	richEdit,
+	ipAddress,
+	hotKey,
+	monthCalendar
+};
+
+/**
+ * @brief Resolves the control kind from a window class name.
+ *
+ * @param[in] className Window class name of the window being inspected.
+ * @return Resolved @ref CtrlKind, `CtrlKind::unknown` for unsupported classes.
  *
  * @note
  * - Currently handles these controls:
@@ -2172,254 +2473,1288 @@ static void setMonthCalendarCtrlTheme(HWND hWnd, DarkModeParams p) noexcept
  *      `WC_LISTVIEW`, `WC_TREEVIEW`, `REBARCLASSNAME`, `TOOLBARCLASSNAME`,
  *      `UPDOWN_CLASS`, `WC_TABCONTROL`, `STATUSCLASSNAME`, `WC_SCROLLBAR`,
  *      `WC_COMBOBOXEX`, `PROGRESS_CLASS`, `WC_LINK`, `TRACKBAR_CLASS`,
- *      `RICHEDIT_CLASS`, `MSFTEDIT_CLASS`, `WC_IPADDRESS`, and `HOTKEY_CLASS`
+ *      `RICHEDIT_CLASS`, `MSFTEDIT_CLASS`, `WC_IPADDRESS`, `HOTKEY_CLASS`,
+ *      and `MONTHCAL_CLASS`
  * - The `#32770` dialog class is commented out for debugging purposes.
- *
- * @see DarkMode::setChildCtrlsSubclassAndTheme()
- * @see DarkMode::setChildCtrlsTheme()
- * @see DarkModeParams
- * @see DarkMode::setBtnCtrlSubclassAndTheme()
- * @see DarkMode::setStaticTextCtrlSubclass()
- * @see DarkMode::setComboBoxCtrlSubclassAndTheme()
- * @see DarkMode::setCustomBorderForListBoxOrEditCtrlSubclassAndTheme()
- * @see DarkMode::setListViewCtrlSubclassAndTheme()
- * @see DarkMode::setTreeViewCtrlTheme()
- * @see DarkMode::setRebarCtrlSubclass()
- * @see DarkMode::setToolbarCtrlTheme()
- * @see DarkMode::setUpDownCtrlSubclassAndTheme()
- * @see DarkMode::setTabCtrlSubclassAndTheme()
- * @see DarkMode::setStatusBarCtrlSubclass()
- * @see DarkMode::setScrollBarCtrlTheme()
- * @see DarkMode::setComboBoxExCtrlSubclass()
- * @see DarkMode::setProgressBarCtrlSubclass()
- * @see DarkMode::enableSysLinkCtrlCtlColor()
- * @see DarkMode::setTrackbarCtrlTheme()
- * @see DarkMode::setRichEditCtrlTheme()
- * @see DarkMode::setIPAddressCtrlSubclass()
- * @see DarkMode::setHotKeyCtrlSubclass()
  */
-static BOOL CALLBACK DarkEnumChildProc(HWND hWnd, LPARAM lParam)
+[[nodiscard]] static CtrlKind getCtrlKind(const std::wstring& className)
 {
-	const auto& p = *reinterpret_cast<DarkModeParams*>(lParam);
-	const std::wstring className = dmlib_subclass::getWndClassName(hWnd);
-
 	if (className == WC_BUTTON)
 	{
-		setBtnCtrlSubclassAndTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::button;
 	}
 
 	if (className == WC_STATIC)
 	{
-		setStaticTextCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::staticText;
 	}
 
 	if (className == WC_COMBOBOX)
 	{
-		setComboBoxCtrlSubclassAndTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::comboBox;
 	}
 
 	if (className == WC_EDIT)
 	{
-		setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(hWnd, p, false);
-		return TRUE;
+		return CtrlKind::edit;
 	}
 
 	if (className == WC_LISTBOX)
 	{
-		setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(hWnd, p, true);
-		return TRUE;
+		return CtrlKind::listBox;
 	}
 
 	if (className == WC_LISTVIEW)
 	{
-		setListViewCtrlSubclassAndTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::listView;
 	}
 
 	if (className == WC_TREEVIEW)
 	{
-		setTreeViewCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::treeView;
 	}
 
 	if (className == REBARCLASSNAME)
 	{
-		setRebarCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::rebar;
 	}
 
 	if (className == TOOLBARCLASSNAME)
 	{
-		setToolbarCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::toolbar;
 	}
 
 	if (className == UPDOWN_CLASS)
 	{
-		setUpDownCtrlSubclassAndTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::upDown;
 	}
 
 	if (className == WC_TABCONTROL)
 	{
-		setTabCtrlSubclassAndTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::tab;
 	}
 
 	if (className == STATUSCLASSNAME)
 	{
-		setStatusBarCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::statusBar;
 	}
 
 	if (className == WC_SCROLLBAR)
 	{
-		setScrollBarCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::scrollBar;
 	}
 
 	if (className == WC_COMBOBOXEX)
 	{
-		setComboBoxExCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::comboBoxEx;
 	}
 
 	if (className == PROGRESS_CLASS)
 	{
-		setProgressBarCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::progressBar;
 	}
 
 	if (className == WC_LINK)
 	{
-		enableSysLinkCtrlCtlColor(hWnd, p);
-		return TRUE;
+		return CtrlKind::sysLink;
 	}
 
 	if (className == TRACKBAR_CLASS)
 	{
-		setTrackbarCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::trackbar;
 	}
 
 	if (className == RICHEDIT_CLASS || className == MSFTEDIT_CLASS) // rich edit controls 2.0, 3.0, and 4.1
 	{
-		setRichEditCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::richEdit;
 	}
 
 	if (className == WC_IPADDRESS)
 	{
-		setIPAddressCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::ipAddress;
 	}
 
 	if (className == HOTKEY_CLASS)
 	{
-		setHotKeyCtrlSubclass(hWnd, p);
-		return TRUE;
+		return CtrlKind::hotKey;
 	}
 
 	if (className == MONTHCAL_CLASS) // month calendar
 	{
-		setMonthCalendarCtrlTheme(hWnd, p);
-		return TRUE;
+		return CtrlKind::monthCalendar;
 	}
 
 #if 0 // for debugging
 	if (className == L"#32770") // dialog
 	{
-		return TRUE;
+		return CtrlKind::unknown;
 	}
 
 	if (className == DATETIMEPICK_CLASS) // date and time picker
 	{
-		return TRUE;
+		return CtrlKind::unknown;
 	}
 #endif
-	return TRUE;
+	return CtrlKind::unknown;
 }
 
 /**
- * @brief Applies theming and/or subclassing to all child controls of a parent window.
- *
- * Enumerates all child windows of the specified parent and dispatches them to
- * `DarkEnumChildProc`, which applies control-specific theming and/or subclassing logic
- * based on their class name and the provided parameters.
- *
- * Mainly used when initializing parent control.
- *
- * @param[in]   hParent     Handle to the parent window whose child controls will be themed and/or subclassed.
- * @param[in]   subclass    Whether to apply subclassing.
- * @param[in]   theme       Whether to apply theming.
+ * @brief Resolves the control kind of a window based on its class name.
  *
- * @see DarkMode::setChildCtrlsSubclassAndTheme()
- * @see DarkMode::DarkEnumChildProc()
- * @see DarkModeParams
+ * @param[in]   hWnd        Handle to the window being inspected.
+ * @param[in]   className   Class name of `hWnd` if already retrieved, empty otherwise.
+ * @return Resolved @ref CtrlKind, `CtrlKind::unknown` for unsupported classes.
  */
-void DarkMode::setChildCtrlsSubclassAndThemeEx(HWND hParent, bool subclass, bool theme)
+[[nodiscard]] static CtrlKind getCtrlKind(HWND hWnd, const std::wstring& className = {})
 {
-	DarkModeParams p{
-		DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr
-		, subclass
-		, theme
-	};
-
-	::EnumChildWindows(hParent, DarkEnumChildProc, reinterpret_cast<LPARAM>(&p));
+	return getCtrlKind(className.empty() ? dmlib_subclass::getWndClassName(hWnd) : className);
 }
 
 /**
- * @brief Wrapper for `DarkMode::setChildCtrlsSubclassAndThemeEx`.
- *
- * Forwards to `DarkMode::setChildCtrlsSubclassAndThemeEx` with `subclass` and `theme` parameters set as `true`.
+ * @brief Applies theming/subclassing to a control based on its resolved kind.
  *
- * @param[in] hParent Handle to the parent window whose child controls will be themed and/or subclassed.
+ * @param[in]   hWnd    Handle to the control.
+ * @param[in]   kind    Control kind resolved by @ref getCtrlKind.
+ * @param[in]   p       Parameters controlling whether to apply theming and/or subclassing.
  *
- * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ * @see DarkModeParams
+ * @see DarkMode::setBtnCtrlSubclassAndTheme()
+ * @see DarkMode::setStaticTextCtrlSubclass()
+ * @see DarkMode::setComboBoxCtrlSubclassAndTheme()
+ * @see DarkMode::setCustomBorderForListBoxOrEditCtrlSubclassAndTheme()
+ * @see DarkMode::setListViewCtrlSubclassAndTheme()
+ * @see DarkMode::setTreeViewCtrlTheme()
+ * @see DarkMode::setRebarCtrlSubclass()
+ * @see DarkMode::setToolbarCtrlTheme()
+ * @see DarkMode::setUpDownCtrlSubclassAndTheme()
+ * @see DarkMode::setTabCtrlSubclassAndTheme()
+ * @see DarkMode::setStatusBarCtrlSubclass()
+ * @see DarkMode::setScrollBarCtrlTheme()
+ * @see DarkMode::setComboBoxExCtrlSubclass()
+ * @see DarkMode::setProgressBarCtrlSubclass()
+ * @see DarkMode::enableSysLinkCtrlCtlColor()
+ * @see DarkMode::setTrackbarCtrlTheme()
+ * @see DarkMode::setRichEditCtrlTheme()
+ * @see DarkMode::setIPAddressCtrlSubclass()
+ * @see DarkMode::setHotKeyCtrlSubclass()
  */
-void DarkMode::setChildCtrlsSubclassAndTheme(HWND hParent)
+static void applyCtrlKind(HWND hWnd, CtrlKind kind, const DarkModeParams& p)
 {
-	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, true, true);
-}
+	switch (kind)
+	{
+		case CtrlKind::button:
+		{
+			setBtnCtrlSubclassAndTheme(hWnd, p);
+			break;
+		}
 
-/**
- * @brief Applies theming to all child controls of a parent window.
- *
- * Enumerates child windows of the specified parent and applies theming without subclassing.
- * The theming behavior adapts based on OS support and compile-time flags.
- * If `_DARKMODELIB_ALLOW_OLD_OS > 1` is true, theming is applied unconditionally.
- * Otherwise, theming is applied only if the OS is Windows 10 or newer.
- * The function delegates to `setChildCtrlsSubclassAndTheme()` with appropriate flags.
- *
- * Mainly used when changing mode.
- *
- * @param[in] hParent Handle to the parent window whose child controls will be themed.
- *
- * @see DarkMode::setChildCtrlsSubclassAndTheme()
- */
-void DarkMode::setChildCtrlsTheme(HWND hParent)
-{
-#if defined(_DARKMODELIB_ALLOW_OLD_OS) && (_DARKMODELIB_ALLOW_OLD_OS > 1)
-	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, false, true);
-#else
-	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, false, DarkMode::isAtLeastWindows10());
-#endif
-}
+		case CtrlKind::staticText:
+		{
+			setStaticTextCtrlSubclass(hWnd, p);
+			break;
+		}
 
-/**
- * @brief Applies window subclassing to handle `WM_ERASEBKGND` message.
- *
- * @param[in] hWnd Handle to the control to subclass.
- *
- * @see dmlib_subclass::WindowEraseBgSubclass()
- * @see DarkMode::removeWindowEraseBgSubclass()
- */
-void DarkMode::setWindowEraseBgSubclass(HWND hWnd)
+		case CtrlKind::comboBox:
+		{
+			setComboBoxCtrlSubclassAndTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::edit:
+		{
+			setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(hWnd, p, false);
+			break;
+		}
+
+		case CtrlKind::listBox:
+		{
+			setCustomBorderForListBoxOrEditCtrlSubclassAndTheme(hWnd, p, true);
+			break;
+		}
+
+		case CtrlKind::listView:
+		{
+			setListViewCtrlSubclassAndTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::treeView:
+		{
+			setTreeViewCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::rebar:
+		{
+			setRebarCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::toolbar:
+		{
+			setToolbarCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::upDown:
+		{
+			setUpDownCtrlSubclassAndTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::tab:
+		{
+			setTabCtrlSubclassAndTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::statusBar:
+		{
+			setStatusBarCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::scrollBar:
+		{
+			setScrollBarCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::comboBoxEx:
+		{
+			setComboBoxExCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::progressBar:
+		{
+			setProgressBarCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::sysLink:
+		{
+			enableSysLinkCtrlCtlColor(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::trackbar:
+		{
+			setTrackbarCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::richEdit:
+		{
+			setRichEditCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::ipAddress:
+		{
+			setIPAddressCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::hotKey:
+		{
+			setHotKeyCtrlSubclass(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::monthCalendar:
+		{
+			setMonthCalendarCtrlTheme(hWnd, p);
+			break;
+		}
+
+		case CtrlKind::unknown:
+		{
+			break;
+		}
+	}
+}
+
+/// Flag in deferred subclass reference data for applying subclassing.
+static constexpr DWORD_PTR kDeferredSubclassFlag = 0x100;
+/// Flag in deferred subclass reference data for applying theming.
+static constexpr DWORD_PTR kDeferredThemeFlag = 0x200;
+/// Mask in deferred subclass reference data for control kind.
+static constexpr DWORD_PTR kDeferredKindMask = 0xFF;
+
+/**
+ * @brief Finds the outermost hidden ancestor of a window below the root window.
+ *
+ * Checks the `WS_VISIBLE` style instead of `IsWindowVisible`, so hidden top-level
+ * windows, e.g. dialogs during `WM_INITDIALOG`, do not hide their children.
+ *
+ * @param[in]   hWnd    Handle to the window.
+ * @param[in]   hRoot   Handle to the root window, not checked itself.
+ * @return Handle to the hidden ancestor closest to the root, or `nullptr` if all ancestors have `WS_VISIBLE`.
+ */
+[[nodiscard]] static HWND getHiddenAncestor(HWND hWnd, HWND hRoot) noexcept
+{
+	return dmlib_slice::findHiddenAncestor(hWnd, hRoot,
+		[](HWND hCurrent) -> HWND {
+			if ((::GetWindowLongPtrW(hCurrent, GWL_STYLE) & WS_CHILD) != WS_CHILD)
+			{
+				return nullptr;
+			}
+			return ::GetAncestor(hCurrent, GA_PARENT);
+		},
+		[](HWND hCurrent) -> bool {
+			return (::GetWindowLongPtrW(hCurrent, GWL_STYLE) & WS_VISIBLE) == WS_VISIBLE;
+		});
+}
+
+/**
+ * @brief Checks if `WM_WINDOWPOSCHANGED` message is sent because the window was shown.
+ *
+ * @param[in] lParam Pointer to `WINDOWPOS` structure.
+ * @return `true` if `SWP_SHOWWINDOW` flag is set.
+ */
+[[nodiscard]] static bool isShownWindowPos(LPARAM lParam) noexcept
+{
+	const auto* pWndPos = reinterpret_cast<const WINDOWPOS*>(lParam);
+	return (pWndPos->flags & SWP_SHOWWINDOW) == SWP_SHOWWINDOW;
+}
+
+static LRESULT CALLBACK DeferredCtrlSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
+static void setDeferredContainerSubclass(HWND hWnd);
+
+/**
+ * @brief Applies the full handler to a control with deferred subclass, or keeps waiting.
+ *
+ * If the control or one of its ancestors below the root window is still hidden,
+ * the deferred subclass is kept and the hidden ancestor is hooked instead.
+ *
+ * @param[in]   hWnd    Handle to the control with `DeferredCtrlSubclass`.
+ * @param[in]   hRoot   Handle to the window which was just shown.
+ *
+ * @see DeferredCtrlSubclass()
+ * @see DeferredContainerSubclass()
+ */
+static void applyDeferredCtrl(HWND hWnd, HWND hRoot)
+{
+	if ((::GetWindowLongPtrW(hWnd, GWL_STYLE) & WS_VISIBLE) != WS_VISIBLE)
+	{
+		// control waits for its own show
+		return;
+	}
+
+	if (HWND hHidden = getHiddenAncestor(hWnd, hRoot); hHidden != nullptr)
+	{
+		setDeferredContainerSubclass(hHidden);
+		return;
+	}
+
+	static constexpr auto subID = dmlib_subclass::SubclassID::deferredCtrl;
+	static constexpr auto subclassID = static_cast<UINT_PTR>(subID);
+	if (!dmlib_subclass::isSubclassRegistered(hWnd, subID))
+	{
+		return;
+	}
+
+	// read before removal, registry entry is dropped with the subclass
+	const DWORD_PTR dwRefData = dmlib_subclass::getSubclassRefData(hWnd, subID);
+
+	dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, DeferredCtrlSubclass, subclassID);
+
+	const DarkModeParams p{
+		DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr
+		, (dwRefData & kDeferredSubclassFlag) == kDeferredSubclassFlag
+		, (dwRefData & kDeferredThemeFlag) == kDeferredThemeFlag
+	};
+	applyCtrlKind(hWnd, static_cast<CtrlKind>(dwRefData & kDeferredKindMask), p);
+}
+
+/**
+ * @brief Window subclass procedure for deferred theming/subclassing of hidden controls.
+ *
+ * Lightweight subclass without allocated data, installed instead of the full handler
+ * on controls that are hidden during child enumeration.
+ * When the control itself is shown (`WM_WINDOWPOSCHANGED` with `SWP_SHOWWINDOW`),
+ * the subclass removes itself and applies the full handler for the recorded control kind,
+ * unless an ancestor is still hidden.
+ *
+ * @param[in]   hWnd        Window handle being subclassed.
+ * @param[in]   uMsg        Message identifier.
+ * @param[in]   wParam      Message-specific data.
+ * @param[in]   lParam      Message-specific data.
+ * @param[in]   uIdSubclass Subclass identifier.
+ * @param[in]   dwRefData   Packed control kind with subclass and theme flags.
+ * @return LRESULT Result of message processing.
+ *
+ * @see applyOrDeferCtrlKind()
+ * @see DarkMode::enableDeferredChildSubclass()
+ */
+static LRESULT CALLBACK DeferredCtrlSubclass(
+	HWND hWnd,
+	UINT uMsg,
+	WPARAM wParam,
+	LPARAM lParam,
+	UINT_PTR uIdSubclass,
+	[[maybe_unused]] DWORD_PTR dwRefData
+)
+{
+	static constexpr dmlib_subclass::MsgFilter kMsgFilter{ WM_NCDESTROY, WM_WINDOWPOSCHANGED };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	switch (uMsg)
+	{
+		case WM_NCDESTROY:
+		{
+			dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, DeferredCtrlSubclass, uIdSubclass);
+			break;
+		}
+
+		case WM_WINDOWPOSCHANGED:
+		{
+			if (isShownWindowPos(lParam))
+			{
+				const LRESULT lr = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+				applyDeferredCtrl(hWnd, ::GetAncestor(hWnd, GA_ROOT));
+				return lr;
+			}
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+/**
+ * @brief Callback function used to apply deferred handlers to descendants of shown container.
+ *
+ * @param[in]   hWnd    Handle to the window being enumerated.
+ * @param[in]   lParam  Handle to the shown container window.
+ * @return `TRUE` to continue enumeration.
+ */
+static BOOL CALLBACK DeferredContainerEnumProc(HWND hWnd, LPARAM lParam)
+{
+	if (dmlib_subclass::isSubclassRegistered(hWnd, dmlib_subclass::SubclassID::deferredCtrl))
+	{
+		applyDeferredCtrl(hWnd, reinterpret_cast<HWND>(lParam));
+	}
+	return TRUE;
+}
+
+/**
+ * @brief Window subclass procedure for hidden containers of deferred controls.
+ *
+ * Children are not notified when their container, e.g. property sheet page
+ * or tab page, is shown. Subclass waits for the container to be shown,
+ * removes itself and applies full handlers to deferred descendants.
+ *
+ * @param[in]   hWnd        Window handle being subclassed.
+ * @param[in]   uMsg        Message identifier.
+ * @param[in]   wParam      Message-specific data.
+ * @param[in]   lParam      Message-specific data.
+ * @param[in]   uIdSubclass Subclass identifier.
+ * @param[in]   dwRefData   Unused.
+ * @return LRESULT Result of message processing.
+ *
+ * @see applyOrDeferCtrlKind()
+ */
+static LRESULT CALLBACK DeferredContainerSubclass(
+	HWND hWnd,
+	UINT uMsg,
+	WPARAM wParam,
+	LPARAM lParam,
+	UINT_PTR uIdSubclass,
+	[[maybe_unused]] DWORD_PTR dwRefData
+)
+{
+	static constexpr dmlib_subclass::MsgFilter kMsgFilter{ WM_NCDESTROY, WM_WINDOWPOSCHANGED };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	switch (uMsg)
+	{
+		case WM_NCDESTROY:
+		{
+			dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, DeferredContainerSubclass, uIdSubclass);
+			break;
+		}
+
+		case WM_WINDOWPOSCHANGED:
+		{
+			if (isShownWindowPos(lParam))
+			{
+				const LRESULT lr = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+				dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, DeferredContainerSubclass, uIdSubclass);
+				::EnumChildWindows(hWnd, DeferredContainerEnumProc, reinterpret_cast<LPARAM>(hWnd));
+				return lr;
+			}
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+/**
+ * @brief Installs `DeferredContainerSubclass` on hidden container if not installed yet.
+ *
+ * @param[in] hWnd Handle to the hidden container window.
+ */
+static void setDeferredContainerSubclass(HWND hWnd)
+{
+	dmlib_subclass::SetSubclass(hWnd, DeferredContainerSubclass, dmlib_subclass::SubclassID::deferredContainer);
+}
+
+/**
+ * @brief Applies theming/subclassing to a control, or defers it if control is hidden.
+ *
+ * When deferred child subclassing is enabled and subclassing is requested,
+ * controls without `WS_VISIBLE` style, or with an ancestor below the root
+ * window without it, get only lightweight `DeferredCtrlSubclass`.
+ * The hidden ancestor gets `DeferredContainerSubclass`.
+ * The full handler with its per-control data is applied when the control
+ * and its containers are shown.
+ *
+ * @param[in]   hWnd    Handle to the control.
+ * @param[in]   kind    Control kind resolved by @ref getCtrlKind.
+ * @param[in]   p       Parameters controlling whether to apply theming and/or subclassing.
+ * @param[in]   hRoot   Handle to the window whose children are being themed.
+ *
+ * @see DeferredCtrlSubclass()
+ * @see DeferredContainerSubclass()
+ * @see DarkMode::enableDeferredChildSubclass()
+ */
+static void applyOrDeferCtrlKind(HWND hWnd, CtrlKind kind, const DarkModeParams& p, HWND hRoot)
+{
+	if (kind == CtrlKind::unknown)
+	{
+		return;
+	}
+
+	if (g_dmCfg.m_isDeferredSubclass && p.m_subclass)
+	{
+		const bool isHidden = (::GetWindowLongPtrW(hWnd, GWL_STYLE) & WS_VISIBLE) != WS_VISIBLE;
+		HWND hHidden = getHiddenAncestor(hWnd, hRoot);
+		if (isHidden || hHidden != nullptr)
+		{
+			if (dmlib_subclass::isSubclassRegistered(hWnd, dmlib_subclass::SubclassID::deferredCtrl))
+			{
+				return;
+			}
+
+			const DWORD_PTR refData = static_cast<DWORD_PTR>(kind)
+				| kDeferredSubclassFlag
+				| (p.m_theme ? kDeferredThemeFlag : 0);
+
+			if (dmlib_subclass::installSubclass(hWnd, DeferredCtrlSubclass, dmlib_subclass::SubclassID::deferredCtrl, refData))
+			{
+				if (hHidden != nullptr)
+				{
+					setDeferredContainerSubclass(hHidden);
+				}
+				return;
+			}
+		}
+	}
+
+	applyCtrlKind(hWnd, kind, p);
+}
+
+/**
+ * @struct ChildCtrlsParams
+ * @brief Parameters passed to `DarkEnumChildProc`.
+ *
+ * Members:
+ * - `m_params`: Theming and subclassing parameters.
+ * - `m_hRoot`: Window whose children are being themed.
+ */
+struct ChildCtrlsParams
+{
+	DarkModeParams m_params{};
+	HWND m_hRoot = nullptr;
+};
+
+/**
+ * @brief Callback function used to enumerate and apply theming/subclassing to child controls.
+ *
+ * Called in `setChildCtrlsSubclassAndTheme()` and `setChildCtrlsTheme()`
+ * to inspect each child window's class name and apply appropriate theming
+ * and/or subclassing logic based on control type.
+ *
+ * @param[in]   hWnd        Handle to the window being enumerated.
+ * @param[in]   className   Class name of `hWnd` if already retrieved, empty otherwise.
+ * @param[in]   lParam      Pointer to a `ChildCtrlsParams` structure containing theming flags and settings.
+ * @return `true` to continue enumeration.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndTheme()
+ * @see DarkMode::setChildCtrlsTheme()
+ * @see ChildCtrlsParams
+ * @see getCtrlKind()
+ * @see applyCtrlKind()
+ */
+static bool DarkEnumChildProc(HWND hWnd, const std::wstring& className, LPARAM lParam)
+{
+	const auto& cp = *reinterpret_cast<ChildCtrlsParams*>(lParam);
+	applyOrDeferCtrlKind(hWnd, getCtrlKind(hWnd, className), cp.m_params, cp.m_hRoot);
+	return true;
+}
+
+/**
+ * @struct ThemePlanEntry
+ * @brief Single recorded child control decision of a theme plan.
+ *
+ * Members:
+ * - `m_atom`: Window class atom, used to verify the child set cheaply.
+ * - `m_ctrlId`: Control identifier of the child window.
+ * - `m_kind`: Resolved control kind.
+ */
+struct ThemePlanEntry
+{
+	ATOM m_atom = 0;
+	int m_ctrlId = 0;
+	CtrlKind m_kind = CtrlKind::unknown;
+};
+
+/**
+ * @struct ThemePlan
+ * @brief Recorded list of per-control decisions for one parent window layout.
+ *
+ * Plans are keyed by the parent window class atom. Parents sharing the same class
+ * (e.g. `#32770` dialogs) are distinguished by their child signature.
+ * Dialog template is not available from the window handle, so plan is only a hint:
+ * different layouts with identical signature replay the same control kinds.
+ * Per-control theming functions still check styles of the actual control.
+ */
+struct ThemePlan
+{
+	ATOM m_parentAtom = 0;
+	std::vector<ThemePlanEntry> m_entries;
+};
+
+/// Maximum number of stored theme plans, oldest plan is dropped first.
+static constexpr size_t kMaxThemePlans = 32;
+
+namespace // anonymous
+{
+	/// Theme plan cache, opt-in via `DarkMode::enableThemePlanCache`.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<ThemePlan> m_plans;
+		bool m_isEnabled = false;
+	} g_themePlanCache;
+} // anonymous namespace
+
+/**
+ * @brief Callback function used to collect child windows and their signature.
+ *
+ * @param[in]   hWnd        Handle to the window being enumerated.
+ * @param[in]   className   Unused, class atom is used for the signature.
+ * @param[in]   lParam      Pointer to `std::vector<std::pair<HWND, ThemePlanEntry>>`.
+ * @return `true` to continue enumeration.
+ */
+static bool CollectChildProc(HWND hWnd, [[maybe_unused]] const std::wstring& className, LPARAM lParam)
+{
+	auto& children = *reinterpret_cast<std::vector<std::pair<HWND, ThemePlanEntry>>*>(lParam);
+	children.emplace_back(
+		hWnd,
+		ThemePlanEntry{ static_cast<ATOM>(::GetClassLongPtrW(hWnd, GCW_ATOM)), ::GetDlgCtrlID(hWnd), CtrlKind::unknown }
+	);
+	return true;
+}
+
+/**
+ * @brief Checks if a plan matches the collected child set.
+ *
+ * @param[in]   plan        Stored theme plan.
+ * @param[in]   children    Collected child windows with their signature.
+ * @return `true` if child count, class atoms and control IDs are identical.
+ */
+[[nodiscard]] static bool isPlanMatching(
+	const ThemePlan& plan,
+	const std::vector<std::pair<HWND, ThemePlanEntry>>& children
+) noexcept
+{
+	if (plan.m_entries.size() != children.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < children.size(); ++i)
+	{
+		const auto& entry = plan.m_entries[i];
+		const auto& child = children[i].second;
+		if (entry.m_atom != child.m_atom || entry.m_ctrlId != child.m_ctrlId)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Applies theming/subclassing to child controls using cached theme plans.
+ *
+ * Collects child windows with their class atoms and control IDs. If a stored plan
+ * for the parent class atom matches the child set, recorded control kinds are replayed
+ * directly without class name lookups. Otherwise falls back to full class
+ * dispatch and records a new plan.
+ *
+ * @note Matching plan is a hint, not a guarantee, see @ref ThemePlan.
+ *       Class names are still retrieved during collection if opaque classes are set.
+ *
+ * @param[in]   hParent Handle to the parent window.
+ * @param[in]   p       Parameters controlling whether to apply theming and/or subclassing.
+ *
+ * @see DarkMode::enableThemePlanCache()
+ */
+static void setChildCtrlsWithThemePlan(HWND hParent, const DarkModeParams& p)
+{
+	std::vector<std::pair<HWND, ThemePlanEntry>> children;
+	enumChildCtrls(hParent, CollectChildProc, reinterpret_cast<LPARAM>(&children));
+	if (children.empty())
+	{
+		return;
+	}
+
+	const auto parentAtom = static_cast<ATOM>(::GetClassLongPtrW(hParent, GCW_ATOM));
+
+	bool isReplayed = false;
+	{
+		const std::lock_guard<std::mutex> lock(g_themePlanCache.m_mutex);
+		for (const auto& plan : g_themePlanCache.m_plans)
+		{
+			if (plan.m_parentAtom == parentAtom && isPlanMatching(plan, children))
+			{
+				for (size_t i = 0; i < children.size(); ++i)
+				{
+					children[i].second.m_kind = plan.m_entries[i].m_kind;
+				}
+				isReplayed = true;
+				break;
+			}
+		}
+	}
+
+	if (!isReplayed)
+	{
+		for (auto& [hWnd, entry] : children)
+		{
+			entry.m_kind = getCtrlKind(hWnd);
+		}
+	}
+
+	for (const auto& [hWnd, entry] : children)
+	{
+		applyOrDeferCtrlKind(hWnd, entry.m_kind, p, hParent);
+	}
+
+	if (isReplayed)
+	{
+		return;
+	}
+
+	ThemePlan plan{ parentAtom, {} };
+	plan.m_entries.reserve(children.size());
+	for (const auto& child : children)
+	{
+		plan.m_entries.push_back(child.second);
+	}
+
+	const std::lock_guard<std::mutex> lock(g_themePlanCache.m_mutex);
+	if (g_themePlanCache.m_plans.size() >= kMaxThemePlans)
+	{
+		g_themePlanCache.m_plans.erase(g_themePlanCache.m_plans.begin());
+	}
+	g_themePlanCache.m_plans.push_back(std::move(plan));
+}
+
+/**
+ * @brief Enables or disables caching of child control theme plans.
+ *
+ * When enabled, the first call of `DarkMode::setChildCtrlsSubclassAndThemeEx`
+ * (and of `DarkMode::setDarkWndSafeEx` and `DarkMode::setDarkWndNotifySafeEx`)
+ * for a parent window records the resolved per-control actions.
+ * Later calls for a parent of the same class with an identical child set
+ * (same class atoms and control IDs in the same order) replay the recorded
+ * actions. Differing child sets fall back to full enumeration.
+ * Plans are only a hint, layouts with identical child set are not distinguished
+ * further, e.g. by dialog template.
+ *
+ * Useful for dialogs which are opened repeatedly.
+ *
+ * @param[in] enable `true` to enable the cache, `false` to disable and clear it.
+ *
+ * @see DarkMode::clearThemePlanCache()
+ * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ */
+void DarkMode::enableThemePlanCache(bool enable)
+{
+	const std::lock_guard<std::mutex> lock(g_themePlanCache.m_mutex);
+	g_themePlanCache.m_isEnabled = enable;
+	if (!enable)
+	{
+		g_themePlanCache.m_plans.clear();
+	}
+}
+
+/**
+ * @brief Marks or unmarks a window as opaque for child control theming.
+ *
+ * Opaque window itself is still themed, but its descendants are skipped by
+ * `DarkMode::setChildCtrlsSubclassAndThemeEx`, e.g. content of embedded browser hosts,
+ * ActiveX containers, or plugin panels the library cannot theme.
+ * Handles of destroyed windows are purged on each call.
+ *
+ * @param[in]   hWnd    Handle to the window.
+ * @param[in]   opaque  `true` to skip subtree, `false` to enumerate it again.
+ *
+ * @see DarkMode::setOpaqueClass()
+ * @see DarkMode::setChildCtrlsMaxDepth()
+ */
+void DarkMode::setOpaqueWindow(HWND hWnd, bool opaque)
+{
+	auto& wnds = g_childEnumCfg.m_opaqueWnds;
+	wnds.erase(std::remove_if(wnds.begin(), wnds.end(), [hWnd](HWND hWndOpaque) {
+		return hWndOpaque == hWnd || ::IsWindow(hWndOpaque) == FALSE;
+	}), wnds.end());
+
+	if (opaque && hWnd != nullptr)
+	{
+		wnds.push_back(hWnd);
+	}
+}
+
+/**
+ * @brief Marks or unmarks a window class as opaque for child control theming.
+ *
+ * Windows with opaque class are still themed, but their descendants are skipped by
+ * `DarkMode::setChildCtrlsSubclassAndThemeEx`.
+ *
+ * @param[in]   className   Window class name, e.g. `L"Internet Explorer_Server"`.
+ * @param[in]   opaque      `true` to skip subtrees, `false` to enumerate them again.
+ *
+ * @see DarkMode::setOpaqueWindow()
+ */
+void DarkMode::setOpaqueClass(const wchar_t* className, bool opaque)
+{
+	if (className == nullptr)
+	{
+		return;
+	}
+
+	auto& classes = g_childEnumCfg.m_opaqueClasses;
+	const std::wstring name{ className };
+	classes.erase(std::remove(classes.begin(), classes.end(), name), classes.end());
+
+	if (opaque)
+	{
+		classes.push_back(name);
+	}
+}
+
+/**
+ * @brief Sets maximum depth of child control enumeration.
+ *
+ * Depth 1 means only direct children of the parent window are themed.
+ *
+ * @param[in] maxDepth Maximum depth, `0` for unlimited (default).
+ *
+ * @see DarkMode::setOpaqueWindow()
+ * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ */
+void DarkMode::setChildCtrlsMaxDepth(UINT maxDepth)
+{
+	g_childEnumCfg.m_maxDepth = maxDepth;
+}
+
+/**
+ * @brief Enables or disables deferred subclassing of hidden child controls.
+ *
+ * When enabled, `DarkMode::setChildCtrlsSubclassAndThemeEx` with `subclass = true`
+ * installs only lightweight subclass on child controls which are hidden
+ * (control or its container below the parent window has no `WS_VISIBLE` style),
+ * e.g. controls on hidden property sheet pages or tabs.
+ * Full subclassing and theming, including allocation of per-control data,
+ * is applied when control and its containers are shown.
+ *
+ * @param[in] enable `true` to defer subclassing of hidden controls.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ */
+void DarkMode::enableDeferredChildSubclass(bool enable)
+{
+	g_dmCfg.m_isDeferredSubclass = enable;
+}
+
+/**
+ * @brief Clears all cached child control theme plans.
+ *
+ * @see DarkMode::enableThemePlanCache()
+ */
+void DarkMode::clearThemePlanCache()
+{
+	const std::lock_guard<std::mutex> lock(g_themePlanCache.m_mutex);
+	g_themePlanCache.m_plans.clear();
+}
+
+/**
+ * @brief Applies theming and/or subclassing to all child controls of a parent window.
+ *
+ * Enumerates all child windows of the specified parent and dispatches them to
+ * `DarkEnumChildProc`, which applies control-specific theming and/or subclassing logic
+ * based on their class name and the provided parameters.
+ * If theme plan cache is enabled, recorded plans are replayed when possible.
+ * Descendants of opaque windows are skipped and enumeration depth can be limited.
+ *
+ * Mainly used when initializing parent control.
+ *
+ * @param[in]   hParent     Handle to the parent window whose child controls will be themed and/or subclassed.
+ * @param[in]   subclass    Whether to apply subclassing.
+ * @param[in]   theme       Whether to apply theming.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndTheme()
+ * @see DarkMode::DarkEnumChildProc()
+ * @see DarkMode::enableThemePlanCache()
+ * @see DarkMode::setOpaqueWindow()
+ * @see DarkMode::setChildCtrlsMaxDepth()
+ * @see DarkModeParams
+ */
+void DarkMode::setChildCtrlsSubclassAndThemeEx(HWND hParent, bool subclass, bool theme)
+{
+	DarkModeParams p{
+		DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr
+		, subclass
+		, theme
+	};
+
+	bool usePlan = false;
+	{
+		const std::lock_guard<std::mutex> lock(g_themePlanCache.m_mutex);
+		usePlan = g_themePlanCache.m_isEnabled;
+	}
+
+	if (usePlan)
+	{
+		setChildCtrlsWithThemePlan(hParent, p);
+		return;
+	}
+
+	ChildCtrlsParams cp{ p, hParent };
+	enumChildCtrls(hParent, DarkEnumChildProc, reinterpret_cast<LPARAM>(&cp));
+}
+
+/**
+ * @brief Wrapper for `DarkMode::setChildCtrlsSubclassAndThemeEx`.
+ *
+ * Forwards to `DarkMode::setChildCtrlsSubclassAndThemeEx` with `subclass` and `theme` parameters set as `true`.
+ *
+ * @param[in] hParent Handle to the parent window whose child controls will be themed and/or subclassed.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ */
+void DarkMode::setChildCtrlsSubclassAndTheme(HWND hParent)
+{
+	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, true, true);
+}
+
+/**
+ * @brief Applies theming to all child controls of a parent window.
+ *
+ * Enumerates child windows of the specified parent and applies theming without subclassing.
+ * The theming behavior adapts based on OS support and compile-time flags.
+ * If `_DARKMODELIB_ALLOW_OLD_OS > 1` is true, theming is applied unconditionally.
+ * Otherwise, theming is applied only if the OS is Windows 10 or newer.
+ * The function delegates to `setChildCtrlsSubclassAndTheme()` with appropriate flags.
+ *
+ * Mainly used when changing mode.
+ *
+ * @param[in] hParent Handle to the parent window whose child controls will be themed.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndTheme()
+ */
+void DarkMode::setChildCtrlsTheme(HWND hParent)
+{
+#if defined(_DARKMODELIB_ALLOW_OLD_OS) && (_DARKMODELIB_ALLOW_OLD_OS > 1)
+	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, false, true);
+#else
+	DarkMode::setChildCtrlsSubclassAndThemeEx(hParent, false, DarkMode::isAtLeastWindows10());
+#endif
+}
+
+/**
+ * @struct AsyncThemeJob
+ * @brief State of one time-sliced asynchronous child control theming.
+ *
+ * Members:
+ * - `m_hParent`: Parent window whose children are themed.
+ * - `m_timerID`: Identifier of the thread timer driving the slices.
+ * - `m_children`: Collected child windows, visible windows first.
+ * - `m_next`: Index of the next child to process.
+ * - `m_params`: Theming and subclassing parameters.
+ * - `m_sliceMs`: Time budget per slice in milliseconds.
+ * - `m_doneProc`: Optional completion callback.
+ * - `m_lParam`: Application-defined value passed to `m_doneProc`.
+ */
+struct AsyncThemeJob
+{
+	HWND m_hParent = nullptr;
+	UINT_PTR m_timerID = 0;
+	std::vector<HWND> m_children;
+	size_t m_next = 0;
+	DarkModeParams m_params{};
+	UINT m_sliceMs = dmlib_slice::kDefaultSliceMs;
+	DarkMode::ThemeAsyncDoneProc m_doneProc = nullptr;
+	LPARAM m_lParam = 0;
+};
+
+namespace // anonymous
+{
+	/// Pending asynchronous child control theming jobs.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<std::unique_ptr<AsyncThemeJob>> m_jobs;
+	} g_asyncThemeJobs;
+} // anonymous namespace
+
+/**
+ * @brief Finds pending asynchronous theming job by its timer identifier.
+ *
+ * Caller must hold `g_asyncThemeJobs.m_mutex`.
+ *
+ * @param[in] timerID Thread timer identifier.
+ * @return Iterator to the job, or end iterator if job was removed.
+ */
+[[nodiscard]] static auto findAsyncThemeJob(UINT_PTR timerID) noexcept
+{
+	auto& jobs = g_asyncThemeJobs.m_jobs;
+	return std::find_if(jobs.begin(), jobs.end(), [timerID](const auto& pJob) {
+		return pJob->m_timerID == timerID;
+	});
+}
+
+/**
+ * @brief Callback function used to collect child window handles.
+ *
+ * @param[in]   hWnd        Handle to the window being enumerated.
+ * @param[in]   className   Unused.
+ * @param[in]   lParam      Pointer to `std::vector<HWND>`.
+ * @return `true` to continue enumeration.
+ */
+static bool CollectChildHwndProc(HWND hWnd, [[maybe_unused]] const std::wstring& className, LPARAM lParam)
+{
+	reinterpret_cast<std::vector<HWND>*>(lParam)->push_back(hWnd);
+	return true;
+}
+
+/**
+ * @brief Timer procedure processing one slice of asynchronous child control theming.
+ *
+ * Applies theming/subclassing to collected children until the slice time budget
+ * is exhausted. Timer messages are dispatched only when the message queue is
+ * otherwise empty, so input and painting are not blocked.
+ * When all children are processed, the timer is killed and the completion
+ * callback is invoked.
+ *
+ * The job list lock is not held while controls are themed, theming sends messages
+ * which can restart or add jobs. The job is looked up again by its timer for each child.
+ *
+ * @param[in]   hWnd        Unused, thread timer has no window.
+ * @param[in]   uMsg        Unused, `WM_TIMER`.
+ * @param[in]   idEvent     Timer identifier.
+ * @param[in]   dwTime      Unused.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndThemeAsync()
+ */
+static void CALLBACK AsyncThemeTimerProc([[maybe_unused]] HWND hWnd, [[maybe_unused]] UINT uMsg, UINT_PTR idEvent, [[maybe_unused]] DWORD dwTime)
+{
+	UINT sliceMs = 0;
+	{
+		const std::lock_guard<std::mutex> lock(g_asyncThemeJobs.m_mutex);
+		auto it = findAsyncThemeJob(idEvent);
+		if (it == g_asyncThemeJobs.m_jobs.end() || ::IsWindow((*it)->m_hParent) == FALSE)
+		{
+			// restarted job or destroyed parent, completion callback is not invoked
+			if (it != g_asyncThemeJobs.m_jobs.end())
+			{
+				g_asyncThemeJobs.m_jobs.erase(it);
+			}
+			::KillTimer(nullptr, idEvent);
+			return;
+		}
+		sliceMs = (*it)->m_sliceMs;
+	}
+
+	const bool isDone = dmlib_slice::runSlice(std::chrono::milliseconds(sliceMs), [idEvent]() -> bool {
+		HWND hChild = nullptr;
+		HWND hParent = nullptr;
+		DarkModeParams params{};
+		bool hasMore = false;
+		{
+			const std::lock_guard<std::mutex> lock(g_asyncThemeJobs.m_mutex);
+			auto it = findAsyncThemeJob(idEvent);
+			if (it == g_asyncThemeJobs.m_jobs.end())
+			{
+				return false;
+			}
+
+			auto& job = **it;
+			if (job.m_next >= job.m_children.size())
+			{
+				return false;
+			}
+
+			hChild = job.m_children[job.m_next++];
+			hParent = job.m_hParent;
+			params = job.m_params;
+			hasMore = job.m_next < job.m_children.size();
+		}
+
+		if (::IsWindow(hChild) == TRUE)
+		{
+			applyOrDeferCtrlKind(hChild, getCtrlKind(hChild), params, hParent);
+		}
+		return hasMore;
+	});
+
+	if (!isDone)
+	{
+		return;
+	}
+
+	::KillTimer(nullptr, idEvent);
+
+	std::unique_ptr<AsyncThemeJob> doneJob;
+	{
+		const std::lock_guard<std::mutex> lock(g_asyncThemeJobs.m_mutex);
+		auto it = findAsyncThemeJob(idEvent);
+		if (it == g_asyncThemeJobs.m_jobs.end())
+		{
+			return;
+		}
+
+		doneJob = std::move(*it);
+		g_asyncThemeJobs.m_jobs.erase(it);
+	}
+
+	if (doneJob->m_doneProc != nullptr)
+	{
+		doneJob->m_doneProc(doneJob->m_hParent, doneJob->m_lParam);
+	}
+}
+
+/**
+ * @brief Applies theming and/or subclassing to child controls asynchronously in time slices.
+ *
+ * Collects all child windows of the parent (respecting opaque windows and maximum depth),
+ * orders visible windows first and then processes them in slices driven by a thread timer
+ * owned by the library, the timers of the parent window are not touched.
+ * Each slice is limited by `sliceMs` time budget,
+ * so the UI thread stays responsive for windows with very large child trees.
+ *
+ * Calling again for the same parent restarts the job, the previous completion callback
+ * is not invoked.
+ *
+ * @param[in]   hParent     Handle to the parent window, must belong to the calling thread.
+ * @param[in]   subclass    Whether to apply subclassing.
+ * @param[in]   theme       Whether to apply theming.
+ * @param[in]   sliceMs     Time budget per slice in milliseconds, `0` for default.
+ * @param[in]   doneProc    Optional callback invoked when all children are processed.
+ * @param[in]   lParam      Application-defined value passed to `doneProc`.
+ *
+ * @note If the parent window is destroyed before all children are processed,
+ *       the job is dropped and `doneProc` is not invoked.
+ *
+ * @see DarkMode::setChildCtrlsSubclassAndThemeEx()
+ * @see DarkMode::setDarkWndNotifySafeAsync()
+ */
+void DarkMode::setChildCtrlsSubclassAndThemeAsync(
+	HWND hParent,
+	bool subclass,
+	bool theme,
+	UINT sliceMs,
+	ThemeAsyncDoneProc doneProc,
+	LPARAM lParam
+)
+{
+	if (hParent == nullptr)
+	{
+		return;
+	}
+
+	auto pJob = std::make_unique<AsyncThemeJob>();
+	pJob->m_hParent = hParent;
+	pJob->m_params = DarkModeParams{
+		DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr
+		, subclass
+		, theme
+	};
+	pJob->m_sliceMs = dmlib_slice::getSliceMs(sliceMs);
+	pJob->m_doneProc = doneProc;
+	pJob->m_lParam = lParam;
+
+	enumChildCtrls(hParent, CollectChildHwndProc, reinterpret_cast<LPARAM>(&pJob->m_children));
+	dmlib_slice::orderShownFirst(pJob->m_children.begin(), pJob->m_children.end(), [hParent](HWND hWnd) {
+		return (::GetWindowLongPtrW(hWnd, GWL_STYLE) & WS_VISIBLE) == WS_VISIBLE
+			&& getHiddenAncestor(hWnd, hParent) == nullptr;
+	});
+
+	{
+		// purge jobs of destroyed windows and restarted job
+		const std::lock_guard<std::mutex> lock(g_asyncThemeJobs.m_mutex);
+		auto& jobs = g_asyncThemeJobs.m_jobs;
+		jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [hParent](const auto& job) {
+			if (job->m_hParent == hParent || ::IsWindow(job->m_hParent) == FALSE)
+			{
+				::KillTimer(nullptr, job->m_timerID);
+				return true;
+			}
+			return false;
+		}), jobs.end());
+
+		pJob->m_timerID = ::SetTimer(nullptr, 0, USER_TIMER_MINIMUM, AsyncThemeTimerProc);
+		if (pJob->m_timerID != 0)
+		{
+			jobs.push_back(std::move(pJob));
+			return;
+		}
+	}
+
+	// fallback to synchronous theming
+	for (HWND hChild : pJob->m_children)
+	{
+		applyOrDeferCtrlKind(hChild, getCtrlKind(hChild), pJob->m_params, hParent);
+	}
+
+	if (doneProc != nullptr)
+	{
+		doneProc(hParent, lParam);
+	}
+}
+
+/**
+ * @brief Applies window subclassing to handle `WM_ERASEBKGND` message.
+ *
+ * @param[in] hWnd Handle to the control to subclass.
+ *
+ * @see dmlib_subclass::WindowSubclass()
+ * @see DarkMode::removeWindowEraseBgSubclass()
+ */
+void DarkMode::setWindowEraseBgSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass(hWnd, dmlib_subclass::WindowEraseBgSubclass, dmlib_subclass::SubclassID::windowEraseBg);
+	dmlib_subclass::setWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::eraseBg);
 }
 
 /**
@@ -2429,28 +3764,28 @@ void DarkMode::setWindowEraseBgSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed window.
  *
- * @see dmlib_subclass::WindowEraseBgSubclass()
- * @see DarkMode::removeWindowEraseBgSubclass()
+ * @see dmlib_subclass::WindowSubclass()
+ * @see DarkMode::setWindowEraseBgSubclass()
  */
 void DarkMode::removeWindowEraseBgSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass(hWnd, dmlib_subclass::WindowEraseBgSubclass, dmlib_subclass::SubclassID::windowEraseBg);
+	dmlib_subclass::removeWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::eraseBg);
 }
 
 /**
  * @brief Applies window subclassing to handle `WM_CTLCOLOR*` messages.
  *
  * Enable custom colors for edit, listbox, static, and dialog elements
- * via @ref dmlib_subclass::WindowCtlColorSubclass.
+ * via `ctlColor` behavior of @ref dmlib_subclass::WindowSubclass.
  *
  * @param[in] hWnd Handle to the parent or composite control (dialog, rebar, toolbar, ...) to subclass.
  *
- * @see dmlib_subclass::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::removeWindowCtlColorSubclass()
  */
 void DarkMode::setWindowCtlColorSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass(hWnd, dmlib_subclass::WindowCtlColorSubclass, dmlib_subclass::SubclassID::windowCtlColor);
+	dmlib_subclass::setWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::ctlColor);
 }
 
 /**
@@ -2460,29 +3795,29 @@ void DarkMode::setWindowCtlColorSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed window.
  *
- * @see dmlib_subclass::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::setWindowCtlColorSubclass()
  */
 void DarkMode::removeWindowCtlColorSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass(hWnd, dmlib_subclass::WindowCtlColorSubclass, dmlib_subclass::SubclassID::windowCtlColor);
+	dmlib_subclass::removeWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::ctlColor);
 }
 
 /**
  * @brief Applies window subclassing for handling `NM_CUSTOMDRAW` notifications for custom drawing.
  *
- * Installs @ref dmlib_subclass::WindowNotifySubclass.
+ * Enables `notify` behavior of @ref dmlib_subclass::WindowSubclass.
  * Enables handling of `WM_NOTIFY` `NM_CUSTOMDRAW` notifications for custom drawing
  * behavior for supported controls.
  *
  * @param[in] hWnd Handle to the window with child which support `NM_CUSTOMDRAW`.
  *
- * @see dmlib_subclass::WindowNotifySubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::removeWindowNotifyCustomDrawSubclass()
  */
 void DarkMode::setWindowNotifyCustomDrawSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass(hWnd, dmlib_subclass::WindowNotifySubclass, dmlib_subclass::SubclassID::windowNotify);
+	dmlib_subclass::setWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::notify);
 }
 
 /**
@@ -2492,29 +3827,29 @@ void DarkMode::setWindowNotifyCustomDrawSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed window.
  *
- * @see dmlib_subclass::WindowNotifySubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::setWindowNotifyCustomDrawSubclass()
  */
 void DarkMode::removeWindowNotifyCustomDrawSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass(hWnd, dmlib_subclass::WindowNotifySubclass, dmlib_subclass::SubclassID::windowNotify);
+	dmlib_subclass::removeWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::notify);
 }
 
 /**
  * @brief Applies window subclassing for menu bar themed custom drawing.
  *
- * Installs @ref DarkMode::WindowMenuBarSubclass with an associated `ThemeData` instance
- * for the `VSCLASS_MENU` visual style. Enables custom drawing
+ * Enables `menuBar` behavior of @ref dmlib_subclass::WindowSubclass with an associated
+ * `ThemeData` instance for the `VSCLASS_MENU` visual style. Enables custom drawing
  * behavior for menu bar.
  *
  * @param[in] hWnd Handle to the window with a menu bar.
  *
- * @see dmlib_subclass::WindowMenuBarSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::removeWindowMenuBarSubclass()
  */
 void DarkMode::setWindowMenuBarSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass<dmlib_subclass::ThemeData>(hWnd, dmlib_subclass::WindowMenuBarSubclass, dmlib_subclass::SubclassID::windowMenuBar, VSCLASS_MENU);
+	dmlib_subclass::setWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::menuBar);
 }
 
 /**
@@ -2524,12 +3859,12 @@ void DarkMode::setWindowMenuBarSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed window.
  *
- * @see dmlib_subclass::WindowMenuBarSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::setWindowMenuBarSubclass()
  */
 void DarkMode::removeWindowMenuBarSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass<dmlib_subclass::ThemeData>(hWnd, dmlib_subclass::WindowMenuBarSubclass, dmlib_subclass::SubclassID::windowMenuBar);
+	dmlib_subclass::removeWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::menuBar);
 }
 
 /**
@@ -2540,12 +3875,12 @@ void DarkMode::removeWindowMenuBarSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the main window.
  *
- * @see DarkMode::WindowSettingChangeSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::removeWindowSettingChangeSubclass()
  */
 void DarkMode::setWindowSettingChangeSubclass(HWND hWnd)
 {
-	dmlib_subclass::SetSubclass(hWnd, dmlib_subclass::WindowSettingChangeSubclass, dmlib_subclass::SubclassID::windowSettingChange);
+	dmlib_subclass::setWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::settingChange);
 }
 
 /**
@@ -2555,12 +3890,12 @@ void DarkMode::setWindowSettingChangeSubclass(HWND hWnd)
  *
  * @param[in] hWnd Handle to the previously subclassed window.
  *
- * @see DarkMode::WindowSettingChangeSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::setWindowSettingChangeSubclass()
  */
 void DarkMode::removeWindowSettingChangeSubclass(HWND hWnd)
 {
-	dmlib_subclass::RemoveSubclass(hWnd, dmlib_subclass::WindowSettingChangeSubclass, dmlib_subclass::SubclassID::windowSettingChange);
+	dmlib_subclass::removeWindowBehavior(hWnd, dmlib_subclass::WindowBehavior::settingChange);
 }
 
 /**
@@ -2728,7 +4063,7 @@ void DarkMode::setDarkThemeExperimentalEx(HWND hWnd, const wchar_t* themeClassNa
 	if (DarkMode::isExperimentalSupported())
 	{
 		dmlib_win32api::AllowDarkModeForWindow(hWnd, DarkMode::isExperimentalActive());
-		::SetWindowTheme(hWnd, themeClassName, nullptr);
+		dmlib_subclass::setWindowTheme(hWnd, themeClassName, nullptr);
 	}
 }
 
@@ -2756,7 +4091,7 @@ void DarkMode::setDarkThemeExperimental(HWND hWnd)
  */
 void DarkMode::setDarkExplorerTheme(HWND hWnd)
 {
-	::SetWindowTheme(hWnd, DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr, nullptr);
+	dmlib_subclass::setWindowTheme(hWnd, DarkMode::isExperimentalActive() ? L"DarkMode_Explorer" : nullptr, nullptr);
 }
 
 /**
@@ -2864,7 +4199,7 @@ void DarkMode::setDarkTooltips(HWND hWnd, int tooltipType)
  */
 void DarkMode::setDarkThemeTheme(HWND hWnd)
 {
-	::SetWindowTheme(hWnd, DarkMode::isExperimentalActive() ? DarkMode::getDarkModeThemeName() : nullptr, nullptr);
+	dmlib_subclass::setWindowTheme(hWnd, DarkMode::isExperimentalActive() ? DarkMode::getDarkModeThemeName() : nullptr, nullptr);
 }
 
 /**
@@ -2911,79 +4246,127 @@ void DarkMode::setDarkListView(HWND hWnd)
 }
 
 /**
- * @brief Replaces list view or tree view image list checkbox state images with themed dark mode versions on Windows 11.
- *
- * Uses `"DarkMode_Explorer::Button"` as the theme class if experimental dark mode is active;
- * otherwise falls back to `VSCLASS_BUTTON`.
+ * @brief Renders themed checkbox state into a new icon.
  *
- * @param[in]   hWnd          Handle to the control to change checkbox style.
- * @param[in]   ImgList       Handle to the image list of control containing checkbox state images.
- * @param[in]   viewCheckbox  Type of checkbox style.
+ * Uses `"DarkMode_Explorer::Button"` as the theme class for dark version;
+ * otherwise `VSCLASS_BUTTON`.
  *
- * @note Does nothing on pre-Windows 11 systems.
+ * @param[in] dpi       DPI to render the checkbox for.
+ * @param[in] useDark   Whether to use dark theme class.
+ * @param[in] iStateId  Checkbox state ID, e.g. `CBS_CHECKEDNORMAL`.
+ * @return Icon handle, or `nullptr` on failure.
  */
-static void setDarkCheckboxes(HWND hWnd, HIMAGELIST hImgList, ViewCheckbox viewCheckbox)
+[[nodiscard]] static HICON createCheckboxIcon(UINT dpi, bool useDark, int iStateId) noexcept
 {
-	if (!DarkMode::isAtLeastWindows11())
+	HTHEME hTheme = dmlib_resource::trackObj(
+		dmlib_dpi::OpenThemeDataForDpi(nullptr, useDark ? L"DarkMode_Explorer::Button" : VSCLASS_BUTTON, dpi),
+		DarkMode::ResourceType::theme);
+	if (hTheme == nullptr)
 	{
-		return;
+		return nullptr;
 	}
 
 	HDC hdc = ::GetDC(nullptr);
 
-	const bool useDark = DarkMode::isExperimentalActive() && DarkMode::isThemeDark();
-	HTHEME hTheme = dmlib_dpi::OpenThemeDataForDpi(nullptr, useDark ? L"DarkMode_Explorer::Button" : VSCLASS_BUTTON, ::GetParent(hWnd));
-
 	SIZE szBox{};
 	::GetThemePartSize(hTheme, hdc, BP_CHECKBOX, CBS_UNCHECKEDNORMAL, nullptr, TS_DRAW, &szBox);
 
 	const RECT rcBox{ 0, 0, szBox.cx, szBox.cy };
 
-	if (hImgList == nullptr)
-	{
-		::CloseThemeData(hTheme);
-		::ReleaseDC(nullptr, hdc);
-		return;
-	}
-
-	HDC hBoxDC = ::CreateCompatibleDC(hdc);
-	HBITMAP hBoxBmp = ::CreateCompatibleBitmap(hdc, szBox.cx, szBox.cy);
-	HBITMAP hMaskBmp = ::CreateCompatibleBitmap(hdc, szBox.cx, szBox.cy);
+	HDC hBoxDC = dmlib_resource::createCompatibleDC(hdc);
+	HBITMAP hBoxBmp = dmlib_resource::createCompatibleBitmap(hdc, szBox.cx, szBox.cy);
+	HBITMAP hMaskBmp = dmlib_resource::createCompatibleBitmap(hdc, szBox.cx, szBox.cy);
 
 	auto holdBmp = static_cast<HBITMAP>(::SelectObject(hBoxDC, hBoxBmp));
-	::DrawThemeBackground(hTheme, hBoxDC, BP_CHECKBOX, CBS_UNCHECKEDNORMAL, &rcBox, nullptr);
+	::DrawThemeBackground(hTheme, hBoxDC, BP_CHECKBOX, iStateId, &rcBox, nullptr);
+	::SelectObject(hBoxDC, holdBmp);
 
 	ICONINFO ii{};
 	ii.fIcon = TRUE;
 	ii.hbmColor = hBoxBmp;
 	ii.hbmMask = hMaskBmp;
 
-	int idx = (viewCheckbox == ViewCheckbox::listView) ? 0 : 1; // tree view state images start from index 1
-
 	HICON hIcon = ::CreateIconIndirect(&ii);
 
-	auto addIcon = [&hImgList, &idx, &hIcon]()
+	dmlib_resource::deleteObject(hMaskBmp);
+	dmlib_resource::deleteObject(hBoxBmp);
+	dmlib_resource::deleteDC(hBoxDC);
+	dmlib_resource::closeThemeData(hTheme);
+	::ReleaseDC(nullptr, hdc);
+
+	return hIcon;
+}
+
+/**
+ * @brief Copies cached checkbox state icon into the image list.
+ *
+ * Icon is rendered only on first use of the (DPI, dark/light, state ID) key,
+ * other controls with the same key reuse it.
+ *
+ * @param[in] hImgList  Handle to the state image list.
+ * @param[in] idx       Index of the image to replace.
+ * @param[in] dpi       DPI of the control.
+ * @param[in] useDark   Whether to use dark checkbox.
+ * @param[in] iStateId  Checkbox state ID.
+ * @return `true` if the image was replaced.
+ */
+static bool replaceCheckboxIcon(HIMAGELIST hImgList, int idx, UINT dpi, bool useDark, int iStateId)
+{
+	const std::lock_guard<std::mutex> lock(g_checkboxIconCache.m_mutex);
+
+	auto& icons = g_checkboxIconCache.m_icons;
+	auto it = std::find_if(icons.begin(), icons.end(), [&](const CheckboxIcon& icon) {
+		return icon.m_dpi == dpi && icon.m_isDark == useDark && icon.m_iStateId == iStateId;
+	});
+
+	if (it == icons.end())
 	{
-		if (hIcon != nullptr)
+		HICON hIcon = createCheckboxIcon(dpi, useDark, iStateId);
+		if (hIcon == nullptr)
 		{
-			::ImageList_ReplaceIcon(hImgList, idx, hIcon);
-			::DestroyIcon(hIcon);
-			hIcon = nullptr;
-			++idx;
+			return false;
 		}
-	};
+		icons.push_back(CheckboxIcon{ dpi, useDark, iStateId, hIcon });
+		it = icons.end() - 1;
+	}
 
-	addIcon(); // unchecked state
+	return ::ImageList_ReplaceIcon(hImgList, idx, it->m_hIcon) != -1;
+}
 
-	auto addIconState = [&](int iStateId)
+/**
+ * @brief Replaces list view or tree view image list checkbox state images with themed dark mode versions on Windows 11.
+ *
+ * Uses `"DarkMode_Explorer::Button"` as the theme class if experimental dark mode is active;
+ * otherwise falls back to `VSCLASS_BUTTON`.
+ * State icons are shared across controls, see `replaceCheckboxIcon()`.
+ *
+ * @param[in]   hWnd          Handle to the control to change checkbox style.
+ * @param[in]   ImgList       Handle to the image list of control containing checkbox state images.
+ * @param[in]   viewCheckbox  Type of checkbox style.
+ *
+ * @note Does nothing on pre-Windows 11 systems.
+ */
+static void setDarkCheckboxes(HWND hWnd, HIMAGELIST hImgList, ViewCheckbox viewCheckbox)
+{
+	if (!DarkMode::isAtLeastWindows11() || hImgList == nullptr)
 	{
-		::DrawThemeBackground(hTheme, hBoxDC, BP_CHECKBOX, iStateId, &rcBox, nullptr);
-		ii.hbmColor = hBoxBmp;
+		return;
+	}
 
-		hIcon = ::CreateIconIndirect(&ii);
-		addIcon();
+	const bool useDark = DarkMode::isExperimentalActive() && DarkMode::isThemeDark();
+	const UINT dpi = dmlib_dpi::GetDpiForWindow(::GetParent(hWnd));
+
+	int idx = (viewCheckbox == ViewCheckbox::listView) ? 0 : 1; // tree view state images start from index 1
+
+	auto addIconState = [&](int iStateId)
+	{
+		if (replaceCheckboxIcon(hImgList, idx, dpi, useDark, iStateId))
+		{
+			++idx;
+		}
 	};
 
+	addIconState(CBS_UNCHECKEDNORMAL);
 	addIconState(CBS_CHECKEDNORMAL);
 
 	if (viewCheckbox == ViewCheckbox::tvExtended)
@@ -3008,13 +4391,6 @@ static void setDarkCheckboxes(HWND hWnd, HIMAGELIST hImgList, ViewCheckbox viewC
 			addIconState(CBS_EXCLUDEDNORMAL);
 		}
 	}
-
-	::SelectObject(hBoxDC, holdBmp);
-	::DeleteObject(hMaskBmp);
-	::DeleteObject(hBoxBmp);
-	::DeleteDC(hBoxDC);
-	::CloseThemeData(hTheme);
-	::ReleaseDC(nullptr, hdc);
 }
 
 /**
@@ -3123,7 +4499,7 @@ void DarkMode::setDarkRichEdit(HWND hWnd)
 		cf.crTextColor = DarkMode::getTextColor();
 		::SendMessage(hWnd, EM_SETCHARFORMAT, SCF_DEFAULT, reinterpret_cast<LPARAM>(&cf));
 
-		::SetWindowTheme(hWnd, nullptr, DarkMode::isExperimentalActive() ? L"DarkMode_Explorer::ScrollBar" : nullptr);
+		dmlib_subclass::setWindowTheme(hWnd, nullptr, DarkMode::isExperimentalActive() ? L"DarkMode_Explorer::ScrollBar" : nullptr);
 	}
 	else
 	{
@@ -3131,7 +4507,7 @@ void DarkMode::setDarkRichEdit(HWND hWnd)
 		::SendMessage(hWnd, EM_SETBKGNDCOLOR, TRUE, 0);
 		::SendMessage(hWnd, EM_SETCHARFORMAT, SCF_DEFAULT, reinterpret_cast<LPARAM>(&cf));
 
-		::SetWindowTheme(hWnd, nullptr, nullptr);
+		dmlib_subclass::setWindowTheme(hWnd, nullptr, nullptr);
 	}
 
 	DarkMode::setWindowStyle(hWnd, DarkMode::isEnabled() || !hasClientEdge, WS_BORDER);
@@ -3276,6 +4652,46 @@ void DarkMode::setDarkWndNotifySafe(HWND hWnd)
 	DarkMode::setDarkWndNotifySafeEx(hWnd, false, true);
 }
 
+/**
+ * @brief Asynchronous variant of `DarkMode::setDarkWndNotifySafeEx` for windows with large child trees.
+ *
+ * Applies the dark title bar, ctl color, custom draw and optional setting change subclassings
+ * immediately, child controls are themed in time slices via `DarkMode::setChildCtrlsSubclassAndThemeAsync`.
+ *
+ * @param[in]   hWnd                        Handle to the window. No action taken if `nullptr`.
+ * @param[in]   setSettingChangeSubclass    `true` to set setting change subclass if applicable.
+ * @param[in]   useWin11Features            `true` to enable Windows 11 specific styling like Mica or rounded corners.
+ * @param[in]   doneProc                    Optional callback invoked when all child controls are processed.
+ * @param[in]   lParam                      Application-defined value passed to `doneProc`.
+ *
+ * @note `setSettingChangeSubclass = true` should be used only on main window.
+ *
+ * @see DarkMode::setDarkWndNotifySafeEx()
+ * @see DarkMode::setChildCtrlsSubclassAndThemeAsync()
+ */
+void DarkMode::setDarkWndNotifySafeAsync(
+	HWND hWnd,
+	bool setSettingChangeSubclass,
+	bool useWin11Features,
+	ThemeAsyncDoneProc doneProc,
+	LPARAM lParam
+)
+{
+	if (hWnd == nullptr)
+	{
+		return;
+	}
+
+	DarkMode::setDarkTitleBarEx(hWnd, useWin11Features);
+	DarkMode::setWindowCtlColorSubclass(hWnd);
+	DarkMode::setWindowNotifyCustomDrawSubclass(hWnd);
+	DarkMode::setChildCtrlsSubclassAndThemeAsync(hWnd, true, true, 0, doneProc, lParam);
+	if (setSettingChangeSubclass && DarkMode::isWindowsModeEnabled())
+	{
+		DarkMode::setWindowSettingChangeSubclass(hWnd);
+	}
+}
+
 /**
  * @brief Enables or disables theme-based dialog background textures in classic mode.
  *
@@ -3308,11 +4724,11 @@ void DarkMode::disableVisualStyle(HWND hWnd, bool doDisable)
 {
 	if (doDisable)
 	{
-		::SetWindowTheme(hWnd, L"", L"");
+		dmlib_subclass::setWindowTheme(hWnd, L"", L"");
 	}
 	else
 	{
-		::SetWindowTheme(hWnd, nullptr, nullptr);
+		dmlib_subclass::setWindowTheme(hWnd, nullptr, nullptr);
 	}
 }
 
@@ -3462,7 +4878,7 @@ void DarkMode::setTreeViewWindowThemeEx(HWND hWnd, bool force)
 		::SetWindowLongPtr(hWnd, GWL_STYLE, nStyle);
 	}
 
-	::SetWindowTheme(hWnd, strSubAppName.empty() ? nullptr : strSubAppName.c_str(), nullptr);
+	dmlib_subclass::setWindowTheme(hWnd, strSubAppName.empty() ? nullptr : strSubAppName.c_str(), nullptr);
 }
 
 /**
@@ -3698,7 +5114,7 @@ void DarkMode::setProgressBarClassicTheme(HWND hWnd)
  *         and `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::onCtlColorListbox()
  */
 LRESULT DarkMode::onCtlColor(HDC hdc)
@@ -3727,7 +5143,7 @@ LRESULT DarkMode::onCtlColor(HDC hdc)
  *         `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::onCtlColorListbox()
  */
 LRESULT DarkMode::onCtlColorCtrl(HDC hdc)
@@ -3757,7 +5173,7 @@ LRESULT DarkMode::onCtlColorCtrl(HDC hdc)
  *         `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::onCtlColorListbox()
  */
 LRESULT DarkMode::onCtlColorDlg(HDC hdc)
@@ -3784,7 +5200,7 @@ LRESULT DarkMode::onCtlColorDlg(HDC hdc)
  *         `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  */
 LRESULT DarkMode::onCtlColorError(HDC hdc)
 {
@@ -3814,7 +5230,7 @@ LRESULT DarkMode::onCtlColorError(HDC hdc)
  *         `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  */
 LRESULT DarkMode::onCtlColorDlgStaticText(HDC hdc, bool isTextEnabled)
 {
@@ -3844,7 +5260,7 @@ LRESULT DarkMode::onCtlColorDlgStaticText(HDC hdc, bool isTextEnabled)
  *         `_DARKMODELIB_DLG_PROC_CTLCOLOR_RETURNS` is defined
  *         and has non-zero unsigned value.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  */
 LRESULT DarkMode::onCtlColorDlgLinkText(HDC hdc, bool isTextEnabled)
 {
@@ -3873,7 +5289,7 @@ LRESULT DarkMode::onCtlColorDlgLinkText(HDC hdc, bool isTextEnabled)
  * @param[in]   lParam  LPARAM from `WM_CTLCOLORLISTBOX`, representing the HWND of the listbox.
  * @return The brush handle as LRESULT for background painting, or `FALSE` if not themed.
  *
- * @see DarkMode::WindowCtlColorSubclass()
+ * @see dmlib_subclass::WindowSubclass()
  * @see DarkMode::onCtlColor()
  * @see DarkMode::onCtlColorCtrl()
  * @see DarkMode::onCtlColorDlg()
@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace dmlib_glyph
+ *
+ * Glyph atlas packing and indexing, has no platform dependencies.
+ * GDI pages and rasterization are in `DmlibGlyph.cpp`.
+ */
+namespace dmlib_glyph
+{
+	/// Width and height of single glyph atlas page.
+	inline constexpr int kAtlasPageSize = 256;
+	/// Maximum number of atlas pages, whole atlas is rebuilt when exceeded.
+	inline constexpr size_t kMaxAtlasPages = 4;
+
+	/**
+	 * @class ShelfPacker
+	 * @brief Packs small rectangles into fixed size atlas page.
+	 *
+	 * Rectangles are placed left to right into horizontal rows ("shelves").
+	 * Rectangle goes to the lowest fitting shelf, new shelf is opened
+	 * below the last one when none fits.
+	 */
+	class ShelfPacker
+	{
+	public:
+		ShelfPacker() = delete;
+
+		explicit ShelfPacker(int width, int height) noexcept
+			: m_width(width)
+			, m_height(height)
+		{}
+
+		/**
+		 * @brief Reserves space for rectangle.
+		 *
+		 * @param[in]   width   Width of the rectangle.
+		 * @param[in]   height  Height of the rectangle.
+		 * @param[out]  x       Left position of the reserved space.
+		 * @param[out]  y       Top position of the reserved space.
+		 * @return `true` if the rectangle fits, `false` otherwise.
+		 */
+		[[nodiscard]] bool pack(int width, int height, int& x, int& y)
+		{
+			if (width <= 0 || height <= 0 || width > m_width || height > m_height)
+			{
+				return false;
+			}
+
+			Shelf* bestShelf = nullptr;
+			for (auto& shelf : m_shelves)
+			{
+				if (shelf.m_height >= height
+					&& (m_width - shelf.m_x) >= width
+					&& (bestShelf == nullptr || shelf.m_height < bestShelf->m_height))
+				{
+					bestShelf = &shelf;
+				}
+			}
+
+			if (bestShelf == nullptr)
+			{
+				if ((m_height - m_nextY) < height)
+				{
+					return false;
+				}
+
+				m_shelves.push_back(Shelf{ m_nextY, height, 0 });
+				m_nextY += height;
+				bestShelf = &m_shelves.back();
+			}
+
+			x = bestShelf->m_x;
+			y = bestShelf->m_y;
+			bestShelf->m_x += width;
+			return true;
+		}
+
+		void reset() noexcept
+		{
+			m_shelves.clear();
+			m_nextY = 0;
+		}
+
+	private:
+		struct Shelf
+		{
+			int m_y = 0;
+			int m_height = 0;
+			int m_x = 0;
+		};
+
+		std::vector<Shelf> m_shelves;
+		int m_width = 0;
+		int m_height = 0;
+		int m_nextY = 0;
+	};
+
+	/**
+	 * @brief Converts white-on-black rasterized pixel to premultiplied color pixel.
+	 *
+	 * Coverage is the strongest channel of the source pixel,
+	 * which keeps antialiased edges of ClearType and grayscale text.
+	 *
+	 * @param[in]   pixel   Source pixel in 0x00RRGGBB layout.
+	 * @param[in]   red     Red channel of the glyph color.
+	 * @param[in]   green   Green channel of the glyph color.
+	 * @param[in]   blue    Blue channel of the glyph color.
+	 * @return Premultiplied pixel in 0xAARRGGBB layout.
+	 */
+	[[nodiscard]] constexpr std::uint32_t toPremultipliedPixel(
+		std::uint32_t pixel,
+		std::uint8_t red,
+		std::uint8_t green,
+		std::uint8_t blue
+	) noexcept
+	{
+		const std::uint32_t r = (pixel >> 16) & 0xFF;
+		const std::uint32_t g = (pixel >> 8) & 0xFF;
+		const std::uint32_t b = pixel & 0xFF;
+		const std::uint32_t alpha = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+
+		auto mul = [alpha](std::uint32_t channel) constexpr noexcept -> std::uint32_t
+		{
+			return (channel * alpha + 127) / 255;
+		};
+
+		return (alpha << 24) | (mul(red) << 16) | (mul(green) << 8) | mul(blue);
+	}
+
+	/**
+	 * @class FontTable
+	 * @brief Maps fonts to small identifiers used in glyph keys.
+	 *
+	 * Fonts are compared by hash first and then by full equality,
+	 * so fonts with colliding hashes still get separate identifiers.
+	 * Font already reflects DPI and size, e.g. `LOGFONT` with scaled height,
+	 * so the same face at different DPI gets different identifier.
+	 *
+	 * @tparam Font     Font description type.
+	 * @tparam Hash     Callable `std::size_t(const Font&)`.
+	 * @tparam Equal    Callable `bool(const Font&, const Font&)`.
+	 */
+	template <typename Font, typename Hash = std::hash<Font>, typename Equal = std::equal_to<Font>>
+	class FontTable
+	{
+	public:
+		/**
+		 * @brief Retrieves identifier of the font, adds the font if not known yet.
+		 *
+		 * @param[in] font Font description.
+		 * @return Font identifier, stable until `clear()`.
+		 */
+		[[nodiscard]] std::uint32_t getId(const Font& font)
+		{
+			const std::size_t hash = Hash{}(font);
+			for (size_t i = 0; i < m_fonts.size(); ++i)
+			{
+				if (m_fonts[i].first == hash && Equal{}(m_fonts[i].second, font))
+				{
+					return static_cast<std::uint32_t>(i);
+				}
+			}
+
+			m_fonts.emplace_back(hash, font);
+			return static_cast<std::uint32_t>(m_fonts.size() - 1);
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_fonts.size();
+		}
+
+		void clear() noexcept
+		{
+			m_fonts.clear();
+		}
+
+	private:
+		std::vector<std::pair<std::size_t, Font>> m_fonts;
+	};
+
+	/**
+	 * @struct GlyphKey
+	 * @brief Key of the atlas cell.
+	 *
+	 * Members:
+	 * - `m_fontId`: Font identifier from `FontTable`.
+	 * - `m_glyph`: Glyph character.
+	 * - `m_color`: Glyph color, dark and light mode colors get separate cells.
+	 */
+	struct GlyphKey
+	{
+		std::uint32_t m_fontId = 0;
+		std::uint32_t m_glyph = 0;
+		std::uint32_t m_color = 0;
+	};
+
+	[[nodiscard]] constexpr bool operator==(const GlyphKey& lhs, const GlyphKey& rhs) noexcept
+	{
+		return lhs.m_fontId == rhs.m_fontId
+			&& lhs.m_glyph == rhs.m_glyph
+			&& lhs.m_color == rhs.m_color;
+	}
+
+	/**
+	 * @struct AtlasCell
+	 * @brief Reserved atlas space of one glyph.
+	 */
+	struct AtlasCell
+	{
+		GlyphKey m_key{};
+		size_t m_page = 0;
+		int m_x = 0;
+		int m_y = 0;
+		int m_width = 0;
+		int m_height = 0;
+	};
+
+	/**
+	 * @class AtlasIndex
+	 * @brief Glyph cells and page packers of the atlas.
+	 *
+	 * Owns only the layout, pixel pages are created and released
+	 * by callbacks passed to `insert()`.
+	 */
+	class AtlasIndex
+	{
+	public:
+		explicit AtlasIndex(int pageSize = kAtlasPageSize, size_t maxPages = kMaxAtlasPages) noexcept
+			: m_pageSize(pageSize)
+			, m_maxPages(maxPages)
+		{}
+
+		/**
+		 * @brief Finds cell of the key.
+		 *
+		 * @param[in] key Glyph key.
+		 * @return Pointer to the cell, or `nullptr` if the glyph is not in the atlas.
+		 *         Pointer is valid until next `insert()` or `clear()`.
+		 */
+		[[nodiscard]] const AtlasCell* find(const GlyphKey& key) const noexcept
+		{
+			for (const auto& cell : m_cells)
+			{
+				if (cell.m_key == key)
+				{
+					return &cell;
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * @brief Reserves cell for the key.
+		 *
+		 * Tries existing pages first, then adds new page. When page limit
+		 * is reached, all pages and cells are evicted and packing starts over.
+		 *
+		 * @param[in]   key         Glyph key, must not be in the atlas yet.
+		 * @param[in]   width       Width of the cell.
+		 * @param[in]   height      Height of the cell.
+		 * @param[in]   addPage     Callable `bool()` creating pixel page, returns `false` on failure.
+		 * @param[in]   evictPages  Callable `void()` releasing all pixel pages.
+		 * @return Pointer to the new cell, or `nullptr` if the cell does not fit or page cannot be created.
+		 *         Pointer is valid until next `insert()` or `clear()`.
+		 */
+		template <typename AddPageFn, typename EvictFn>
+		[[nodiscard]] const AtlasCell* insert(
+			const GlyphKey& key,
+			int width,
+			int height,
+			AddPageFn&& addPage,
+			EvictFn&& evictPages
+		)
+		{
+			if (width <= 0 || height <= 0 || width > m_pageSize || height > m_pageSize)
+			{
+				return nullptr;
+			}
+
+			AtlasCell cell{ key, 0, 0, 0, width, height };
+			for (size_t i = 0; i < m_packers.size(); ++i)
+			{
+				if (m_packers[i].pack(width, height, cell.m_x, cell.m_y))
+				{
+					cell.m_page = i;
+					m_cells.push_back(cell);
+					return &m_cells.back();
+				}
+			}
+
+			if (m_packers.size() >= m_maxPages)
+			{
+				evictPages();
+				clear();
+			}
+
+			if (!addPage())
+			{
+				return nullptr;
+			}
+
+			m_packers.emplace_back(m_pageSize, m_pageSize);
+			cell.m_page = m_packers.size() - 1;
+			if (!m_packers.back().pack(width, height, cell.m_x, cell.m_y))
+			{
+				return nullptr;
+			}
+
+			m_cells.push_back(cell);
+			return &m_cells.back();
+		}
+
+		void clear() noexcept
+		{
+			m_packers.clear();
+			m_cells.clear();
+		}
+
+		[[nodiscard]] size_t getPageCount() const noexcept
+		{
+			return m_packers.size();
+		}
+
+		[[nodiscard]] size_t getCellCount() const noexcept
+		{
+			return m_cells.size();
+		}
+
+	private:
+		std::vector<ShelfPacker> m_packers;
+		std::vector<AtlasCell> m_cells;
+		int m_pageSize = kAtlasPageSize;
+		size_t m_maxPages = kMaxAtlasPages;
+	};
+} // namespace dmlib_glyph
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+namespace dmlib_subclass
+{
+	/// Back buffer sizes are rounded up to multiple of this value.
+	inline constexpr int kBufferGranularity = 32;
+
+	/**
+	 * @brief Returns grown buffer extent for required extent.
+	 *
+	 * Adds a quarter of the required extent and rounds up to `kBufferGranularity`,
+	 * so buffers growing step by step (e.g. during window resizing) are not
+	 * reallocated on each step.
+	 *
+	 * @param[in] required Required extent in pixels.
+	 * @return Extent to allocate.
+	 *
+	 * @note Has no platform dependencies.
+	 */
+	[[nodiscard]] constexpr int growBufferExtent(int required) noexcept
+	{
+		const int grown = required + (required / 4) + (kBufferGranularity - 1);
+		return grown - (grown % kBufferGranularity);
+	}
+
+	/**
+	 * @brief Returns buffer extent to use for required extent with hysteresis.
+	 *
+	 * Current extent is kept when it is large enough and not more than
+	 * about twice the required extent, otherwise new grown extent is returned.
+	 *
+	 * @param[in] current   Current extent of the buffer, `0` if none.
+	 * @param[in] required  Required extent in pixels.
+	 * @return `current` if buffer can be reused, new extent otherwise.
+	 *
+	 * @note Has no platform dependencies.
+	 */
+	[[nodiscard]] constexpr int getBufferExtent(int current, int required) noexcept
+	{
+		if (current >= required && current <= (required * 2) + kBufferGranularity)
+		{
+			return current;
+		}
+		return dmlib_subclass::growBufferExtent(required);
+	}
+} // namespace dmlib_subclass
@@ -15,6 +15,7 @@
 #include <windows.h>
 
 #include "DarkModeSubclass.h"
+#include "DmlibResource.h"
 
 namespace dmlib_color
 {
@@ -194,16 +195,16 @@ namespace dmlib_color
 		Brushes() = delete;
 
 		explicit Brushes(const DarkMode::Colors& colors) noexcept
-			: m_background(::CreateSolidBrush(colors.background))
-			, m_ctrlBackground(::CreateSolidBrush(colors.ctrlBackground))
-			, m_hotBackground(::CreateSolidBrush(colors.hotBackground))
-			, m_dlgBackground(::CreateSolidBrush(colors.dlgBackground))
-			, m_errorBackground(::CreateSolidBrush(colors.errorBackground))
-
-			, m_edge(::CreateSolidBrush(colors.edge))
-			, m_hotEdge(::CreateSolidBrush(colors.hotEdge))
-			, m_disabledEdge(::CreateSolidBrush(colors.disabledEdge))
-			, m_highlightEdge(::CreateSolidBrush(colors.linkText))
+			: m_background(dmlib_resource::createSolidBrush(colors.background))
+			, m_ctrlBackground(dmlib_resource::createSolidBrush(colors.ctrlBackground))
+			, m_hotBackground(dmlib_resource::createSolidBrush(colors.hotBackground))
+			, m_dlgBackground(dmlib_resource::createSolidBrush(colors.dlgBackground))
+			, m_errorBackground(dmlib_resource::createSolidBrush(colors.errorBackground))
+
+			, m_edge(dmlib_resource::createSolidBrush(colors.edge))
+			, m_hotEdge(dmlib_resource::createSolidBrush(colors.hotEdge))
+			, m_disabledEdge(dmlib_resource::createSolidBrush(colors.disabledEdge))
+			, m_highlightEdge(dmlib_resource::createSolidBrush(colors.linkText))
 		{}
 
 		Brushes(const Brushes&) = delete;
@@ -214,41 +215,41 @@ namespace dmlib_color
 
 		~Brushes()
 		{
-			::DeleteObject(m_background);       m_background = nullptr;
-			::DeleteObject(m_ctrlBackground);   m_ctrlBackground = nullptr;
-			::DeleteObject(m_hotBackground);    m_hotBackground = nullptr;
-			::DeleteObject(m_dlgBackground);    m_dlgBackground = nullptr;
-			::DeleteObject(m_errorBackground);  m_errorBackground = nullptr;
+			dmlib_resource::deleteObject(m_background);       m_background = nullptr;
+			dmlib_resource::deleteObject(m_ctrlBackground);   m_ctrlBackground = nullptr;
+			dmlib_resource::deleteObject(m_hotBackground);    m_hotBackground = nullptr;
+			dmlib_resource::deleteObject(m_dlgBackground);    m_dlgBackground = nullptr;
+			dmlib_resource::deleteObject(m_errorBackground);  m_errorBackground = nullptr;
 
-			::DeleteObject(m_edge);             m_edge = nullptr;
-			::DeleteObject(m_hotEdge);          m_hotEdge = nullptr;
-			::DeleteObject(m_disabledEdge);     m_disabledEdge = nullptr;
-			::DeleteObject(m_highlightEdge);    m_highlightEdge = nullptr;
+			dmlib_resource::deleteObject(m_edge);             m_edge = nullptr;
+			dmlib_resource::deleteObject(m_hotEdge);          m_hotEdge = nullptr;
+			dmlib_resource::deleteObject(m_disabledEdge);     m_disabledEdge = nullptr;
+			dmlib_resource::deleteObject(m_highlightEdge);    m_highlightEdge = nullptr;
 		}
 
 		void updateBrushes(const DarkMode::Colors& colors) noexcept
 		{
-			::DeleteObject(m_background);
-			::DeleteObject(m_ctrlBackground);
-			::DeleteObject(m_hotBackground);
-			::DeleteObject(m_dlgBackground);
-			::DeleteObject(m_errorBackground);
+			dmlib_resource::deleteObject(m_background);
+			dmlib_resource::deleteObject(m_ctrlBackground);
+			dmlib_resource::deleteObject(m_hotBackground);
+			dmlib_resource::deleteObject(m_dlgBackground);
+			dmlib_resource::deleteObject(m_errorBackground);
 
-			::DeleteObject(m_edge);
-			::DeleteObject(m_hotEdge);
-			::DeleteObject(m_disabledEdge);
-			::DeleteObject(m_highlightEdge);
+			dmlib_resource::deleteObject(m_edge);
+			dmlib_resource::deleteObject(m_hotEdge);
+			dmlib_resource::deleteObject(m_disabledEdge);
+			dmlib_resource::deleteObject(m_highlightEdge);
 
-			m_background = ::CreateSolidBrush(colors.background);
-			m_ctrlBackground = ::CreateSolidBrush(colors.ctrlBackground);
-			m_hotBackground = ::CreateSolidBrush(colors.hotBackground);
-			m_dlgBackground = ::CreateSolidBrush(colors.dlgBackground);
-			m_errorBackground = ::CreateSolidBrush(colors.errorBackground);
+			m_background = dmlib_resource::createSolidBrush(colors.background);
+			m_ctrlBackground = dmlib_resource::createSolidBrush(colors.ctrlBackground);
+			m_hotBackground = dmlib_resource::createSolidBrush(colors.hotBackground);
+			m_dlgBackground = dmlib_resource::createSolidBrush(colors.dlgBackground);
+			m_errorBackground = dmlib_resource::createSolidBrush(colors.errorBackground);
 
-			m_edge = ::CreateSolidBrush(colors.edge);
-			m_hotEdge = ::CreateSolidBrush(colors.hotEdge);
-			m_disabledEdge = ::CreateSolidBrush(colors.disabledEdge);
-			m_highlightEdge = ::CreateSolidBrush(colors.linkText);
+			m_edge = dmlib_resource::createSolidBrush(colors.edge);
+			m_hotEdge = dmlib_resource::createSolidBrush(colors.hotEdge);
+			m_disabledEdge = dmlib_resource::createSolidBrush(colors.disabledEdge);
+			m_highlightEdge = dmlib_resource::createSolidBrush(colors.linkText);
 		}
 	};
 
@@ -263,11 +264,11 @@ namespace dmlib_color
 		Pens() = delete;
 
 		explicit Pens(const DarkMode::Colors& colors) noexcept
-			: m_darkerText(::CreatePen(PS_SOLID, 1, colors.darkerText))
-			, m_edge(::CreatePen(PS_SOLID, 1, colors.edge))
-			, m_hotEdge(::CreatePen(PS_SOLID, 1, colors.hotEdge))
-			, m_disabledEdge(::CreatePen(PS_SOLID, 1, colors.disabledEdge))
-			, m_highlightEdge(::CreatePen(PS_SOLID, 1, colors.linkText))
+			: m_darkerText(dmlib_resource::createPen(PS_SOLID, 1, colors.darkerText))
+			, m_edge(dmlib_resource::createPen(PS_SOLID, 1, colors.edge))
+			, m_hotEdge(dmlib_resource::createPen(PS_SOLID, 1, colors.hotEdge))
+			, m_disabledEdge(dmlib_resource::createPen(PS_SOLID, 1, colors.disabledEdge))
+			, m_highlightEdge(dmlib_resource::createPen(PS_SOLID, 1, colors.linkText))
 		{}
 
 		Pens(const Pens&) = delete;
@@ -278,26 +279,26 @@ namespace dmlib_color
 
 		~Pens()
 		{
-			::DeleteObject(m_darkerText);    m_darkerText = nullptr;
-			::DeleteObject(m_edge);          m_edge = nullptr;
-			::DeleteObject(m_hotEdge);       m_hotEdge = nullptr;
-			::DeleteObject(m_disabledEdge);  m_disabledEdge = nullptr;
-			::DeleteObject(m_highlightEdge); m_highlightEdge = nullptr;
+			dmlib_resource::deleteObject(m_darkerText);    m_darkerText = nullptr;
+			dmlib_resource::deleteObject(m_edge);          m_edge = nullptr;
+			dmlib_resource::deleteObject(m_hotEdge);       m_hotEdge = nullptr;
+			dmlib_resource::deleteObject(m_disabledEdge);  m_disabledEdge = nullptr;
+			dmlib_resource::deleteObject(m_highlightEdge); m_highlightEdge = nullptr;
 		}
 
 		void updatePens(const DarkMode::Colors& colors) noexcept
 		{
-			::DeleteObject(m_darkerText);
-			::DeleteObject(m_edge);
-			::DeleteObject(m_hotEdge);
-			::DeleteObject(m_disabledEdge);
-			::DeleteObject(m_highlightEdge);
+			dmlib_resource::deleteObject(m_darkerText);
+			dmlib_resource::deleteObject(m_edge);
+			dmlib_resource::deleteObject(m_hotEdge);
+			dmlib_resource::deleteObject(m_disabledEdge);
+			dmlib_resource::deleteObject(m_highlightEdge);
 
-			m_darkerText = ::CreatePen(PS_SOLID, 1, colors.darkerText);
-			m_edge = ::CreatePen(PS_SOLID, 1, colors.edge);
-			m_hotEdge = ::CreatePen(PS_SOLID, 1, colors.hotEdge);
-			m_disabledEdge = ::CreatePen(PS_SOLID, 1, colors.disabledEdge);
-			m_highlightEdge = ::CreatePen(PS_SOLID, 1, colors.linkText);
+			m_darkerText = dmlib_resource::createPen(PS_SOLID, 1, colors.darkerText);
+			m_edge = dmlib_resource::createPen(PS_SOLID, 1, colors.edge);
+			m_hotEdge = dmlib_resource::createPen(PS_SOLID, 1, colors.hotEdge);
+			m_disabledEdge = dmlib_resource::createPen(PS_SOLID, 1, colors.disabledEdge);
+			m_highlightEdge = dmlib_resource::createPen(PS_SOLID, 1, colors.linkText);
 		}
 	};
 
@@ -543,12 +544,12 @@ namespace dmlib_color
 		BrushesAndPensView() = delete;
 
 		explicit BrushesAndPensView(const DarkMode::ColorsView& colors) noexcept
-			: m_background(::CreateSolidBrush(colors.background))
-			, m_gridlines(::CreateSolidBrush(colors.gridlines))
-			, m_headerBackground(::CreateSolidBrush(colors.headerBackground))
-			, m_headerHotBackground(::CreateSolidBrush(colors.headerHotBackground))
+			: m_background(dmlib_resource::createSolidBrush(colors.background))
+			, m_gridlines(dmlib_resource::createSolidBrush(colors.gridlines))
+			, m_headerBackground(dmlib_resource::createSolidBrush(colors.headerBackground))
+			, m_headerHotBackground(dmlib_resource::createSolidBrush(colors.headerHotBackground))
 
-			, m_headerEdge(::CreatePen(PS_SOLID, 1, colors.headerEdge))
+			, m_headerEdge(dmlib_resource::createPen(PS_SOLID, 1, colors.headerEdge))
 		{}
 
 		BrushesAndPensView(const BrushesAndPensView&) = delete;
@@ -559,29 +560,29 @@ namespace dmlib_color
 
 		~BrushesAndPensView()
 		{
-			::DeleteObject(m_background);           m_background = nullptr;
-			::DeleteObject(m_gridlines);            m_gridlines = nullptr;
-			::DeleteObject(m_headerBackground);     m_headerBackground = nullptr;
-			::DeleteObject(m_headerHotBackground);  m_headerHotBackground = nullptr;
+			dmlib_resource::deleteObject(m_background);           m_background = nullptr;
+			dmlib_resource::deleteObject(m_gridlines);            m_gridlines = nullptr;
+			dmlib_resource::deleteObject(m_headerBackground);     m_headerBackground = nullptr;
+			dmlib_resource::deleteObject(m_headerHotBackground);  m_headerHotBackground = nullptr;
 
-			::DeleteObject(m_headerEdge);           m_headerEdge = nullptr;
+			dmlib_resource::deleteObject(m_headerEdge);           m_headerEdge = nullptr;
 		}
 
 		void update(const DarkMode::ColorsView& colors) noexcept
 		{
-			::DeleteObject(m_background);
-			::DeleteObject(m_gridlines);
-			::DeleteObject(m_headerBackground);
-			::DeleteObject(m_headerHotBackground);
+			dmlib_resource::deleteObject(m_background);
+			dmlib_resource::deleteObject(m_gridlines);
+			dmlib_resource::deleteObject(m_headerBackground);
+			dmlib_resource::deleteObject(m_headerHotBackground);
 
-			m_background = ::CreateSolidBrush(colors.background);
-			m_gridlines = ::CreateSolidBrush(colors.gridlines);
-			m_headerBackground = ::CreateSolidBrush(colors.headerBackground);
-			m_headerHotBackground = ::CreateSolidBrush(colors.headerHotBackground);
+			m_background = dmlib_resource::createSolidBrush(colors.background);
+			m_gridlines = dmlib_resource::createSolidBrush(colors.gridlines);
+			m_headerBackground = dmlib_resource::createSolidBrush(colors.headerBackground);
+			m_headerHotBackground = dmlib_resource::createSolidBrush(colors.headerHotBackground);
 
-			::DeleteObject(m_headerEdge);
+			dmlib_resource::deleteObject(m_headerEdge);
 
-			m_headerEdge = ::CreatePen(PS_SOLID, 1, colors.headerEdge);
+			m_headerEdge = dmlib_resource::createPen(PS_SOLID, 1, colors.headerEdge);
 		}
 	};
 
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "StdAfx.h"
+
+#include "DmlibGlyph.h"
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "DmlibResource.h"
+#include "DmlibSubclass.h"
+
+namespace // anonymous
+{
+	/**
+	 * @struct AtlasPage
+	 * @brief Single 32-bpp top-down DIB section with premultiplied glyph pixels.
+	 */
+	struct AtlasPage
+	{
+		HDC m_hMemDC = nullptr;
+		HBITMAP m_hBitmap = nullptr;
+		HGDIOBJ m_hOldBitmap = nullptr;
+		std::uint32_t* m_pixels = nullptr;
+	};
+
+	/// Hash of logical font for `dmlib_glyph::FontTable`.
+	struct LogFontHash
+	{
+		std::size_t operator()(const LOGFONTW& lf) const noexcept
+		{
+			return dmlib_subclass::hashLogFont(lf);
+		}
+	};
+
+	/// Equality of logical fonts for `dmlib_glyph::FontTable`.
+	struct LogFontEqual
+	{
+		bool operator()(const LOGFONTW& lhs, const LOGFONTW& rhs) const noexcept
+		{
+			return dmlib_subclass::isSameLogFont(lhs, rhs);
+		}
+	};
+
+	/**
+	 * Process-wide glyph atlas.
+	 *
+	 * Cell key is (logical font, glyph, color). Logical font already reflects
+	 * DPI and size, so glyphs for different DPI get separate cells.
+	 * Font table is kept across page evictions and cleared with `clearAtlas()`.
+	 */
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<AtlasPage> m_pages;
+		dmlib_glyph::AtlasIndex m_index;
+		dmlib_glyph::FontTable<LOGFONTW, LogFontHash, LogFontEqual> m_fonts;
+	} g_glyphAtlas;
+} // anonymous namespace
+
+/**
+ * @brief Deletes atlas pages.
+ *
+ * @note Caller must hold the atlas mutex.
+ */
+static void releasePages() noexcept
+{
+	for (auto& page : g_glyphAtlas.m_pages)
+	{
+		::SelectObject(page.m_hMemDC, page.m_hOldBitmap);
+		dmlib_resource::deleteObject(page.m_hBitmap);
+		dmlib_resource::deleteDC(page.m_hMemDC);
+	}
+	g_glyphAtlas.m_pages.clear();
+}
+
+/**
+ * @brief Creates new empty atlas page.
+ *
+ * @param[in] hdc Device context used as compatible DC.
+ * @return `true` if the page was created.
+ *
+ * @note Caller must hold the atlas mutex.
+ */
+static bool addPage(HDC hdc)
+{
+	AtlasPage page{};
+	page.m_hMemDC = dmlib_resource::createCompatibleDC(hdc);
+	if (page.m_hMemDC == nullptr)
+	{
+		return false;
+	}
+
+	void* pBits = nullptr;
+	page.m_hBitmap = dmlib_resource::createDIBSection32(
+		page.m_hMemDC, dmlib_glyph::kAtlasPageSize, dmlib_glyph::kAtlasPageSize, &pBits);
+	if (page.m_hBitmap == nullptr)
+	{
+		dmlib_resource::deleteDC(page.m_hMemDC);
+		return false;
+	}
+
+	page.m_pixels = static_cast<std::uint32_t*>(pBits);
+	page.m_hOldBitmap = ::SelectObject(page.m_hMemDC, page.m_hBitmap);
+	::SetBkMode(page.m_hMemDC, TRANSPARENT);
+	::SetTextColor(page.m_hMemDC, RGB(0xFF, 0xFF, 0xFF));
+
+	g_glyphAtlas.m_pages.push_back(std::move(page));
+	return true;
+}
+
+/**
+ * @brief Rasterizes glyph into reserved atlas cell.
+ *
+ * Glyph is drawn white on black with `DrawTextW`, so font linking
+ * behaves same as for direct drawing, then converted to premultiplied
+ * pixels of the requested color.
+ *
+ * @param[in] cell  Reserved cell.
+ * @param[in] hFont Font to draw the glyph with.
+ */
+static void rasterizeCell(const dmlib_glyph::AtlasCell& cell, HFONT hFont) noexcept
+{
+	const auto& page = g_glyphAtlas.m_pages[cell.m_page];
+
+	RECT rcCell{ cell.m_x, cell.m_y, cell.m_x + cell.m_width, cell.m_y + cell.m_height };
+	::FillRect(page.m_hMemDC, &rcCell, static_cast<HBRUSH>(::GetStockObject(BLACK_BRUSH)));
+
+	const auto hOldFont = ::SelectObject(page.m_hMemDC, hFont);
+	const wchar_t text[]{ static_cast<wchar_t>(cell.m_key.m_glyph), L'\0' };
+	::DrawTextW(page.m_hMemDC, text, 1, &rcCell, DT_NOPREFIX | DT_LEFT | DT_TOP | DT_SINGLELINE);
+	::SelectObject(page.m_hMemDC, hOldFont);
+	::GdiFlush();
+
+	const auto clr = static_cast<COLORREF>(cell.m_key.m_color);
+	const auto red = GetRValue(clr);
+	const auto green = GetGValue(clr);
+	const auto blue = GetBValue(clr);
+
+	for (int y = cell.m_y; y < cell.m_y + cell.m_height; ++y)
+	{
+		std::uint32_t* row = page.m_pixels + (static_cast<size_t>(y) * dmlib_glyph::kAtlasPageSize);
+		for (int x = cell.m_x; x < cell.m_x + cell.m_width; ++x)
+		{
+			row[x] = dmlib_glyph::toPremultipliedPixel(row[x], red, green, blue);
+		}
+	}
+}
+
+/**
+ * @brief Finds or rasterizes atlas cell for glyph.
+ *
+ * New pages are added as needed. When page limit is reached,
+ * all pages are released and packing starts over.
+ *
+ * @param[in]   hdc     Device context with the font selected.
+ * @param[in]   glyph   Glyph character.
+ * @param[in]   clr     Glyph color.
+ * @return Pointer to the cell, or `nullptr` if the glyph cannot be cached.
+ *
+ * @note Caller must hold the atlas mutex.
+ */
+static const dmlib_glyph::AtlasCell* getCell(HDC hdc, wchar_t glyph, COLORREF clr)
+{
+	const auto hFont = static_cast<HFONT>(::GetCurrentObject(hdc, OBJ_FONT));
+	LOGFONTW lf{};
+	if (hFont == nullptr || ::GetObjectW(hFont, sizeof(LOGFONTW), &lf) == 0)
+	{
+		return nullptr;
+	}
+
+	const dmlib_glyph::GlyphKey key{
+		g_glyphAtlas.m_fonts.getId(lf),
+		static_cast<std::uint32_t>(glyph),
+		static_cast<std::uint32_t>(clr)
+	};
+
+	if (const auto* cell = g_glyphAtlas.m_index.find(key); cell != nullptr)
+	{
+		return cell;
+	}
+
+	SIZE szGlyph{};
+	if (::GetTextExtentPoint32W(hdc, &glyph, 1, &szGlyph) == FALSE)
+	{
+		return nullptr;
+	}
+
+	const auto* cell = g_glyphAtlas.m_index.insert(key, szGlyph.cx, szGlyph.cy,
+		[hdc]() { return addPage(hdc); },
+		[]() { releasePages(); });
+	if (cell != nullptr)
+	{
+		rasterizeCell(*cell, hFont);
+	}
+	return cell;
+}
+
+/**
+ * @brief Draws glyph with current font of the device context from the glyph atlas.
+ *
+ * Replacement for `DrawText` with single glyph strings from `dmlib_glyph`.
+ * Glyph is rasterized once per (glyph, font, color) key, subsequent
+ * draws only alpha blend the cached cell. Horizontal and vertical
+ * alignment flags are applied same way as with `DrawText`.
+ *
+ * Falls back to `DrawText` when the glyph cannot be cached,
+ * e.g. when it is larger than atlas page.
+ *
+ * @param[in] hdc       Handle to the device context with font selected.
+ * @param[in] glyph     Single character glyph string, e.g. `dmlib_glyph::kArrowDown`.
+ * @param[in] rc        Bounding rectangle.
+ * @param[in] dtFlags   `DrawText` flags, only alignment flags are used.
+ * @param[in] clr       Glyph color.
+ *
+ * @see dmlib_glyph::clearAtlas()
+ */
+void dmlib_glyph::drawGlyph(HDC hdc, const wchar_t* glyph, const RECT& rc, UINT dtFlags, COLORREF clr) noexcept
+{
+	try
+	{
+		const std::lock_guard<std::mutex> lock(g_glyphAtlas.m_mutex);
+		if (const auto* cell = getCell(hdc, glyph[0], clr);
+			cell != nullptr)
+		{
+			int x = rc.left;
+			if ((dtFlags & DT_CENTER) == DT_CENTER)
+			{
+				x += ((rc.right - rc.left) - cell->m_width) / 2;
+			}
+			else if ((dtFlags & DT_RIGHT) == DT_RIGHT)
+			{
+				x = rc.right - cell->m_width;
+			}
+
+			int y = rc.top;
+			if ((dtFlags & DT_VCENTER) == DT_VCENTER)
+			{
+				y += ((rc.bottom - rc.top) - cell->m_height) / 2;
+			}
+			else if ((dtFlags & DT_BOTTOM) == DT_BOTTOM)
+			{
+				y = rc.bottom - cell->m_height;
+			}
+
+			static constexpr BLENDFUNCTION kBlend{ AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+			::GdiAlphaBlend(
+				hdc, x, y, cell->m_width, cell->m_height,
+				g_glyphAtlas.m_pages[cell->m_page].m_hMemDC, cell->m_x, cell->m_y, cell->m_width, cell->m_height,
+				kBlend);
+			return;
+		}
+	}
+	catch (...)
+	{
+		// fall through to direct drawing
+	}
+
+	const COLORREF clrOld = ::SetTextColor(hdc, clr);
+	RECT rcText{ rc };
+	::DrawTextW(hdc, glyph, -1, &rcText, dtFlags);
+	::SetTextColor(hdc, clrOld);
+}
+
+/**
+ * @brief Releases all atlas pages, glyphs are rasterized again on next use.
+ *
+ * Called when theme colors change; cells for old colors would not be used anymore.
+ */
+void dmlib_glyph::clearAtlas() noexcept
+{
+	const std::lock_guard<std::mutex> lock(g_glyphAtlas.m_mutex);
+	releasePages();
+	g_glyphAtlas.m_index.clear();
+	g_glyphAtlas.m_fonts.clear();
+}
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <windows.h>
+
+#include "DmlibAtlas.h"
+
 namespace dmlib_glyph
 {
 	inline constexpr const wchar_t* kArrowLeft = L"<";
@@ -22,4 +26,9 @@ namespace dmlib_glyph
 	inline constexpr const wchar_t* kTriangleDown = L"⏷";
 
 	inline constexpr const wchar_t* kChevron = L"»";
+
+	/// Draws glyph with current font of the device context from the glyph atlas.
+	void drawGlyph(HDC hdc, const wchar_t* glyph, const RECT& rc, UINT dtFlags, COLORREF clr) noexcept;
+	/// Releases all atlas pages, glyphs are rasterized again on next use.
+	void clearAtlas() noexcept;
 } // namespace dmlib_glyph
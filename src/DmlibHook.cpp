@@ -28,6 +28,7 @@
 #include <unordered_set>
 #endif
 
+#include "DmlibResource.h"
 #include "ModuleHelper.h"
 
 #include "IatHook.h"
@@ -134,6 +135,7 @@ static auto HookFunction(HookData<T>& hookData, T newFn, const char* dllName, In
 	if (hookData.m_trueFn != nullptr)
 	{
 		++hookData.m_ref;
+		dmlib_resource::increment(DarkMode::ResourceType::hook);
 		return true;
 	}
 	return false;
@@ -151,6 +153,7 @@ static void UnhookFunction(HookData<T>& hookData) noexcept
 	if (hookData.m_ref > 0)
 	{
 		--hookData.m_ref;
+		dmlib_resource::decrement(DarkMode::ResourceType::hook);
 
 		if (hookData.m_trueFn != nullptr && hookData.m_ref == 0)
 		{
@@ -468,7 +471,7 @@ bool dmlib_hook::hookThemeColor() noexcept
 
 	if (dmlib_win32api::IsWindows11() && g_hDarkTheme == nullptr)
 	{
-		g_hDarkTheme = ::OpenThemeData(nullptr, L"DarkMode_Explorer::TaskDialog");
+		g_hDarkTheme = dmlib_resource::openThemeData(nullptr, L"DarkMode_Explorer::TaskDialog");
 		if (g_hDarkTheme != nullptr)
 		{
 			if (FAILED(::GetThemeColor(g_hDarkTheme, TDLG_PRIMARYPANEL, 0, TMT_FILLCOLOR, &clrMain)))
@@ -485,12 +488,12 @@ bool dmlib_hook::hookThemeColor() noexcept
 
 	if (g_hBrushBg == nullptr)
 	{
-		g_hBrushBg = ::CreateSolidBrush(clrMain);
+		g_hBrushBg = dmlib_resource::createSolidBrush(clrMain);
 	}
 
 	if (g_hBrushBgFooter == nullptr)
 	{
-		g_hBrushBgFooter = ::CreateSolidBrush(clrFooter);
+		g_hBrushBgFooter = dmlib_resource::createSolidBrush(clrFooter);
 	}
 
 	return
@@ -519,19 +522,19 @@ void dmlib_hook::unhookThemeColor() noexcept
 	UnhookFunction<fnDrawThemeBackgroundEx>(g_hookDataDrawThemeBackgroundEx);
 	if (g_hDarkTheme != nullptr && g_hookDataGetThemeColor.m_ref == 0)
 	{
-		::CloseThemeData(g_hDarkTheme);
+		dmlib_resource::closeThemeData(g_hDarkTheme);
 		g_hDarkTheme = nullptr;
 	}
 
 	if (g_hBrushBg != nullptr)
 	{
-		::DeleteObject(g_hBrushBg);
+		dmlib_resource::deleteObject(g_hBrushBg);
 		g_hBrushBg = nullptr;
 	}
 
 	if (g_hBrushBgFooter != nullptr)
 	{
-		::DeleteObject(g_hBrushBgFooter);
+		dmlib_resource::deleteObject(g_hBrushBgFooter);
 		g_hBrushBgFooter = nullptr;
 	}
 }
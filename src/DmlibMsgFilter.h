@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+namespace dmlib_subclass
+{
+	/**
+	 * @class MsgFilter
+	 * @brief Compile-time bitmap of messages handled by a subclass procedure.
+	 *
+	 * Lets subclass procedures pass uninteresting messages, e.g. `WM_MOUSEMOVE`,
+	 * `WM_TIMER`, `WM_GETTEXT`, or `WM_NCHITTEST`, directly to `DefSubclassProc`
+	 * with single bit test instead of running the whole message switch.
+	 *
+	 * Usage:
+	 * - Declare as `static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_PAINT, ... };`.
+	 * - For control specific messages, e.g. `TCM_*`, pass first message of the control range,
+	 *   `static constexpr MsgFilter kMsgFilter{ TCM_FIRST, { WM_NCDESTROY, TCM_SETITEMW, ... } };`.
+	 * - Check `kMsgFilter.contains(uMsg)` at the start of the subclass procedure.
+	 *
+	 * @note Only messages below `kMaxMsg` or in the control range of `kCtrlMsgCount`
+	 *       messages can be listed, listing other message fails to compile
+	 *       when the filter is declared `constexpr`.
+	 * @note Has no platform dependencies.
+	 */
+	class MsgFilter
+	{
+	public:
+		static constexpr unsigned int kMaxMsg = 0x800;
+		static constexpr unsigned int kCtrlMsgCount = 0x100;
+
+		constexpr MsgFilter(std::initializer_list<unsigned int> msgs) noexcept
+			: MsgFilter(0, msgs)
+		{}
+
+		constexpr MsgFilter(unsigned int ctrlMsgFirst, std::initializer_list<unsigned int> msgs) noexcept
+			: m_ctrlMsgFirst(ctrlMsgFirst)
+		{
+			for (const unsigned int msg : msgs)
+			{
+				if (MsgFilter::isCtrlMsg(msg))
+				{
+					const unsigned int idx = msg - m_ctrlMsgFirst;
+					m_ctrlBits[idx / kBitsPerWord] |= (std::uint64_t{ 1 } << (idx % kBitsPerWord));
+				}
+				else
+				{
+					m_bits[msg / kBitsPerWord] |= (std::uint64_t{ 1 } << (msg % kBitsPerWord));
+				}
+			}
+		}
+
+		[[nodiscard]] constexpr bool contains(unsigned int msg) const noexcept
+		{
+			if (msg < kMaxMsg)
+			{
+				return (m_bits[msg / kBitsPerWord] & (std::uint64_t{ 1 } << (msg % kBitsPerWord))) != 0;
+			}
+
+			if (MsgFilter::isCtrlMsg(msg))
+			{
+				const unsigned int idx = msg - m_ctrlMsgFirst;
+				return (m_ctrlBits[idx / kBitsPerWord] & (std::uint64_t{ 1 } << (idx % kBitsPerWord))) != 0;
+			}
+			return false;
+		}
+
+	private:
+		static constexpr unsigned int kBitsPerWord = 64;
+
+		[[nodiscard]] constexpr bool isCtrlMsg(unsigned int msg) const noexcept
+		{
+			return m_ctrlMsgFirst >= kMaxMsg
+				&& msg >= m_ctrlMsgFirst
+				&& (msg - m_ctrlMsgFirst) < kCtrlMsgCount;
+		}
+
+		std::array<std::uint64_t, kMaxMsg / kBitsPerWord> m_bits{};
+		std::array<std::uint64_t, kCtrlMsgCount / kBitsPerWord> m_ctrlBits{};
+		unsigned int m_ctrlMsgFirst = 0;
+	};
+} // namespace dmlib_subclass
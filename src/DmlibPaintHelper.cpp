@@ -16,11 +16,208 @@
 
 #include <windows.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "DmlibRaster.h"
+
+/// Whether antialiased software rasterization is used for rounded rectangles.
+static std::atomic<bool> g_isRasterEnabled = false;
+
+/**
+ * @brief Enables or disables antialiased software rasterization of rounded rectangles.
+ *
+ * @param[in] enable `true` to paint into 32-bpp DIB sections with `dmlib_raster`.
+ *
+ * @see dmlib_paint::paintRoundRect()
+ */
+void dmlib_paint::enableRaster(bool enable) noexcept
+{
+	g_isRasterEnabled = enable;
+}
+
+/**
+ * @brief Checks whether antialiased software rasterization is enabled.
+ *
+ * @return `true` if enabled.
+ */
+bool dmlib_paint::isRasterEnabled() noexcept
+{
+	return g_isRasterEnabled;
+}
+
+/**
+ * @brief Converts `COLORREF` to 0x00RRGGBB DIB pixel.
+ */
+[[nodiscard]] static std::uint32_t toPixel(COLORREF clr) noexcept
+{
+	return (static_cast<std::uint32_t>(GetRValue(clr)) << 16)
+		| (static_cast<std::uint32_t>(GetGValue(clr)) << 8)
+		| static_cast<std::uint32_t>(GetBValue(clr));
+}
+
+/**
+ * @brief Paints rounded rectangle directly into 32-bpp DIB section selected in memory DC.
+ *
+ * Handles only cases where result closely matches GDI `RoundRect`:
+ * - circular corners (`width == height`),
+ * - memory DC in `MM_TEXT` mode with selected top-down or bottom-up 32-bpp DIB section,
+ * - solid or inside frame pen, or null pen,
+ * - solid or null brush,
+ * - simple (rectangular) clipping region.
+ *
+ * @param[in]   hdc     Handle to the device context.
+ * @param[in]   rect    Rectangle bounds for the shape.
+ * @param[in]   hpen    Pen used to draw the edge.
+ * @param[in]   hBrush  Brush used to inner fill.
+ * @param[in]   width   Horizontal corner radius.
+ * @param[in]   height  Vertical corner radius.
+ * @return `true` if the shape was painted, `false` if caller should fall back to GDI.
+ */
+static bool rasterRoundRect(
+	HDC hdc,
+	const RECT& rect,
+	HPEN hpen,
+	HBRUSH hBrush,
+	int width,
+	int height
+) noexcept
+{
+	if (width != height
+		|| ::GetObjectType(hdc) != OBJ_MEMDC
+		|| ::GetMapMode(hdc) != MM_TEXT
+		|| ::GetObjectType(hpen) != OBJ_PEN)
+	{
+		return false;
+	}
+
+	DIBSECTION dib{};
+	const auto hBitmap = ::GetCurrentObject(hdc, OBJ_BITMAP);
+	if (::GetObjectW(hBitmap, sizeof(DIBSECTION), &dib) != static_cast<int>(sizeof(DIBSECTION))
+		|| dib.dsBm.bmBits == nullptr
+		|| dib.dsBmih.biBitCount != 32
+		|| dib.dsBmih.biCompression != BI_RGB)
+	{
+		return false;
+	}
+
+	LOGPEN lp{};
+	LOGBRUSH lb{};
+	if (::GetObjectW(hpen, sizeof(LOGPEN), &lp) == 0
+		|| ::GetObjectW(hBrush, sizeof(LOGBRUSH), &lb) == 0)
+	{
+		return false;
+	}
+
+	dmlib_raster::ShapeStyle style{};
+	RECT rcShape{ rect };
+	switch (lp.lopnStyle)
+	{
+		case PS_NULL:
+		{
+			// GDI excludes right and bottom edge when there is no frame
+			--rcShape.right;
+			--rcShape.bottom;
+			break;
+		}
+
+		case PS_SOLID:
+		case PS_INSIDEFRAME:
+		{
+			// wide solid pens are centered on the edge by GDI
+			if (lp.lopnStyle == PS_SOLID && lp.lopnWidth.x > 1)
+			{
+				return false;
+			}
+			style.m_frameWidth = (lp.lopnWidth.x > 1) ? lp.lopnWidth.x : 1;
+			style.m_frameColor = toPixel(lp.lopnColor);
+			break;
+		}
+
+		default:
+		{
+			return false;
+		}
+	}
+
+	switch (lb.lbStyle)
+	{
+		case BS_SOLID:
+		{
+			style.m_hasFill = true;
+			style.m_fillColor = toPixel(lb.lbColor);
+			break;
+		}
+
+		case BS_NULL:
+		{
+			break;
+		}
+
+		default:
+		{
+			return false;
+		}
+	}
+
+	RECT rcClip{};
+	switch (::GetClipBox(hdc, &rcClip))
+	{
+		case NULLREGION:
+		{
+			return true;
+		}
+
+		case SIMPLEREGION:
+		{
+			break;
+		}
+
+		default:
+		{
+			return false;
+		}
+	}
+
+	POINT ptViewport{};
+	POINT ptWindow{};
+	::GetViewportOrgEx(hdc, &ptViewport);
+	::GetWindowOrgEx(hdc, &ptWindow);
+	const int dx = ptViewport.x - ptWindow.x;
+	const int dy = ptViewport.y - ptWindow.y;
+
+	dmlib_raster::Surface surface{};
+	surface.m_width = dib.dsBm.bmWidth;
+	surface.m_height = (dib.dsBmih.biHeight < 0) ? -dib.dsBmih.biHeight : dib.dsBmih.biHeight;
+	const int stride = dib.dsBm.bmWidthBytes / static_cast<int>(sizeof(std::uint32_t));
+	auto* pixels = static_cast<std::uint32_t*>(dib.dsBm.bmBits);
+	if (dib.dsBmih.biHeight < 0)
+	{
+		surface.m_pixels = pixels;
+		surface.m_stride = stride;
+	}
+	else
+	{
+		surface.m_pixels = pixels + (static_cast<std::ptrdiff_t>(surface.m_height - 1) * stride);
+		surface.m_stride = -stride;
+	}
+
+	const dmlib_raster::Rect rcRaster{ rcShape.left + dx, rcShape.top + dy, rcShape.right + dx, rcShape.bottom + dy };
+	const dmlib_raster::Rect rcRasterClip{ rcClip.left + dx, rcClip.top + dy, rcClip.right + dx, rcClip.bottom + dy };
+
+	::GdiFlush();
+	dmlib_raster::paintRoundRect(surface, rcRasterClip, rcRaster, width / 2, style);
+	return true;
+}
+
 /**
  * @brief Paints a rounded rectangle using the specified pen and brush.
  *
  * Draws a rounded rectangle defined by `rect`, using the provided pen (`hpen`) and brush (`hBrush`)
  * for the edge and fill, respectively. Preserves previous GDI object selections.
+ * When enabled and the device context allows it, shape is rasterized
+ * with antialiased corners directly into the DIB section of the back buffer.
  *
  * @param[in]   hdc     Handle to the device context.
  * @param[in]   rect    Rectangle bounds for the shape.
@@ -38,6 +235,11 @@ void dmlib_paint::paintRoundRect(
 	int height
 ) noexcept
 {
+	if (g_isRasterEnabled && rasterRoundRect(hdc, rect, hpen, hBrush, width, height))
+	{
+		return;
+	}
+
 	auto holdBrush = ::SelectObject(hdc, hBrush);
 	auto holdPen = ::SelectObject(hdc, hpen);
 	::RoundRect(hdc, rect.left, rect.top, rect.right, rect.bottom, width, height);
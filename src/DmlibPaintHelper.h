@@ -16,6 +16,8 @@
 
 #include <utility>
 
+#include "DmlibResource.h"
+
 namespace dmlib_paint
 {
 	/// Base roundness value for various controls, such as toolbar iconic buttons and combo boxes
@@ -87,7 +89,7 @@ namespace dmlib_paint
 				::SelectObject(m_hdc, m_holdObj);
 				if (!m_isShared)
 				{
-					::DeleteObject(m_hObj);
+					dmlib_resource::deleteObject(m_hObj);
 					m_hObj = nullptr;
 				}
 			}
@@ -116,6 +118,9 @@ namespace dmlib_paint
 	 *
 	 * Allocates and manages an off-screen buffer via `BufferData`, clips to the paint region,
 	 * executes the provided paint function, and blits the result to the target DC.
+	 * Buffer covers only the update region, viewport origin of the memory DC is moved
+	 * so the paint function still uses client coordinates. Tiny update regions
+	 * are painted directly to the target DC.
 	 *
 	 * @tparam      T           Control data type containing a `m_bufferData` member.
 	 * @tparam      PaintFunc   Callable object (lambda or function) that performs painting.
@@ -136,32 +141,49 @@ namespace dmlib_paint
 		const RECT& rcClient
 	)
 	{
+		RECT rcBuffer{};
+		if (::IntersectRect(&rcBuffer, &ps.rcPaint, &rcClient) == FALSE)
+		{
+			return;
+		}
+
 		auto& bufferData = ctrlData.m_bufferData;
 
-		if (bufferData.ensureBuffer(hdc, rcClient))
+		if (bufferData.ensureBuffer(hdc, rcBuffer))
 		{
 			const auto& hMemDC = bufferData.getHMemDC();
+			const bool isDirect = bufferData.isDirect();
 			const int savedState = ::SaveDC(hMemDC);
 
+			if (!isDirect)
+			{
+				::SetViewportOrgEx(hMemDC, -rcBuffer.left, -rcBuffer.top, nullptr);
+			}
+
 			::IntersectClipRect(
 				hMemDC,
-				ps.rcPaint.left, ps.rcPaint.top,
-				ps.rcPaint.right, ps.rcPaint.bottom
+				rcBuffer.left, rcBuffer.top,
+				rcBuffer.right, rcBuffer.bottom
 			);
 
 			std::forward<PaintFunc>(paintFunc)();
 
 			::RestoreDC(hMemDC, savedState);
 
-			::BitBlt(
-				hdc,
-				ps.rcPaint.left, ps.rcPaint.top,
-				ps.rcPaint.right - ps.rcPaint.left,
-				ps.rcPaint.bottom - ps.rcPaint.top,
-				hMemDC,
-				ps.rcPaint.left, ps.rcPaint.top,
-				SRCCOPY
-			);
+			if (!isDirect)
+			{
+				::BitBlt(
+					hdc,
+					rcBuffer.left, rcBuffer.top,
+					rcBuffer.right - rcBuffer.left,
+					rcBuffer.bottom - rcBuffer.top,
+					hMemDC,
+					0, 0,
+					SRCCOPY
+				);
+			}
+
+			bufferData.endPaint();
 		}
 	}
 
@@ -196,6 +218,12 @@ namespace dmlib_paint
 		dmlib_paint::PaintWithBuffer(ctrlData, hdc, ps, std::forward<PaintFunc>(paintFunc), rcClient);
 	}
 
+	/// Enables or disables antialiased software rasterization of rounded rectangles.
+	void enableRaster(bool enable) noexcept;
+
+	/// Checks whether antialiased software rasterization is enabled.
+	[[nodiscard]] bool isRasterEnabled() noexcept;
+
 	/// Paints a rounded rectangle using the specified pen and brush.
 	void paintRoundRect(HDC hdc, const RECT& rect, HPEN hpen, HBRUSH hBrush, int width, int height) noexcept;
 
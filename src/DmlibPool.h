@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace dmlib_subclass
+{
+	/// Adds delta to the number of bytes of per-control state, counted as `ResourceType::stateBytes`.
+	void addStateBytes(std::ptrdiff_t delta) noexcept;
+
+	/**
+	 * @class SubclassPool
+	 * @brief Per-type slab allocator for subclass reference data.
+	 *
+	 * Objects are carved from slabs of `kSlabSize` slots, so opening and closing
+	 * dialogs with many subclassed controls does not hit the heap for every control.
+	 * Freed slots are kept in a thread-local free list; surplus slots and slots
+	 * of exiting threads are returned to the shared free list.
+	 * Slabs are released only at process exit.
+	 *
+	 * @note Has no platform dependencies.
+	 *
+	 * @tparam T Type of subclass reference data.
+	 *
+	 * @see PoolAllocated
+	 */
+	template <typename T>
+	class SubclassPool
+	{
+	public:
+		[[nodiscard]] static void* allocate()
+		{
+			auto& cache = SubclassPool::localCache();
+			if (cache.m_head == nullptr)
+			{
+				SubclassPool::refill(cache);
+			}
+
+			Node* node = cache.m_head;
+			cache.m_head = node->m_next;
+			--cache.m_count;
+			return node;
+		}
+
+		static void deallocate(void* ptr) noexcept
+		{
+			if (ptr == nullptr)
+			{
+				return;
+			}
+
+			auto& cache = SubclassPool::localCache();
+			auto* node = static_cast<Node*>(ptr);
+			node->m_next = cache.m_head;
+			cache.m_head = node;
+			if (++cache.m_count > kMaxLocalFree)
+			{
+				SubclassPool::flush(cache);
+			}
+		}
+
+	private:
+		union Node
+		{
+			Node* m_next;
+			alignas(T) unsigned char m_storage[sizeof(T)];
+		};
+
+		static constexpr size_t kSlabSize = 32;
+		static constexpr size_t kMaxLocalFree = 2 * kSlabSize;
+
+		struct SharedData
+		{
+			std::mutex m_mutex;
+			Node* m_head = nullptr;
+			std::vector<std::unique_ptr<Node[]>> m_slabs;
+		};
+
+		struct LocalCache
+		{
+			Node* m_head = nullptr;
+			size_t m_count = 0;
+
+			LocalCache() = default;
+
+			LocalCache(const LocalCache&) = delete;
+			LocalCache& operator=(const LocalCache&) = delete;
+
+			LocalCache(LocalCache&&) = delete;
+			LocalCache& operator=(LocalCache&&) = delete;
+
+			~LocalCache()
+			{
+				SubclassPool::flush(*this);
+			}
+		};
+
+		[[nodiscard]] static SharedData& sharedData() noexcept
+		{
+			static SharedData data;
+			return data;
+		}
+
+		[[nodiscard]] static LocalCache& localCache() noexcept
+		{
+			thread_local LocalCache cache;
+			return cache;
+		}
+
+		static void refill(LocalCache& cache)
+		{
+			auto& shared = SubclassPool::sharedData();
+			const std::lock_guard<std::mutex> lock(shared.m_mutex);
+
+			if (shared.m_head == nullptr)
+			{
+				auto slab = std::make_unique<Node[]>(kSlabSize);
+				for (size_t i = 0; i < kSlabSize; ++i)
+				{
+					slab[i].m_next = shared.m_head;
+					shared.m_head = &slab[i];
+				}
+				shared.m_slabs.push_back(std::move(slab));
+			}
+
+			for (size_t i = 0; i < kSlabSize && shared.m_head != nullptr; ++i)
+			{
+				Node* node = shared.m_head;
+				shared.m_head = node->m_next;
+				node->m_next = cache.m_head;
+				cache.m_head = node;
+				++cache.m_count;
+			}
+		}
+
+		static void flush(LocalCache& cache) noexcept
+		{
+			if (cache.m_head == nullptr)
+			{
+				return;
+			}
+
+			auto& shared = SubclassPool::sharedData();
+			const std::lock_guard<std::mutex> lock(shared.m_mutex);
+			while (cache.m_head != nullptr)
+			{
+				Node* node = cache.m_head;
+				cache.m_head = node->m_next;
+				node->m_next = shared.m_head;
+				shared.m_head = node;
+			}
+			cache.m_count = 0;
+		}
+	};
+
+	/**
+	 * @struct PoolAllocated
+	 * @brief Base class routing `new`/`delete` of subclass reference data to `SubclassPool`.
+	 *
+	 * Allocation via `std::make_unique` in `SetSubclass` and deletion via `std::unique_ptr`
+	 * in `RemoveSubclass` or in `WM_NCDESTROY` handling use the pool transparently.
+	 * Allocated bytes are reported via `dmlib_subclass::addStateBytes`.
+	 *
+	 * @tparam T Derived type.
+	 *
+	 * @see SubclassPool
+	 */
+	template <typename T>
+	struct PoolAllocated
+	{
+		[[nodiscard]] static void* operator new(size_t size)
+		{
+			void* ptr = (size != sizeof(T)) ? ::operator new(size) : SubclassPool<T>::allocate();
+			dmlib_subclass::addStateBytes(static_cast<std::ptrdiff_t>(size));
+			return ptr;
+		}
+
+		static void operator delete(void* ptr, size_t size) noexcept
+		{
+			dmlib_subclass::addStateBytes(-static_cast<std::ptrdiff_t>(size));
+			if (size != sizeof(T))
+			{
+				::operator delete(ptr);
+				return;
+			}
+			SubclassPool<T>::deallocate(ptr);
+		}
+	};
+} // namespace dmlib_subclass
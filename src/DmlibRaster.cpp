@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "StdAfx.h"
+
+#include "DmlibRaster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DMLIB_RASTER_AVX2
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define DMLIB_RASTER_SSE2
+#endif
+
+namespace // anonymous
+{
+	/**
+	 * @struct RoundShape
+	 * @brief Rounded rectangle described by center, half size and corner radius.
+	 */
+	struct RoundShape
+	{
+		float m_cx = 0.0f;
+		float m_cy = 0.0f;
+		float m_hw = 0.0f;
+		float m_hh = 0.0f;
+		float m_radius = 0.0f;
+		bool m_isEmpty = true;
+	};
+} // anonymous namespace
+
+/**
+ * @brief Creates rounded shape from integer rectangle.
+ *
+ * @param[in] rect      Rectangle with exclusive right and bottom edges.
+ * @param[in] radius    Corner radius, clamped to half of the shorter side.
+ * @return Shape, empty for rectangle without area.
+ */
+[[nodiscard]] static RoundShape makeShape(const dmlib_raster::Rect& rect, int radius) noexcept
+{
+	RoundShape shape{};
+	const int width = rect.m_right - rect.m_left;
+	const int height = rect.m_bottom - rect.m_top;
+	if (width <= 0 || height <= 0)
+	{
+		return shape;
+	}
+
+	shape.m_hw = static_cast<float>(width) / 2.0f;
+	shape.m_hh = static_cast<float>(height) / 2.0f;
+	shape.m_cx = static_cast<float>(rect.m_left) + shape.m_hw;
+	shape.m_cy = static_cast<float>(rect.m_top) + shape.m_hh;
+	shape.m_radius = std::clamp(static_cast<float>(radius), 0.0f, std::min(shape.m_hw, shape.m_hh));
+	shape.m_isEmpty = false;
+	return shape;
+}
+
+/**
+ * @brief Computes pixel coverage of rounded shape.
+ *
+ * Uses signed distance of the pixel center to the shape edge,
+ * pixels crossed by the edge get partial coverage.
+ *
+ * @param[in] x     Pixel column.
+ * @param[in] y     Pixel row.
+ * @param[in] shape Rounded shape.
+ * @return Coverage in range 0 to 1.
+ */
+[[nodiscard]] static float getCoverage(int x, int y, const RoundShape& shape) noexcept
+{
+	if (shape.m_isEmpty)
+	{
+		return 0.0f;
+	}
+
+	const float qx = std::fabs(static_cast<float>(x) + 0.5f - shape.m_cx) - (shape.m_hw - shape.m_radius);
+	const float qy = std::fabs(static_cast<float>(y) + 0.5f - shape.m_cy) - (shape.m_hh - shape.m_radius);
+	const float ox = std::max(qx, 0.0f);
+	const float oy = std::max(qy, 0.0f);
+	const float dist = std::sqrt((ox * ox) + (oy * oy)) + std::min(std::max(qx, qy), 0.0f) - shape.m_radius;
+	return std::clamp(0.5f - dist, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Blends frame and fill colors into pixel by their coverage weights.
+ *
+ * @param[in] dst           Destination pixel.
+ * @param[in] style         Shape colors.
+ * @param[in] frameWeight   Frame coverage.
+ * @param[in] fillWeight    Fill coverage.
+ * @return Blended pixel.
+ */
+[[nodiscard]] static std::uint32_t blendPixel(
+	std::uint32_t dst,
+	const dmlib_raster::ShapeStyle& style,
+	float frameWeight,
+	float fillWeight
+) noexcept
+{
+	const float dstWeight = 1.0f - frameWeight - fillWeight;
+
+	std::uint32_t result = dst & 0xFF000000;
+	for (int shift = 0; shift <= 16; shift += 8)
+	{
+		const float channel = (static_cast<float>((dst >> shift) & 0xFF) * dstWeight)
+			+ (static_cast<float>((style.m_frameColor >> shift) & 0xFF) * frameWeight)
+			+ (static_cast<float>((style.m_fillColor >> shift) & 0xFF) * fillWeight);
+		result |= static_cast<std::uint32_t>(std::clamp(channel + 0.5f, 0.0f, 255.0f)) << shift;
+	}
+	return result;
+}
+
+/**
+ * @brief Fills consecutive pixels with color.
+ *
+ * Stores 8 (AVX2) or 4 (SSE2) pixels per iteration when available.
+ *
+ * @param[out]  pixels  Pointer to the first pixel.
+ * @param[in]   count   Number of pixels, no action for non-positive value.
+ * @param[in]   color   Pixel value.
+ */
+void dmlib_raster::fillSpan(std::uint32_t* pixels, int count, std::uint32_t color) noexcept
+{
+	int i = 0;
+#if defined(DMLIB_RASTER_AVX2)
+	const __m256i value = _mm256_set1_epi32(static_cast<int>(color));
+	for (; i + 8 <= count; i += 8)
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), value);
+	}
+#elif defined(DMLIB_RASTER_SSE2)
+	const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), value);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		pixels[i] = color;
+	}
+}
+
+/**
+ * @brief Fills part of the row clipped to the clip columns.
+ *
+ * @param[out]  row     Pointer to the first pixel of the row.
+ * @param[in]   left    Left column of the span.
+ * @param[in]   right   Exclusive right column of the span.
+ * @param[in]   clip    Clip rectangle.
+ * @param[in]   color   Pixel value.
+ */
+static void fillClippedSpan(std::uint32_t* row, int left, int right, const dmlib_raster::Rect& clip, std::uint32_t color) noexcept
+{
+	left = std::max(left, clip.m_left);
+	right = std::min(right, clip.m_right);
+	if (right > left)
+	{
+		dmlib_raster::fillSpan(row + left, right - left, color);
+	}
+}
+
+/**
+ * @brief Paints antialiased filled and/or framed rounded rectangle.
+ *
+ * Frame is painted inside the rectangle. Only pixels in the corner boxes
+ * are antialiased, straight parts are filled as solid spans,
+ * so the result of zero radius matches GDI `Rectangle`.
+ *
+ * @param[in,out]   surface Target pixels.
+ * @param[in]       clip    Clip rectangle in surface coordinates.
+ * @param[in]       rect    Shape rectangle in surface coordinates.
+ * @param[in]       radius  Corner radius.
+ * @param[in]       style   Fill and frame colors and frame width.
+ */
+void dmlib_raster::paintRoundRect(
+	Surface& surface,
+	const Rect& clip,
+	const Rect& rect,
+	int radius,
+	const ShapeStyle& style
+) noexcept
+{
+	const Rect rcClip{
+		std::max({ clip.m_left, rect.m_left, 0 }),
+		std::max({ clip.m_top, rect.m_top, 0 }),
+		std::min({ clip.m_right, rect.m_right, surface.m_width }),
+		std::min({ clip.m_bottom, rect.m_bottom, surface.m_height })
+	};
+
+	const RoundShape outer = makeShape(rect, radius);
+	if (outer.m_isEmpty || rcClip.m_right <= rcClip.m_left || rcClip.m_bottom <= rcClip.m_top)
+	{
+		return;
+	}
+
+	const bool hasFill = style.m_hasFill;
+	const int frame = std::max(style.m_frameWidth, 0);
+	if (!hasFill && frame == 0)
+	{
+		return;
+	}
+
+	const int corner = static_cast<int>(std::ceil(outer.m_radius));
+	const Rect rcInner{ rect.m_left + frame, rect.m_top + frame, rect.m_right - frame, rect.m_bottom - frame };
+	const RoundShape inner = (frame > 0) ? makeShape(rcInner, corner - frame) : outer;
+
+	for (int y = rcClip.m_top; y < rcClip.m_bottom; ++y)
+	{
+		std::uint32_t* row = surface.m_pixels + (static_cast<std::ptrdiff_t>(y) * surface.m_stride);
+
+		const bool isCornerRow = (y < rect.m_top + corner) || (y >= rect.m_bottom - corner);
+		const bool isFrameRow = (y < rcInner.m_top) || (y >= rcInner.m_bottom);
+
+		int left = rect.m_left;
+		int right = rect.m_right;
+		if (isCornerRow)
+		{
+			// antialiased corner boxes
+			for (int x = rcClip.m_left; x < rcClip.m_right; ++x)
+			{
+				if (x >= rect.m_left + corner && x < rect.m_right - corner)
+				{
+					x = rect.m_right - corner - 1;
+					continue;
+				}
+
+				const float outerCoverage = getCoverage(x, y, outer);
+				const float innerCoverage = (frame > 0) ? getCoverage(x, y, inner) : outerCoverage;
+				const float frameWeight = outerCoverage - innerCoverage;
+				const float fillWeight = hasFill ? innerCoverage : 0.0f;
+				if (frameWeight + fillWeight > 0.0f)
+				{
+					row[x] = blendPixel(row[x], style, frameWeight, fillWeight);
+				}
+			}
+
+			left += corner;
+			right -= corner;
+		}
+
+		if (isFrameRow)
+		{
+			if (frame > 0)
+			{
+				fillClippedSpan(row, left, right, rcClip, style.m_frameColor);
+			}
+			continue;
+		}
+
+		if (frame > 0 && !isCornerRow)
+		{
+			fillClippedSpan(row, rect.m_left, rcInner.m_left, rcClip, style.m_frameColor);
+			fillClippedSpan(row, rcInner.m_right, rect.m_right, rcClip, style.m_frameColor);
+			left = rcInner.m_left;
+			right = rcInner.m_right;
+		}
+		else if (frame > 0)
+		{
+			// frame columns between the corner boxes cannot exist, inner edges lie inside corner boxes
+			left = std::max(left, rcInner.m_left);
+			right = std::min(right, rcInner.m_right);
+		}
+
+		if (hasFill)
+		{
+			fillClippedSpan(row, left, right, rcClip, style.m_fillColor);
+		}
+	}
+}
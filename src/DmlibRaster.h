@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace dmlib_raster
+ * @brief Software rasterizer for antialiased rounded rectangles.
+ *
+ * Paints directly into 32-bpp pixel memory, e.g. DIB section of back buffer.
+ * Has no platform dependencies, span fills use SSE2 or AVX2 when available.
+ */
+namespace dmlib_raster
+{
+	/**
+	 * @struct Surface
+	 * @brief 32-bpp pixel memory in 0x00RRGGBB layout.
+	 *
+	 * Members:
+	 * - `m_pixels`: Pointer to the first pixel of the top row.
+	 * - `m_width`: Width in pixels.
+	 * - `m_height`: Height in pixels.
+	 * - `m_stride`: Distance between rows in pixels, negative for bottom-up memory.
+	 */
+	struct Surface
+	{
+		std::uint32_t* m_pixels = nullptr;
+		int m_width = 0;
+		int m_height = 0;
+		int m_stride = 0;
+	};
+
+	/// Rectangle with exclusive right and bottom edges, same as Win32 `RECT`.
+	struct Rect
+	{
+		int m_left = 0;
+		int m_top = 0;
+		int m_right = 0;
+		int m_bottom = 0;
+	};
+
+	/**
+	 * @struct ShapeStyle
+	 * @brief Fill and frame of rounded rectangle.
+	 *
+	 * Members:
+	 * - `m_fillColor`: Fill color in 0x00RRGGBB layout.
+	 * - `m_frameColor`: Frame color in 0x00RRGGBB layout.
+	 * - `m_frameWidth`: Width of the frame inside the shape, `0` for no frame.
+	 * - `m_hasFill`: Whether the shape is filled.
+	 */
+	struct ShapeStyle
+	{
+		std::uint32_t m_fillColor = 0;
+		std::uint32_t m_frameColor = 0;
+		int m_frameWidth = 0;
+		bool m_hasFill = false;
+	};
+
+	/// Fills consecutive pixels with color.
+	void fillSpan(std::uint32_t* pixels, int count, std::uint32_t color) noexcept;
+
+	/// Paints antialiased filled and/or framed rounded rectangle.
+	void paintRoundRect(Surface& surface, const Rect& clip, const Rect& rect, int radius, const ShapeStyle& style) noexcept;
+} // namespace dmlib_raster
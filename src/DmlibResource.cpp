@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "StdAfx.h"
+
+#include "DmlibResource.h"
+
+#include <windows.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace // anonymous
+{
+	/**
+	 * @struct ResourceCounter
+	 * @brief Current value and high-water mark of one resource type.
+	 *
+	 * Relaxed atomics are used, counters are cheap enough for release builds,
+	 * but values read from other threads are only approximate.
+	 */
+	struct ResourceCounter
+	{
+		std::atomic<std::ptrdiff_t> m_current{ 0 };
+		std::atomic<std::ptrdiff_t> m_peak{ 0 };
+	};
+
+	constinit std::array<ResourceCounter, static_cast<size_t>(DarkMode::ResourceType::maxValue)> g_resourceCounters{};
+
+	/// Second (`GetTickCount64() / 1000`) of the last event of each rate counter.
+	constinit std::array<std::atomic<ULONGLONG>, static_cast<size_t>(DarkMode::ResourceType::maxValue)> g_rateSeconds{};
+
+	/// Returns current second for rate counters.
+	[[nodiscard]] ULONGLONG getRateSecond() noexcept
+	{
+		return ::GetTickCount64() / 1000;
+	}
+} // anonymous namespace
+
+/**
+ * @brief Adds delta to the resource counter and updates its high-water mark.
+ *
+ * @param[in] type  Resource type.
+ * @param[in] delta Positive value for acquired, negative value for released resources.
+ */
+void dmlib_resource::add(ResourceType type, std::ptrdiff_t delta) noexcept
+{
+	const auto idx = static_cast<size_t>(type);
+	if (idx >= g_resourceCounters.size())
+	{
+		return;
+	}
+
+	auto& counter = g_resourceCounters[idx];
+	const std::ptrdiff_t current = counter.m_current.fetch_add(delta, std::memory_order_relaxed) + delta;
+	if (delta > 0)
+	{
+		std::ptrdiff_t peak = counter.m_peak.load(std::memory_order_relaxed);
+		while (current > peak && !counter.m_peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+/**
+ * @brief Retrieves current or peak value of the resource counter.
+ *
+ * @param[in] type      Resource type.
+ * @param[in] isPeak    `true` for high-water mark, `false` for current value.
+ * @return Counter value, `0` for invalid type.
+ */
+std::ptrdiff_t dmlib_resource::getCount(ResourceType type, bool isPeak) noexcept
+{
+	const auto idx = static_cast<size_t>(type);
+	if (idx >= g_resourceCounters.size())
+	{
+		return 0;
+	}
+
+	const auto& counter = g_resourceCounters[idx];
+	if (!isPeak
+		&& type == ResourceType::bufferReallocs
+		&& g_rateSeconds[idx].load(std::memory_order_relaxed) != getRateSecond())
+	{
+		return 0; // no event in the current second
+	}
+	return (isPeak ? counter.m_peak : counter.m_current).load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Counts one event of rate counter.
+ *
+ * Current value holds number of events in the current second and is reset
+ * with the first event of each new second, so peak value is the highest
+ * number of events per second.
+ *
+ * @param[in] type Rate counter type, e.g. `ResourceType::bufferReallocs`.
+ */
+void dmlib_resource::countRate(ResourceType type) noexcept
+{
+	const auto idx = static_cast<size_t>(type);
+	if (idx >= g_resourceCounters.size())
+	{
+		return;
+	}
+
+	const ULONGLONG second = getRateSecond();
+	if (g_rateSeconds[idx].exchange(second, std::memory_order_relaxed) != second)
+	{
+		g_resourceCounters[idx].m_current.store(0, std::memory_order_relaxed);
+	}
+	dmlib_resource::add(type, 1);
+}
+
+/**
+ * @brief Deletes GDI object and updates counter by its object type.
+ *
+ * Objects of types that are not counted (e.g. palettes) are only deleted.
+ *
+ * @param[in] hObj Handle to the GDI object.
+ * @return `TRUE` if the object was deleted.
+ */
+BOOL dmlib_resource::deleteObject(HGDIOBJ hObj) noexcept
+{
+	if (hObj == nullptr)
+	{
+		return FALSE;
+	}
+
+	const DWORD objType = ::GetObjectType(hObj);
+	if (::DeleteObject(hObj) == FALSE)
+	{
+		return FALSE;
+	}
+
+	switch (objType)
+	{
+		case OBJ_BRUSH:
+		{
+			dmlib_resource::decrement(ResourceType::brush);
+			break;
+		}
+
+		case OBJ_PEN:
+		case OBJ_EXTPEN:
+		{
+			dmlib_resource::decrement(ResourceType::pen);
+			break;
+		}
+
+		case OBJ_FONT:
+		{
+			dmlib_resource::decrement(ResourceType::font);
+			break;
+		}
+
+		case OBJ_BITMAP:
+		{
+			dmlib_resource::decrement(ResourceType::bitmap);
+			break;
+		}
+
+		case OBJ_REGION:
+		{
+			dmlib_resource::decrement(ResourceType::region);
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+	return TRUE;
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <windows.h>
+
+#include <uxtheme.h>
+
+#include <cstddef>
+
+#include "DarkModeSubclass.h"
+
+namespace dmlib_resource
+{
+	using DarkMode::ResourceType;
+
+	/// Adds delta to the resource counter and updates its high-water mark.
+	void add(ResourceType type, std::ptrdiff_t delta) noexcept;
+	/// Retrieves current or peak value of the resource counter.
+	[[nodiscard]] std::ptrdiff_t getCount(ResourceType type, bool isPeak) noexcept;
+
+	/// Counts event of rate counter, e.g. `ResourceType::bufferReallocs`.
+	void countRate(ResourceType type) noexcept;
+
+	inline void increment(ResourceType type) noexcept
+	{
+		dmlib_resource::add(type, 1);
+	}
+
+	inline void decrement(ResourceType type) noexcept
+	{
+		dmlib_resource::add(type, -1);
+	}
+
+	/// Counts created GDI object, returns the object unchanged.
+	template <typename T>
+	[[nodiscard]] inline T trackObj(T hObj, ResourceType type) noexcept
+	{
+		if (hObj != nullptr)
+		{
+			dmlib_resource::increment(type);
+		}
+		return hObj;
+	}
+
+	[[nodiscard]] inline HBRUSH createSolidBrush(COLORREF clr) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateSolidBrush(clr), ResourceType::brush);
+	}
+
+	[[nodiscard]] inline HPEN createPen(int iStyle, int cWidth, COLORREF clr) noexcept
+	{
+		return dmlib_resource::trackObj(::CreatePen(iStyle, cWidth, clr), ResourceType::pen);
+	}
+
+	[[nodiscard]] inline HFONT createFontIndirect(const LOGFONTW* lplf) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateFontIndirectW(lplf), ResourceType::font);
+	}
+
+	[[nodiscard]] inline HDC createCompatibleDC(HDC hdc) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateCompatibleDC(hdc), ResourceType::dc);
+	}
+
+	[[nodiscard]] inline HBITMAP createCompatibleBitmap(HDC hdc, int cx, int cy) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateCompatibleBitmap(hdc, cx, cy), ResourceType::bitmap);
+	}
+
+	[[nodiscard]] inline HRGN createRectRgn(int x1, int y1, int x2, int y2) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateRectRgn(x1, y1, x2, y2), ResourceType::region);
+	}
+
+	[[nodiscard]] inline HRGN createRectRgnIndirect(const RECT* lprect) noexcept
+	{
+		return dmlib_resource::trackObj(::CreateRectRgnIndirect(lprect), ResourceType::region);
+	}
+
+	/// Creates 32-bpp top-down DIB section, pointer to its pixels is returned via `ppBits`.
+	[[nodiscard]] inline HBITMAP createDIBSection32(HDC hdc, int cx, int cy, void** ppBits) noexcept
+	{
+		BITMAPINFO bmi{};
+		bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+		bmi.bmiHeader.biWidth = cx;
+		bmi.bmiHeader.biHeight = -cy;
+		bmi.bmiHeader.biPlanes = 1;
+		bmi.bmiHeader.biBitCount = 32;
+		bmi.bmiHeader.biCompression = BI_RGB;
+
+		return dmlib_resource::trackObj(::CreateDIBSection(hdc, &bmi, DIB_RGB_COLORS, ppBits, nullptr, 0), ResourceType::bitmap);
+	}
+
+	/// Deletes GDI object, counters are updated by object type.
+	BOOL deleteObject(HGDIOBJ hObj) noexcept;
+
+	inline BOOL deleteDC(HDC hdc) noexcept
+	{
+		if (hdc != nullptr && ::DeleteDC(hdc) == TRUE)
+		{
+			dmlib_resource::decrement(ResourceType::dc);
+			return TRUE;
+		}
+		return FALSE;
+	}
+
+	[[nodiscard]] inline HTHEME openThemeData(HWND hWnd, LPCWSTR pszClassList) noexcept
+	{
+		return dmlib_resource::trackObj(::OpenThemeData(hWnd, pszClassList), ResourceType::theme);
+	}
+
+	inline HRESULT closeThemeData(HTHEME hTheme) noexcept
+	{
+		const HRESULT hr = ::CloseThemeData(hTheme);
+		if (hTheme != nullptr && SUCCEEDED(hr))
+		{
+			dmlib_resource::decrement(ResourceType::theme);
+		}
+		return hr;
+	}
+} // namespace dmlib_resource
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+/**
+ * @namespace dmlib_slice
+ * @brief Time budget and ordering logic for processing work in slices.
+ *
+ * Used by asynchronous child control theming, has no platform dependencies.
+ */
+namespace dmlib_slice
+{
+	/// Default time budget in milliseconds per slice.
+	inline constexpr unsigned int kDefaultSliceMs = 8;
+
+	/**
+	 * @brief Resolves time budget of one slice.
+	 *
+	 * @param[in] sliceMs Requested time budget in milliseconds, `0` for default.
+	 * @return Time budget in milliseconds.
+	 */
+	[[nodiscard]] constexpr unsigned int getSliceMs(unsigned int sliceMs) noexcept
+	{
+		return (sliceMs == 0) ? kDefaultSliceMs : sliceMs;
+	}
+
+	/**
+	 * @brief Processes work items until there are no more or the time budget is exhausted.
+	 *
+	 * At least one item is processed per slice, so the work always progresses
+	 * even with budget shorter than a single item.
+	 *
+	 * @tparam      Clock       Clock used to measure the budget, replaceable in tests.
+	 * @tparam      ProcessFn   Callable `bool()` which processes next item and returns
+	 *                          `true` if more items remain. Returns `false` without
+	 *                          processing anything when no item is left.
+	 * @param[in]   budget      Time budget of the slice.
+	 * @param[in]   processNext Callable processing one item.
+	 * @return `true` if all items were processed, `false` if the budget was exhausted first.
+	 */
+	template <typename Clock = std::chrono::steady_clock, typename ProcessFn>
+	[[nodiscard]] bool runSlice(typename Clock::duration budget, ProcessFn&& processNext)
+	{
+		const auto deadline = Clock::now() + budget;
+		for (;;)
+		{
+			if (!processNext())
+			{
+				return true;
+			}
+
+			if (Clock::now() >= deadline)
+			{
+				return false;
+			}
+		}
+	}
+
+	/**
+	 * @brief Finds the outermost hidden ancestor of a node below the root node.
+	 *
+	 * Node itself and the root node are not checked.
+	 *
+	 * @tparam      Node        Node handle type, value-initialized `Node{}` means no node.
+	 * @tparam      GetParentFn Callable `Node(Node)` returning parent node, or `Node{}` to stop the walk.
+	 * @tparam      IsVisibleFn Callable `bool(Node)` checking visibility of single node.
+	 * @param[in]   node        Node to check.
+	 * @param[in]   root        Root node, walk stops there.
+	 * @param[in]   getParent   Callable returning parent node.
+	 * @param[in]   isVisible   Callable checking visibility.
+	 * @return Hidden ancestor closest to the root, or `Node{}` if all ancestors are visible.
+	 */
+	template <typename Node, typename GetParentFn, typename IsVisibleFn>
+	[[nodiscard]] Node findHiddenAncestor(Node node, Node root, GetParentFn&& getParent, IsVisibleFn&& isVisible)
+	{
+		Node hidden{};
+		for (Node current = getParent(node);
+			current != Node{} && current != root;
+			current = getParent(current))
+		{
+			if (!isVisible(current))
+			{
+				hidden = current;
+			}
+		}
+		return hidden;
+	}
+
+	/**
+	 * @brief Orders work items so items already shown to the user are processed first.
+	 *
+	 * Relative order of shown items and of other items is kept,
+	 * so enumeration order (parents before their children) is preserved in both groups.
+	 *
+	 * @tparam      Iter        Random access iterator of the work items.
+	 * @tparam      IsShownFn   Callable `bool(const Item&)` checking if the item is shown.
+	 * @param[in]   first       Begin of the work items.
+	 * @param[in]   last        End of the work items.
+	 * @param[in]   isShown     Callable checking if the item is shown.
+	 * @return Iterator to the first item which is not shown.
+	 */
+	template <typename Iter, typename IsShownFn>
+	Iter orderShownFirst(Iter first, Iter last, IsShownFn&& isShown)
+	{
+		return std::stable_partition(first, last, std::forward<IsShownFn>(isShown));
+	}
+} // namespace dmlib_slice
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace dmlib_subclass
+{
+	/**
+	 * @class StateHash
+	 * @brief FNV-1a accumulator for keys of cached paint results.
+	 *
+	 * Every input which changes the painted picture (state IDs, size, colors, ...)
+	 * is added to the hash, equal hash means cached picture can be reused.
+	 *
+	 * @note Has no platform dependencies.
+	 *
+	 * @see PaintCache
+	 */
+	class StateHash
+	{
+	public:
+		template <typename T>
+		constexpr StateHash& add(T value) noexcept
+		{
+			static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "StateHash accepts only integral and enum values");
+
+			const auto bits = static_cast<std::uint64_t>(value);
+			for (size_t i = 0; i < sizeof(T); ++i)
+			{
+				m_hash = (m_hash ^ ((bits >> (i * 8)) & 0xFF)) * kFnvPrime;
+			}
+			return *this;
+		}
+
+		/// Adds text with its length, so adjacent texts cannot be shifted into each other.
+		constexpr StateHash& addText(const wchar_t* text, size_t length) noexcept
+		{
+			add(length);
+			for (size_t i = 0; i < length; ++i)
+			{
+				add(static_cast<std::uint16_t>(text[i]));
+			}
+			return *this;
+		}
+
+		[[nodiscard]] constexpr std::uint64_t value() const noexcept
+		{
+			return m_hash;
+		}
+
+	private:
+		static constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+		static constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+		std::uint64_t m_hash = kFnvOffset;
+	};
+
+	/**
+	 * @struct ButtonPaintKey
+	 * @brief Paint inputs of checkbox, radio, or tri-state button picture.
+	 *
+	 * Members:
+	 * - `m_partID`, `m_stateID`: Theme part and state, state covers checked, hot and pressed states.
+	 * - `m_width`, `m_height`: Client size.
+	 * - `m_dpi`: DPI of the control.
+	 * - `m_theme`: Theme handle value, changes with theme and visual style variant.
+	 * - `m_hasFocus`: Whether focus rectangle can be drawn.
+	 * - `m_isEnabled`: Whether the control is enabled.
+	 * - `m_textColor`, `m_disabledTextColor`, `m_bgColor`: Colors used for text and background.
+	 * - `m_originX`, `m_originY`: Position in the parent client area, parent background is painted below.
+	 * - `m_parentBrush`, `m_parentBrushColor`: Background brush of the parent and its color.
+	 * - `m_text`, `m_textLength`: Button text.
+	 *
+	 * @see hashButtonPaintKey()
+	 */
+	struct ButtonPaintKey
+	{
+		int m_partID = 0;
+		int m_stateID = 0;
+		int m_width = 0;
+		int m_height = 0;
+		unsigned int m_dpi = 0;
+		std::uintptr_t m_theme = 0;
+		bool m_hasFocus = false;
+		bool m_isEnabled = false;
+		std::uint32_t m_textColor = 0;
+		std::uint32_t m_disabledTextColor = 0;
+		std::uint32_t m_bgColor = 0;
+		int m_originX = 0;
+		int m_originY = 0;
+		std::uintptr_t m_parentBrush = 0;
+		std::uint32_t m_parentBrushColor = 0;
+		const wchar_t* m_text = nullptr;
+		size_t m_textLength = 0;
+	};
+
+	/**
+	 * @brief Computes hash of button paint inputs for `PaintCache`.
+	 *
+	 * @param[in] key Paint inputs.
+	 * @return Hash of all members.
+	 */
+	[[nodiscard]] constexpr std::uint64_t hashButtonPaintKey(const ButtonPaintKey& key) noexcept
+	{
+		return StateHash{}
+			.add(key.m_partID)
+			.add(key.m_stateID)
+			.add(key.m_width)
+			.add(key.m_height)
+			.add(key.m_dpi)
+			.add(key.m_theme)
+			.add(key.m_hasFocus)
+			.add(key.m_isEnabled)
+			.add(key.m_textColor)
+			.add(key.m_disabledTextColor)
+			.add(key.m_bgColor)
+			.add(key.m_originX)
+			.add(key.m_originY)
+			.add(key.m_parentBrush)
+			.add(key.m_parentBrushColor)
+			.addText(key.m_text, (key.m_text != nullptr) ? key.m_textLength : 0)
+			.value();
+	}
+} // namespace dmlib_subclass
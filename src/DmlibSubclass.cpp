@@ -14,6 +14,26 @@
 
 #include "DmlibSubclass.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "DarkModeSubclass.h"
+
+#include "DmlibDpi.h"
+#include "DmlibPaintHelper.h"
+#include "DmlibResource.h"
+
 #if defined(_DARKMODELIB_PREFER_THEME)
 namespace dmlib_win32api
 {
@@ -37,3 +57,1255 @@ bool dmlib_subclass::isThemePrefered() noexcept
 	return false;
 #endif
 }
+
+/**
+ * @brief Retrieves live subclass counters indexed by subclass ID offset.
+ *
+ * @return Reference to the static array of counters.
+ */
+static std::array<std::atomic<size_t>, dmlib_subclass::kSubclassIDCount>& getLiveCounters() noexcept
+{
+	static std::array<std::atomic<size_t>, dmlib_subclass::kSubclassIDCount> counters{};
+	return counters;
+}
+
+/**
+ * @brief Retrieves high-water marks of live subclass counters.
+ *
+ * @return Reference to the static array of peak values.
+ */
+static std::array<std::atomic<size_t>, dmlib_subclass::kSubclassIDCount>& getPeakLiveCounters() noexcept
+{
+	static std::array<std::atomic<size_t>, dmlib_subclass::kSubclassIDCount> peaks{};
+	return peaks;
+}
+
+/**
+ * @brief Converts subclass identifier to live counter index.
+ *
+ * @param[in] uIdSubclass Subclass identifier.
+ * @return Counter index, or `kSubclassIDCount` if identifier is not a `SubclassID`.
+ */
+[[nodiscard]] static size_t getLiveCounterIndex(UINT_PTR uIdSubclass) noexcept
+{
+	static constexpr auto firstID = static_cast<UINT_PTR>(dmlib_subclass::SubclassID::button);
+	if (uIdSubclass < firstID || uIdSubclass - firstID >= dmlib_subclass::kSubclassIDCount)
+	{
+		return dmlib_subclass::kSubclassIDCount;
+	}
+	return static_cast<size_t>(uIdSubclass - firstID);
+}
+
+/**
+ * @brief Increments live subclass counter for the subclass ID.
+ *
+ * Called when subclass was successfully installed.
+ *
+ * @param[in] subID Subclass identifier.
+ */
+void dmlib_subclass::incrementLiveCount(SubclassID subID) noexcept
+{
+	if (const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+		idx < kSubclassIDCount)
+	{
+		const size_t count = getLiveCounters()[idx].fetch_add(1, std::memory_order_relaxed) + 1;
+		auto& peak = getPeakLiveCounters()[idx];
+		size_t peakCount = peak.load(std::memory_order_relaxed);
+		while (count > peakCount && !peak.compare_exchange_weak(peakCount, count, std::memory_order_relaxed))
+		{
+		}
+		dmlib_resource::increment(DarkMode::ResourceType::subclass);
+	}
+}
+
+/**
+ * @brief Decrements live subclass counter for the subclass ID.
+ *
+ * Called when subclass was successfully removed.
+ *
+ * @param[in] uIdSubclass Subclass identifier.
+ */
+void dmlib_subclass::decrementLiveCount(UINT_PTR uIdSubclass) noexcept
+{
+	if (const size_t idx = getLiveCounterIndex(uIdSubclass);
+		idx < kSubclassIDCount)
+	{
+		auto& counter = getLiveCounters()[idx];
+		size_t count = counter.load(std::memory_order_relaxed);
+		while (count > 0 && !counter.compare_exchange_weak(count, count - 1, std::memory_order_relaxed))
+		{
+		}
+		if (count > 0)
+		{
+			dmlib_resource::decrement(DarkMode::ResourceType::subclass);
+		}
+	}
+}
+
+/**
+ * @brief Retrieves number of currently installed subclasses with the subclass ID.
+ *
+ * @param[in] subID Subclass identifier.
+ * @return Number of live subclasses.
+ */
+size_t dmlib_subclass::getLiveCount(SubclassID subID) noexcept
+{
+	if (const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+		idx < kSubclassIDCount)
+	{
+		return getLiveCounters()[idx].load(std::memory_order_relaxed);
+	}
+	return 0;
+}
+
+/**
+ * @brief Retrieves highest number of simultaneously installed subclasses with the subclass ID.
+ *
+ * @param[in] subID Subclass identifier.
+ * @return High-water mark of live subclasses.
+ */
+size_t dmlib_subclass::getPeakLiveCount(SubclassID subID) noexcept
+{
+	if (const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+		idx < kSubclassIDCount)
+	{
+		return getPeakLiveCounters()[idx].load(std::memory_order_relaxed);
+	}
+	return 0;
+}
+
+/**
+ * @brief Adds delta to the number of bytes of per-control state.
+ *
+ * Used by `PoolAllocated` subclass reference data.
+ *
+ * @param[in] delta Positive value for allocated, negative value for freed bytes.
+ */
+void dmlib_subclass::addStateBytes(std::ptrdiff_t delta) noexcept
+{
+	dmlib_resource::add(DarkMode::ResourceType::stateBytes, delta);
+}
+
+namespace // anonymous
+{
+	static_assert(dmlib_subclass::kSubclassIDCount <= 32, "subclass mask must fit into 32 bits");
+
+	/**
+	 * @struct SubclassRegistry
+	 * @brief Per-window record of installed library subclasses.
+	 *
+	 * Stored as single window property keyed by an integer atom for all library
+	 * subclasses of the window. Lookup is a `GetPropW` call, which walks the usually
+	 * short property list of the window, not a constant time operation.
+	 *
+	 * Members:
+	 * - `m_mask`: Bit per installed subclass, indexed by subclass ID offset.
+	 * - `m_refData`: Reference data of installed subclasses.
+	 */
+	struct SubclassRegistry : public dmlib_subclass::PoolAllocated<SubclassRegistry>
+	{
+		std::uint32_t m_mask = 0;
+		std::array<DWORD_PTR, dmlib_subclass::kSubclassIDCount> m_refData{};
+	};
+
+	/**
+	 * @class GlobalAtom
+	 * @brief RAII-style owner of global atom used as window property name.
+	 *
+	 * Atom is added in the constructor and deleted in the destructor,
+	 * so the global atom table does not keep library atoms after the library is unloaded.
+	 */
+	class GlobalAtom
+	{
+	public:
+		GlobalAtom() = delete;
+
+		explicit GlobalAtom(const wchar_t* name) noexcept
+			: m_atom(::GlobalAddAtomW(name))
+		{}
+
+		GlobalAtom(const GlobalAtom&) = delete;
+		GlobalAtom& operator=(const GlobalAtom&) = delete;
+
+		GlobalAtom(GlobalAtom&&) = delete;
+		GlobalAtom& operator=(GlobalAtom&&) = delete;
+
+		~GlobalAtom()
+		{
+			if (m_atom != 0)
+			{
+				::GlobalDeleteAtom(m_atom);
+			}
+		}
+
+		/// Property name as `MAKEINTATOM` value, `nullptr` if the atom could not be added.
+		[[nodiscard]] const wchar_t* getName() const noexcept
+		{
+			return (m_atom != 0) ? MAKEINTATOM(m_atom) : nullptr;
+		}
+
+	private:
+		ATOM m_atom = 0;
+	};
+} // anonymous namespace
+
+/**
+ * @brief Retrieves window property name used for subclass registry.
+ *
+ * Integer atom is used, so property lookup does not need string comparison.
+ *
+ * @return Property name as `MAKEINTATOM` value, or `nullptr` if the atom is not available.
+ */
+[[nodiscard]] static const wchar_t* getRegistryPropName() noexcept
+{
+	static const GlobalAtom atom{ L"DarkModeLibSubclassRegistry" };
+	return atom.getName();
+}
+
+/**
+ * @brief Retrieves subclass registry of the window.
+ *
+ * @param[in] hWnd Handle to the window.
+ * @return Pointer to registry, or `nullptr` if no library subclass is registered.
+ */
+[[nodiscard]] static SubclassRegistry* getSubclassRegistry(HWND hWnd) noexcept
+{
+	const wchar_t* propName = getRegistryPropName();
+	return (propName != nullptr) ? static_cast<SubclassRegistry*>(::GetPropW(hWnd, propName)) : nullptr;
+}
+
+/**
+ * @brief Records installed subclass and its reference data for the window.
+ *
+ * Also increments live subclass counter.
+ *
+ * @param[in] hWnd      Handle to the subclassed window.
+ * @param[in] subID     Subclass ID.
+ * @param[in] dwRefData Reference data passed to `SetWindowSubclass`.
+ * @return `true` if the subclass was recorded, `false` if the registry could not be created.
+ *
+ * @see dmlib_subclass::installSubclass()
+ */
+bool dmlib_subclass::registerSubclass(HWND hWnd, SubclassID subID, DWORD_PTR dwRefData) noexcept
+{
+	const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+	const wchar_t* propName = getRegistryPropName();
+	if (idx >= kSubclassIDCount || propName == nullptr)
+	{
+		return false;
+	}
+
+	auto* pRegistry = getSubclassRegistry(hWnd);
+	if (pRegistry == nullptr)
+	{
+		try
+		{
+			auto ptrRegistry = std::make_unique<SubclassRegistry>();
+			if (::SetPropW(hWnd, propName, ptrRegistry.get()) == FALSE)
+			{
+				return false;
+			}
+			pRegistry = ptrRegistry.release();
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	pRegistry->m_mask |= (std::uint32_t{ 1 } << idx);
+	pRegistry->m_refData[idx] = dwRefData;
+	dmlib_subclass::incrementLiveCount(subID);
+	return true;
+}
+
+/**
+ * @brief Forgets removed subclass of the window.
+ *
+ * Registry is freed and window property removed with the last subclass.
+ * Also decrements live subclass counter.
+ *
+ * @param[in] hWnd          Handle to the subclassed window.
+ * @param[in] uIdSubclass   Subclass identifier.
+ */
+void dmlib_subclass::unregisterSubclass(HWND hWnd, UINT_PTR uIdSubclass) noexcept
+{
+	dmlib_subclass::decrementLiveCount(uIdSubclass);
+
+	const size_t idx = getLiveCounterIndex(uIdSubclass);
+	auto* pRegistry = getSubclassRegistry(hWnd);
+	if (idx >= kSubclassIDCount || pRegistry == nullptr)
+	{
+		return;
+	}
+
+	pRegistry->m_mask &= ~(std::uint32_t{ 1 } << idx);
+	pRegistry->m_refData[idx] = 0;
+
+	if (pRegistry->m_mask == 0)
+	{
+		::RemovePropW(hWnd, getRegistryPropName());
+		std::unique_ptr<SubclassRegistry> ptrRegistry(pRegistry);
+	}
+}
+
+/**
+ * @brief Checks if subclass with the subclass ID is installed on the window.
+ *
+ * @param[in] hWnd  Handle to the window.
+ * @param[in] subID Subclass ID.
+ * @return `true` if subclass is installed.
+ */
+bool dmlib_subclass::isSubclassRegistered(HWND hWnd, SubclassID subID) noexcept
+{
+	const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+	const auto* pRegistry = getSubclassRegistry(hWnd);
+	return idx < kSubclassIDCount
+		&& pRegistry != nullptr
+		&& (pRegistry->m_mask & (std::uint32_t{ 1 } << idx)) != 0;
+}
+
+/**
+ * @brief Retrieves reference data of installed subclass.
+ *
+ * @param[in] hWnd  Handle to the window.
+ * @param[in] subID Subclass ID.
+ * @return Reference data, or `0` if subclass is not installed.
+ */
+DWORD_PTR dmlib_subclass::getSubclassRefData(HWND hWnd, SubclassID subID) noexcept
+{
+	if (dmlib_subclass::isSubclassRegistered(hWnd, subID))
+	{
+		const size_t idx = getLiveCounterIndex(static_cast<UINT_PTR>(subID));
+		return getSubclassRegistry(hWnd)->m_refData[idx];
+	}
+	return 0;
+}
+
+namespace // anonymous
+{
+	/**
+	 * @struct ThemeCacheEntry
+	 * @brief Shared theme handle with its key and reference count.
+	 *
+	 * Members:
+	 * - `m_themeClass`: Theme class name.
+	 * - `m_subApp`: Index of sub-app name and ID list set via `dmlib_subclass::setWindowTheme`, `0` for default.
+	 * - `m_dpi`: DPI the theme was opened for.
+	 * - `m_isDark`: Whether theme was opened while dark mode was active.
+	 * - `m_hTheme`: Shared theme handle.
+	 * - `m_ref`: Number of `ThemeData` instances holding the handle.
+	 * - `m_isInvalid`: Entry is no longer returned by lookups, closed when last reference is released.
+	 */
+	struct ThemeCacheEntry
+	{
+		std::wstring m_themeClass;
+		size_t m_subApp = 0;
+		UINT m_dpi = USER_DEFAULT_SCREEN_DPI;
+		bool m_isDark = false;
+		HTHEME m_hTheme = nullptr;
+		size_t m_ref = 0;
+		bool m_isInvalid = false;
+	};
+
+	/// Process-wide theme handle cache.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<ThemeCacheEntry> m_entries;
+		std::atomic<std::uint32_t> m_generation{ 0 };
+		std::uint64_t m_systemTheme = 0;
+	} g_themeCache;
+
+	/// Interned "sub-app name|sub-ID list" pairs, window property stores index + 1.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<std::wstring> m_names;
+	} g_subAppNames;
+
+	/// Property value for windows whose theme variant is not known, their themes are not cached.
+	inline constexpr size_t kUncachedSubApp = static_cast<size_t>(-1);
+} // anonymous namespace
+
+/**
+ * @brief Retrieves window property name used for sub-app name set via `dmlib_subclass::setWindowTheme`.
+ *
+ * @return Property name as `MAKEINTATOM` value, or `nullptr` if the atom is not available.
+ */
+[[nodiscard]] static const wchar_t* getSubAppPropName() noexcept
+{
+	static const GlobalAtom atom{ L"DarkModeLibSubAppName" };
+	return atom.getName();
+}
+
+/**
+ * @brief Returns index of interned sub-app name and sub-ID list pair.
+ *
+ * @param[in] pszSubAppName Sub-app name, can be `nullptr`.
+ * @param[in] pszSubIdList  Sub-ID list, can be `nullptr`.
+ * @return Index + 1, `0` for default theme (both `nullptr`),
+ *         or `kUncachedSubApp` if the pair could not be stored.
+ */
+[[nodiscard]] static size_t internSubAppName(const wchar_t* pszSubAppName, const wchar_t* pszSubIdList) noexcept
+{
+	if (pszSubAppName == nullptr && pszSubIdList == nullptr)
+	{
+		return 0;
+	}
+
+	try
+	{
+		// null and empty strings are different variants, empty string disables theming
+		std::wstring name = (pszSubAppName == nullptr) ? L"<default>" : pszSubAppName;
+		name += L'|';
+		name += (pszSubIdList == nullptr) ? L"<default>" : pszSubIdList;
+
+		const std::lock_guard<std::mutex> lock(g_subAppNames.m_mutex);
+		auto& names = g_subAppNames.m_names;
+		const auto it = std::find(names.begin(), names.end(), name);
+		if (it != names.end())
+		{
+			return static_cast<size_t>(it - names.begin()) + 1;
+		}
+
+		names.push_back(std::move(name));
+		return names.size();
+	}
+	catch (...)
+	{
+		return kUncachedSubApp;
+	}
+}
+
+/**
+ * @brief Applies visual style variant to the window and records it for the theme cache.
+ *
+ * Replacement for `SetWindowTheme`. `OpenThemeData` returns different variants
+ * for the same theme class depending on the sub-app name and ID list,
+ * so the recorded pair is part of the theme cache key.
+ * Pair is recorded before calling `SetWindowTheme`, which sends `WM_THEMECHANGED`.
+ *
+ * @param[in] hWnd          Handle to the window.
+ * @param[in] pszSubAppName Sub-app name, e.g. `L"DarkMode_Explorer"`, `nullptr` for default.
+ * @param[in] pszSubIdList  Sub-ID list, `nullptr` for default.
+ * @return Result of `SetWindowTheme`.
+ *
+ * @note Variants applied directly via `SetWindowTheme` are not known to the library,
+ *       such windows share theme handles with default windows.
+ *
+ * @see dmlib_subclass::acquireTheme()
+ */
+HRESULT dmlib_subclass::setWindowTheme(HWND hWnd, const wchar_t* pszSubAppName, const wchar_t* pszSubIdList) noexcept
+{
+	if (const wchar_t* subAppProp = getSubAppPropName();
+		subAppProp != nullptr)
+	{
+		if (const size_t subApp = internSubAppName(pszSubAppName, pszSubIdList);
+			subApp == 0)
+		{
+			::RemovePropW(hWnd, subAppProp);
+		}
+		else if (::SetPropW(hWnd, subAppProp, reinterpret_cast<HANDLE>(subApp)) == FALSE)
+		{
+			::RemovePropW(hWnd, subAppProp);
+		}
+	}
+
+	return ::SetWindowTheme(hWnd, pszSubAppName, pszSubIdList);
+}
+
+/**
+ * @brief Computes serial identifying current system visual style.
+ *
+ * Combines theme file, color scheme and size names, whether visual
+ * styles are active, and high contrast state.
+ *
+ * @return Hash of the system visual style state.
+ */
+[[nodiscard]] static std::uint64_t getSystemThemeSerial() noexcept
+{
+	std::array<wchar_t, MAX_PATH> themeFile{};
+	std::array<wchar_t, MAX_PATH> colorName{};
+	std::array<wchar_t, MAX_PATH> sizeName{};
+	if (FAILED(::GetCurrentThemeName(themeFile.data(), MAX_PATH, colorName.data(), MAX_PATH, sizeName.data(), MAX_PATH)))
+	{
+		themeFile[0] = L'\0';
+		colorName[0] = L'\0';
+		sizeName[0] = L'\0';
+	}
+
+	HIGHCONTRASTW hc{};
+	hc.cbSize = sizeof(HIGHCONTRASTW);
+	const bool isHighContrast = ::SystemParametersInfoW(SPI_GETHIGHCONTRAST, sizeof(HIGHCONTRASTW), &hc, 0) == TRUE
+		&& (hc.dwFlags & HCF_HIGHCONTRASTON) == HCF_HIGHCONTRASTON;
+
+	return dmlib_subclass::StateHash{}
+		.add(::IsThemeActive() == TRUE)
+		.add(isHighContrast)
+		.addText(themeFile.data(), std::wcslen(themeFile.data()))
+		.addText(colorName.data(), std::wcslen(colorName.data()))
+		.addText(sizeName.data(), std::wcslen(sizeName.data()))
+		.value();
+}
+
+/**
+ * @brief Invalidates all cached theme handles.
+ *
+ * Entries are no longer returned by lookups and are closed when the last
+ * reference is released. `ThemeData` instances holding a handle from older
+ * generation release it and acquire new one on next `ensureTheme()`.
+ * Called on dark/light mode and system theme changes.
+ * Paint caches and shared checkbox state icons are invalidated too,
+ * they were rendered with old theme.
+ *
+ * @see dmlib_subclass::getThemeCacheGeneration()
+ * @see dmlib_subclass::invalidatePaintCaches()
+ */
+void dmlib_subclass::invalidateThemeCache() noexcept
+{
+	const std::uint64_t systemTheme = getSystemThemeSerial();
+	{
+		const std::lock_guard<std::mutex> lock(g_themeCache.m_mutex);
+		for (auto& entry : g_themeCache.m_entries)
+		{
+			entry.m_isInvalid = true;
+		}
+		g_themeCache.m_systemTheme = systemTheme;
+		g_themeCache.m_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+	dmlib_subclass::clearCheckboxIcons();
+	dmlib_subclass::invalidatePaintCaches();
+}
+
+/**
+ * @brief Invalidates cached theme handles if system visual style changed since last invalidation.
+ *
+ * `WM_THEMECHANGED` is sent to every top-level window on a system change,
+ * and to a window after `SetWindowTheme`. Comparing the system theme serial
+ * flushes the cache only once per system change, and not at all for
+ * per-window re-theming.
+ *
+ * @return `true` if the cache was invalidated.
+ *
+ * @see dmlib_subclass::invalidateThemeCache()
+ */
+bool dmlib_subclass::invalidateThemeCacheOnSystemChange() noexcept
+{
+	const std::uint64_t systemTheme = getSystemThemeSerial();
+	{
+		const std::lock_guard<std::mutex> lock(g_themeCache.m_mutex);
+		if (g_themeCache.m_systemTheme == systemTheme)
+		{
+			return false;
+		}
+	}
+	dmlib_subclass::invalidateThemeCache();
+	return true;
+}
+
+/**
+ * @brief Retrieves generation of the theme cache, incremented by `invalidateThemeCache()`.
+ *
+ * @return Current generation.
+ */
+std::uint32_t dmlib_subclass::getThemeCacheGeneration() noexcept
+{
+	return g_themeCache.m_generation.load(std::memory_order_relaxed);
+}
+
+/// Generation of paint caches, pictures recorded with older generation are not reused.
+static std::atomic<std::uint32_t> g_paintCacheGeneration{ 0 };
+
+/**
+ * @brief Invalidates pictures of all paint caches.
+ *
+ * Called on color, mode, and theme changes. Each `PaintCache` notices
+ * the new generation on next `blit()` and records the picture again.
+ *
+ * @see dmlib_subclass::PaintCache
+ */
+void dmlib_subclass::invalidatePaintCaches() noexcept
+{
+	g_paintCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves generation of paint caches, incremented by `invalidatePaintCaches()`.
+ *
+ * @return Current generation.
+ */
+std::uint32_t dmlib_subclass::getPaintCacheGeneration() noexcept
+{
+	return g_paintCacheGeneration.load(std::memory_order_relaxed);
+}
+
+namespace // anonymous
+{
+	/**
+	 * @class PaintCacheDC
+	 * @brief Per-thread memory DC shared by all paint caches.
+	 *
+	 * Paint caches own only their bitmaps, which are selected into this DC
+	 * for blitting or recording, so each control does not hold its own DC.
+	 * Only one bitmap can be selected at a time, nested painting is refused.
+	 */
+	class PaintCacheDC
+	{
+	public:
+		PaintCacheDC() = default;
+
+		PaintCacheDC(const PaintCacheDC&) = delete;
+		PaintCacheDC& operator=(const PaintCacheDC&) = delete;
+
+		PaintCacheDC(PaintCacheDC&&) = delete;
+		PaintCacheDC& operator=(PaintCacheDC&&) = delete;
+
+		~PaintCacheDC()
+		{
+			deselect();
+			dmlib_resource::deleteDC(m_hMemDC);
+		}
+
+		[[nodiscard]] HDC select(HDC hdc, HBITMAP hBmp) noexcept
+		{
+			if (m_isInUse || hBmp == nullptr)
+			{
+				return nullptr;
+			}
+
+			if (m_hMemDC == nullptr)
+			{
+				m_hMemDC = dmlib_resource::createCompatibleDC(hdc);
+				if (m_hMemDC == nullptr)
+				{
+					return nullptr;
+				}
+			}
+
+			const HGDIOBJ hPrevBmp = ::SelectObject(m_hMemDC, hBmp);
+			if (hPrevBmp == nullptr || hPrevBmp == HGDI_ERROR)
+			{
+				return nullptr;
+			}
+
+			m_holdBmp = hPrevBmp;
+			m_isInUse = true;
+			return m_hMemDC;
+		}
+
+		void deselect() noexcept
+		{
+			if (m_isInUse)
+			{
+				::SelectObject(m_hMemDC, m_holdBmp);
+				m_holdBmp = nullptr;
+				m_isInUse = false;
+			}
+		}
+
+	private:
+		HDC m_hMemDC = nullptr;
+		HGDIOBJ m_holdBmp = nullptr;
+		bool m_isInUse = false;
+	};
+
+	[[nodiscard]] PaintCacheDC& getPaintCacheDC() noexcept
+	{
+		thread_local PaintCacheDC paintCacheDC;
+		return paintCacheDC;
+	}
+} // anonymous namespace
+
+/**
+ * @brief Selects bitmap into the per-thread memory DC shared by paint caches.
+ *
+ * @param[in]   hdc     Target device context used to create compatible DC.
+ * @param[in]   hBmp    Bitmap of the paint cache.
+ * @return Memory device context with selected bitmap, or `nullptr` if the DC
+ *         is already in use, e.g. by nested painting, or could not be created.
+ *
+ * @see dmlib_subclass::deselectPaintCacheBitmap()
+ * @see dmlib_subclass::PaintCache
+ */
+HDC dmlib_subclass::selectPaintCacheBitmap(HDC hdc, HBITMAP hBmp) noexcept
+{
+	return getPaintCacheDC().select(hdc, hBmp);
+}
+
+/**
+ * @brief Deselects bitmap selected via `selectPaintCacheBitmap`.
+ *
+ * @see dmlib_subclass::selectPaintCacheBitmap()
+ */
+void dmlib_subclass::deselectPaintCacheBitmap() noexcept
+{
+	getPaintCacheDC().deselect();
+}
+
+/**
+ * @brief Retrieves shared theme handle for the theme class, window DPI, and current mode.
+ *
+ * Looks up the cache by (theme class, sub-app, DPI, dark/light) key and increments
+ * the reference count on hit. On miss opens the theme via `OpenThemeData` and stores it.
+ * Sub-app is the variant recorded by `dmlib_subclass::setWindowTheme` for the window.
+ * Windows with variant which could not be recorded get their own uncached handle.
+ *
+ * @param[in]   hWnd        Handle to the window, can be `nullptr`.
+ * @param[in]   themeClass  Theme class name.
+ * @return Theme handle, or `nullptr` on failure.
+ *
+ * @see dmlib_subclass::releaseTheme()
+ */
+HTHEME dmlib_subclass::acquireTheme(HWND hWnd, const wchar_t* themeClass)
+{
+	const UINT dpi = (hWnd != nullptr) ? dmlib_dpi::GetDpiForWindow(hWnd) : dmlib_dpi::GetDpiForSystem();
+	const bool isDark = DarkMode::isExperimentalActive();
+	const wchar_t* subAppProp = getSubAppPropName();
+	const auto subApp = (hWnd != nullptr && subAppProp != nullptr) ? reinterpret_cast<size_t>(::GetPropW(hWnd, subAppProp)) : 0;
+	if (subApp == kUncachedSubApp || (hWnd != nullptr && subAppProp == nullptr))
+	{
+		return dmlib_resource::openThemeData(hWnd, themeClass);
+	}
+
+	const std::lock_guard<std::mutex> lock(g_themeCache.m_mutex);
+	for (auto& entry : g_themeCache.m_entries)
+	{
+		if (!entry.m_isInvalid
+			&& entry.m_subApp == subApp
+			&& entry.m_dpi == dpi
+			&& entry.m_isDark == isDark
+			&& entry.m_themeClass == themeClass)
+		{
+			++entry.m_ref;
+			return entry.m_hTheme;
+		}
+	}
+
+	HTHEME hTheme = dmlib_resource::openThemeData(hWnd, themeClass);
+	if (hTheme != nullptr)
+	{
+		g_themeCache.m_entries.push_back(ThemeCacheEntry{ themeClass, subApp, dpi, isDark, hTheme, 1, false });
+	}
+	return hTheme;
+}
+
+/**
+ * @brief Releases shared theme handle acquired via `acquireTheme`.
+ *
+ * Decrements reference count and closes the handle when it drops to zero.
+ * With `invalidate` the entry is excluded from further lookups,
+ * so the first control handling theme or DPI change invalidates the handle
+ * and the other controls share the newly opened one.
+ *
+ * @param[in]   hTheme      Theme handle to release, no action if `nullptr`.
+ * @param[in]   invalidate  Whether to exclude the handle from further lookups.
+ *
+ * @see dmlib_subclass::acquireTheme()
+ */
+void dmlib_subclass::releaseTheme(HTHEME hTheme, bool invalidate) noexcept
+{
+	if (hTheme == nullptr)
+	{
+		return;
+	}
+
+	const std::lock_guard<std::mutex> lock(g_themeCache.m_mutex);
+	auto& entries = g_themeCache.m_entries;
+	auto it = std::find_if(entries.begin(), entries.end(), [hTheme](const ThemeCacheEntry& entry) {
+		return entry.m_hTheme == hTheme;
+	});
+
+	if (it == entries.end())
+	{
+		dmlib_resource::closeThemeData(hTheme);
+		return;
+	}
+
+	if (invalidate)
+	{
+		it->m_isInvalid = true;
+	}
+
+	if (it->m_ref > 0)
+	{
+		--it->m_ref;
+	}
+
+	if (it->m_ref == 0)
+	{
+		dmlib_resource::closeThemeData(it->m_hTheme);
+		entries.erase(it);
+	}
+}
+
+namespace // anonymous
+{
+	/**
+	 * @struct FontCacheEntry
+	 * @brief Shared font handle with its key and reference count.
+	 *
+	 * Members:
+	 * - `m_lf`: Logical font the handle was created from.
+	 * - `m_hash`: Hash of `m_lf`, used to skip full comparison.
+	 * - `m_dpi`: DPI the font was created for.
+	 * - `m_hFont`: Shared font handle.
+	 * - `m_ref`: Number of `FontData` instances holding the handle.
+	 * - `m_isInvalid`: Entry is no longer returned by lookups, deleted when last reference is released.
+	 */
+	struct FontCacheEntry
+	{
+		LOGFONTW m_lf{};
+		std::size_t m_hash = 0;
+		UINT m_dpi = USER_DEFAULT_SCREEN_DPI;
+		HFONT m_hFont = nullptr;
+		size_t m_ref = 0;
+		bool m_isInvalid = false;
+	};
+
+	/// Process-wide font handle cache.
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<FontCacheEntry> m_entries;
+	} g_fontCache;
+} // anonymous namespace
+
+/**
+ * @brief Computes FNV-1a hash of a logical font.
+ *
+ * Face name is hashed only up to the null terminator,
+ * so garbage after it does not produce different keys.
+ *
+ * @param[in] lf Logical font.
+ * @return Hash value.
+ */
+std::size_t dmlib_subclass::hashLogFont(const LOGFONTW& lf) noexcept
+{
+	static constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+	static constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+	std::uint64_t hash = kFnvOffset;
+	const auto* bytes = reinterpret_cast<const unsigned char*>(&lf);
+	for (size_t i = 0; i < offsetof(LOGFONTW, lfFaceName); ++i)
+	{
+		hash = (hash ^ bytes[i]) * kFnvPrime;
+	}
+
+	for (size_t i = 0; i < LF_FACESIZE && lf.lfFaceName[i] != L'\0'; ++i)
+	{
+		hash = (hash ^ static_cast<std::uint64_t>(lf.lfFaceName[i])) * kFnvPrime;
+	}
+	return static_cast<std::size_t>(hash);
+}
+
+/**
+ * @brief Checks if two logical fonts describe the same font.
+ *
+ * @param[in] lhs First logical font.
+ * @param[in] rhs Second logical font.
+ * @return `true` if all fields and face names match.
+ */
+bool dmlib_subclass::isSameLogFont(const LOGFONTW& lhs, const LOGFONTW& rhs) noexcept
+{
+	return std::memcmp(&lhs, &rhs, offsetof(LOGFONTW, lfFaceName)) == 0
+		&& std::wcsncmp(lhs.lfFaceName, rhs.lfFaceName, LF_FACESIZE) == 0;
+}
+
+/**
+ * @brief Retrieves shared font handle for the logical font and DPI.
+ *
+ * Looks up the cache by (logical font, DPI) key and increments the reference
+ * count on hit. On miss creates the font via `CreateFontIndirectW` and stores it.
+ *
+ * @param[in]   lf  Logical font, already scaled for `dpi`.
+ * @param[in]   dpi DPI the font is used for.
+ * @return Font handle, or `nullptr` on failure.
+ *
+ * @see dmlib_subclass::releaseFont()
+ */
+HFONT dmlib_subclass::acquireFont(const LOGFONTW& lf, UINT dpi)
+{
+	const std::size_t hash = hashLogFont(lf);
+
+	const std::lock_guard<std::mutex> lock(g_fontCache.m_mutex);
+	for (auto& entry : g_fontCache.m_entries)
+	{
+		if (!entry.m_isInvalid
+			&& entry.m_hash == hash
+			&& entry.m_dpi == dpi
+			&& isSameLogFont(entry.m_lf, lf))
+		{
+			++entry.m_ref;
+			return entry.m_hFont;
+		}
+	}
+
+	HFONT hFont = dmlib_resource::createFontIndirect(&lf);
+	if (hFont != nullptr)
+	{
+		g_fontCache.m_entries.push_back(FontCacheEntry{ lf, hash, dpi, hFont, 1, false });
+	}
+	return hFont;
+}
+
+/**
+ * @brief Releases shared font handle acquired via `acquireFont`.
+ *
+ * Decrements reference count and deletes the font when it drops to zero.
+ * With `invalidate` the entry is excluded from further lookups,
+ * same as with `releaseTheme()` on theme or DPI change.
+ *
+ * @param[in]   hFont       Font handle to release, no action if `nullptr`.
+ * @param[in]   invalidate  Whether to exclude the handle from further lookups.
+ *
+ * @see dmlib_subclass::acquireFont()
+ */
+void dmlib_subclass::releaseFont(HFONT hFont, bool invalidate) noexcept
+{
+	if (hFont == nullptr)
+	{
+		return;
+	}
+
+	const std::lock_guard<std::mutex> lock(g_fontCache.m_mutex);
+	auto& entries = g_fontCache.m_entries;
+	auto it = std::find_if(entries.begin(), entries.end(), [hFont](const FontCacheEntry& entry) {
+		return entry.m_hFont == hFont;
+	});
+
+	if (it == entries.end())
+	{
+		dmlib_resource::deleteObject(hFont);
+		return;
+	}
+
+	if (invalidate)
+	{
+		it->m_isInvalid = true;
+	}
+
+	if (it->m_ref > 0)
+	{
+		--it->m_ref;
+	}
+
+	if (it->m_ref == 0)
+	{
+		dmlib_resource::deleteObject(it->m_hFont);
+		entries.erase(it);
+	}
+}
+
+namespace // anonymous
+{
+	/**
+	 * @struct PooledBuffer
+	 * @brief Reusable back buffer of the per-thread buffer pool.
+	 */
+	struct PooledBuffer
+	{
+		HDC m_hMemDC = nullptr;
+		HBITMAP m_hMemBmp = nullptr;
+		HBITMAP m_holdBmp = nullptr;
+		SIZE m_szBuffer{};
+		bool m_isBorrowed = false;
+		bool m_isDIB = false;
+	};
+
+	/**
+	 * @class BufferPool
+	 * @brief Per-thread pool of back buffers, buffers grow to the largest requested size.
+	 *
+	 * Usually holds only one buffer, more are created only for nested painting.
+	 */
+	class BufferPool
+	{
+	public:
+		BufferPool() = default;
+
+		BufferPool(const BufferPool&) = delete;
+		BufferPool& operator=(const BufferPool&) = delete;
+
+		BufferPool(BufferPool&&) = delete;
+		BufferPool& operator=(BufferPool&&) = delete;
+
+		~BufferPool()
+		{
+			for (auto& buffer : m_buffers)
+			{
+				::SelectObject(buffer.m_hMemDC, buffer.m_holdBmp);
+				dmlib_resource::deleteObject(buffer.m_hMemBmp);
+				dmlib_resource::deleteDC(buffer.m_hMemDC);
+			}
+		}
+
+		[[nodiscard]] HDC borrow(HDC hdc, int width, int height)
+		{
+			auto it = std::find_if(m_buffers.begin(), m_buffers.end(), [](const PooledBuffer& buffer) {
+				return !buffer.m_isBorrowed;
+			});
+
+			if (it == m_buffers.end())
+			{
+				PooledBuffer buffer{};
+				buffer.m_hMemDC = dmlib_resource::createCompatibleDC(hdc);
+				if (buffer.m_hMemDC == nullptr)
+				{
+					return nullptr;
+				}
+				try
+				{
+					m_buffers.push_back(buffer);
+				}
+				catch (...)
+				{
+					dmlib_resource::deleteDC(buffer.m_hMemDC);
+					throw;
+				}
+				it = std::prev(m_buffers.end());
+			}
+
+			auto& buffer = *it;
+			// antialiased shapes are rasterized directly into DIB section pixels
+			const bool useDIB = dmlib_paint::isRasterEnabled();
+			if (buffer.m_hMemBmp == nullptr
+				|| buffer.m_szBuffer.cx < width
+				|| buffer.m_szBuffer.cy < height
+				|| buffer.m_isDIB != useDIB)
+			{
+				// grow geometrically, pool buffers are shared by controls of different sizes and never shrink
+				const int cx = (buffer.m_szBuffer.cx < width) ? dmlib_subclass::growBufferExtent(width) : buffer.m_szBuffer.cx;
+				const int cy = (buffer.m_szBuffer.cy < height) ? dmlib_subclass::growBufferExtent(height) : buffer.m_szBuffer.cy;
+				void* pBits = nullptr;
+				HBITMAP hNewBmp = useDIB
+					? dmlib_resource::createDIBSection32(hdc, cx, cy, &pBits)
+					: dmlib_resource::createCompatibleBitmap(hdc, cx, cy);
+				if (hNewBmp == nullptr)
+				{
+					return nullptr;
+				}
+
+				auto hPrevBmp = static_cast<HBITMAP>(::SelectObject(buffer.m_hMemDC, hNewBmp));
+				if (buffer.m_hMemBmp == nullptr)
+				{
+					buffer.m_holdBmp = hPrevBmp;
+				}
+				else
+				{
+					dmlib_resource::deleteObject(buffer.m_hMemBmp);
+				}
+				buffer.m_hMemBmp = hNewBmp;
+				buffer.m_szBuffer = { cx, cy };
+				buffer.m_isDIB = useDIB;
+				dmlib_resource::countRate(DarkMode::ResourceType::bufferReallocs);
+			}
+
+			buffer.m_isBorrowed = true;
+			return buffer.m_hMemDC;
+		}
+
+		void giveBack(HDC hMemDC) noexcept
+		{
+			for (auto& buffer : m_buffers)
+			{
+				if (buffer.m_hMemDC == hMemDC)
+				{
+					buffer.m_isBorrowed = false;
+					return;
+				}
+			}
+		}
+
+	private:
+		std::vector<PooledBuffer> m_buffers;
+	};
+
+	[[nodiscard]] BufferPool& getBufferPool() noexcept
+	{
+		thread_local BufferPool pool;
+		return pool;
+	}
+} // anonymous namespace
+
+/**
+ * @brief Borrows back buffer with at least requested size from the per-thread buffer pool.
+ *
+ * Buffer bitmap grows to the largest requested size and is kept for next paints,
+ * so controls do not hold their own bitmap between paints.
+ *
+ * @param[in]   hdc     Target device context used to create compatible DC and bitmap.
+ * @param[in]   width   Minimum buffer width.
+ * @param[in]   height  Minimum buffer height.
+ * @return Memory device context with selected buffer bitmap, or `nullptr` on failure.
+ *
+ * @see dmlib_subclass::returnBuffer()
+ * @see dmlib_subclass::BufferData
+ */
+HDC dmlib_subclass::borrowBuffer(HDC hdc, int width, int height) noexcept
+{
+	// called from paint routines, allocation failure must not escape through `WM_PAINT`
+	try
+	{
+		return getBufferPool().borrow(hdc, width, height);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+/**
+ * @brief Returns back buffer borrowed via `borrowBuffer` to the per-thread buffer pool.
+ *
+ * @param[in] hMemDC Memory device context returned by `borrowBuffer`.
+ *
+ * @see dmlib_subclass::borrowBuffer()
+ */
+void dmlib_subclass::returnBuffer(HDC hMemDC) noexcept
+{
+	getBufferPool().giveBack(hMemDC);
+}
+
+namespace // anonymous
+{
+	/// Minimum length of scratch text buffer, covers most control texts.
+	inline constexpr size_t kMinTextLen = MAX_PATH;
+
+	/**
+	 * @struct PooledText
+	 * @brief Reusable text buffer of the per-thread text pool.
+	 */
+	struct PooledText
+	{
+		std::unique_ptr<wchar_t[]> m_text;
+		size_t m_cch = 0;
+		bool m_isBorrowed = false;
+	};
+
+	/**
+	 * @class TextPool
+	 * @brief Per-thread pool of scratch text buffers, buffers grow to the longest requested text.
+	 *
+	 * Usually holds only one buffer, more are created only for nested painting.
+	 * Allocated bytes are counted as `ResourceType::textBytes`.
+	 */
+	class TextPool
+	{
+	public:
+		TextPool() = default;
+
+		TextPool(const TextPool&) = delete;
+		TextPool& operator=(const TextPool&) = delete;
+
+		TextPool(TextPool&&) = delete;
+		TextPool& operator=(TextPool&&) = delete;
+
+		~TextPool()
+		{
+			for (const auto& text : m_texts)
+			{
+				TextPool::countBytes(text.m_cch, false);
+			}
+		}
+
+		[[nodiscard]] wchar_t* borrow(size_t cch)
+		{
+			auto it = std::find_if(m_texts.begin(), m_texts.end(), [](const PooledText& text) {
+				return !text.m_isBorrowed;
+			});
+
+			if (it == m_texts.end())
+			{
+				m_texts.push_back(PooledText{});
+				it = std::prev(m_texts.end());
+			}
+
+			auto& text = *it;
+			if (text.m_cch < cch)
+			{
+				const size_t cchNew = std::max<size_t>({ cch, kMinTextLen, text.m_cch * 2 });
+				std::unique_ptr<wchar_t[]> newText(new (std::nothrow) wchar_t[cchNew]);
+				if (newText == nullptr)
+				{
+					return nullptr;
+				}
+
+				TextPool::countBytes(text.m_cch, false);
+				TextPool::countBytes(cchNew, true);
+				text.m_text = std::move(newText);
+				text.m_cch = cchNew;
+			}
+
+			text.m_text[0] = L'\0';
+			text.m_isBorrowed = true;
+			return text.m_text.get();
+		}
+
+		void giveBack(const wchar_t* pText) noexcept
+		{
+			for (auto& text : m_texts)
+			{
+				if (text.m_text.get() == pText)
+				{
+					text.m_isBorrowed = false;
+					return;
+				}
+			}
+		}
+
+	private:
+		static void countBytes(size_t cch, bool isAdded) noexcept
+		{
+			const auto bytes = static_cast<std::ptrdiff_t>(cch * sizeof(wchar_t));
+			dmlib_resource::add(DarkMode::ResourceType::textBytes, isAdded ? bytes : -bytes);
+		}
+
+		std::vector<PooledText> m_texts;
+	};
+
+	[[nodiscard]] TextPool& getTextPool() noexcept
+	{
+		thread_local TextPool pool;
+		return pool;
+	}
+} // anonymous namespace
+
+/**
+ * @brief Borrows text buffer with at least requested length from the per-thread text pool.
+ *
+ * Buffer grows to the longest requested text and is kept for next paints,
+ * so paint routines retrieve control texts without heap allocation.
+ *
+ * @param[in] cch Minimum buffer length in characters, including null terminator.
+ * @return Pointer to the buffer with empty string, or `nullptr` on failure.
+ *
+ * @see dmlib_subclass::returnText()
+ * @see dmlib_subclass::TextBuffer
+ */
+wchar_t* dmlib_subclass::borrowText(size_t cch) noexcept
+{
+	try
+	{
+		return getTextPool().borrow(cch);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+/**
+ * @brief Returns text buffer borrowed via `borrowText` to the per-thread text pool.
+ *
+ * @param[in] pText Pointer returned by `borrowText`.
+ *
+ * @see dmlib_subclass::borrowText()
+ */
+void dmlib_subclass::returnText(const wchar_t* pText) noexcept
+{
+	if (pText != nullptr)
+	{
+		getTextPool().giveBack(pText);
+	}
+}
@@ -16,9 +16,19 @@
 
 #include <uxtheme.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
+#include <vector>
+
+#include "DmlibBufferExtent.h"
+#include "DmlibMsgFilter.h"
+#include "DmlibPool.h"
+#include "DmlibResource.h"
+#include "DmlibStateHash.h"
 
 namespace dmlib_subclass
 {
@@ -30,8 +40,7 @@ namespace dmlib_subclass
 		button = 42,
 		groupbox,
 		upDown,
-		tabPaint,
-		tabUpDown,
+		tab,
 		customBorder,
 		comboBox,
 		comboBoxEx,
@@ -42,14 +51,79 @@ namespace dmlib_subclass
 		staticText,
 		ipAddress,
 		hotKey,
-		windowEraseBg,
-		windowCtlColor,
-		windowNotify,
-		windowMenuBar,
-		windowSettingChange,
-		taskDlg
+		window,
+		taskDlg,
+		deferredCtrl,
+		deferredContainer,
+		maxValue  ///< Sentinel value for internal validation (not intended for use).
 	};
 
+	/// Number of subclass IDs, used for live subclass counters.
+	inline constexpr size_t kSubclassIDCount =
+		static_cast<size_t>(SubclassID::maxValue) - static_cast<size_t>(SubclassID::button);
+
+	/// Increments live subclass counter for the subclass ID.
+	void incrementLiveCount(SubclassID subID) noexcept;
+	/// Decrements live subclass counter for the subclass ID.
+	void decrementLiveCount(UINT_PTR uIdSubclass) noexcept;
+	/// Retrieves number of currently installed subclasses with the subclass ID.
+	[[nodiscard]] size_t getLiveCount(SubclassID subID) noexcept;
+	/// Retrieves highest number of simultaneously installed subclasses with the subclass ID.
+	[[nodiscard]] size_t getPeakLiveCount(SubclassID subID) noexcept;
+
+	/// Records installed subclass and its reference data for the window.
+	[[nodiscard]] bool registerSubclass(HWND hWnd, SubclassID subID, DWORD_PTR dwRefData) noexcept;
+	/// Forgets removed subclass of the window.
+	void unregisterSubclass(HWND hWnd, UINT_PTR uIdSubclass) noexcept;
+	/// Checks if subclass with the subclass ID is installed on the window.
+	[[nodiscard]] bool isSubclassRegistered(HWND hWnd, SubclassID subID) noexcept;
+	/// Retrieves reference data of installed subclass, `0` if subclass is not installed.
+	[[nodiscard]] DWORD_PTR getSubclassRefData(HWND hWnd, SubclassID subID) noexcept;
+
+	/**
+	 * @brief Retrieves typed reference data of installed subclass.
+	 *
+	 * @tparam      T       Type of subclass reference data.
+	 * @param[in]   hWnd    Handle to the window.
+	 * @param[in]   subID   Subclass ID.
+	 * @return Pointer to reference data, or `nullptr` if subclass is not installed.
+	 */
+	template <typename T>
+	[[nodiscard]] inline T* getSubclassData(HWND hWnd, SubclassID subID) noexcept
+	{
+		return reinterpret_cast<T*>(dmlib_subclass::getSubclassRefData(hWnd, subID));
+	}
+
+	/**
+	 * @brief Sets window subclass and records it in the subclass registry.
+	 *
+	 * If the registry cannot be updated, the subclass is removed again,
+	 * so installed subclasses and the registry never disagree.
+	 * Reference data stays owned by the caller on failure.
+	 *
+	 * @param[in]   hWnd            Window handle.
+	 * @param[in]   subclassProc    Subclass procedure.
+	 * @param[in]   subID           Identifier for the subclass instance.
+	 * @param[in]   dwRefData       Reference data passed to `SetWindowSubclass`.
+	 * @return `true` if the subclass was installed and recorded.
+	 */
+	[[nodiscard]] inline bool installSubclass(HWND hWnd, SUBCLASSPROC subclassProc, SubclassID subID, DWORD_PTR dwRefData) noexcept
+	{
+		const auto subclassID = static_cast<UINT_PTR>(subID);
+		if (::SetWindowSubclass(hWnd, subclassProc, subclassID, dwRefData) == FALSE)
+		{
+			return false;
+		}
+
+		if (dmlib_subclass::registerSubclass(hWnd, subID, dwRefData))
+		{
+			return true;
+		}
+
+		::RemoveWindowSubclass(hWnd, subclassProc, subclassID);
+		return false;
+	}
+
 	/**
 	 * @brief Attaches a typed subclass procedure with custom data to a window.
 	 *
@@ -67,13 +141,12 @@ namespace dmlib_subclass
 	template <typename T, typename Param>
 	inline auto SetSubclass(HWND hWnd, SUBCLASSPROC subclassProc, SubclassID subID, const Param& param) -> int
 	{
-		if (const auto subclassID = static_cast<UINT_PTR>(subID);
-			::GetWindowSubclass(hWnd, subclassProc, subclassID, nullptr) == FALSE)
+		if (!dmlib_subclass::isSubclassRegistered(hWnd, subID))
 		{
 			if (auto pData = std::make_unique<T>(param);
-				::SetWindowSubclass(hWnd, subclassProc, subclassID, reinterpret_cast<DWORD_PTR>(pData.get())) == TRUE)
+				dmlib_subclass::installSubclass(hWnd, subclassProc, subID, reinterpret_cast<DWORD_PTR>(pData.get())))
 			{
-				pData.release();
+				static_cast<void>(pData.release()); // owned by subclass now
 				return TRUE;
 			}
 			return FALSE;
@@ -95,13 +168,12 @@ namespace dmlib_subclass
 	template <typename T>
 	inline auto SetSubclass(HWND hWnd, SUBCLASSPROC subclassProc, SubclassID subID) -> int
 	{
-		if (const auto subclassID = static_cast<UINT_PTR>(subID);
-			::GetWindowSubclass(hWnd, subclassProc, subclassID, nullptr) == FALSE)
+		if (!dmlib_subclass::isSubclassRegistered(hWnd, subID))
 		{
 			if (auto pData = std::make_unique<T>();
-				::SetWindowSubclass(hWnd, subclassProc, subclassID, reinterpret_cast<DWORD_PTR>(pData.get())) == TRUE)
+				dmlib_subclass::installSubclass(hWnd, subclassProc, subID, reinterpret_cast<DWORD_PTR>(pData.get())))
 			{
-				pData.release();
+				static_cast<void>(pData.release()); // owned by subclass now
 				return TRUE;
 			}
 			return FALSE;
@@ -121,10 +193,13 @@ namespace dmlib_subclass
 	 */
 	inline int SetSubclass(HWND hWnd, SUBCLASSPROC subclassProc, SubclassID subID) noexcept
 	{
-		if (const auto subclassID = static_cast<UINT_PTR>(subID);
-			::GetWindowSubclass(hWnd, subclassProc, subclassID, nullptr) == FALSE)
+		if (!dmlib_subclass::isSubclassRegistered(hWnd, subID))
 		{
-			return ::SetWindowSubclass(hWnd, subclassProc, subclassID, 0);
+			if (dmlib_subclass::installSubclass(hWnd, subclassProc, subID, 0))
+			{
+				return TRUE;
+			}
+			return FALSE;
 		}
 		return -1;
 	}
@@ -144,43 +219,91 @@ namespace dmlib_subclass
 	template <typename T = void>
 	inline auto RemoveSubclass(HWND hWnd, SUBCLASSPROC subclassProc, SubclassID subID) noexcept -> int
 	{
-		T* pData = nullptr;
-		if (const auto subclassID = static_cast<UINT_PTR>(subID);
-			::GetWindowSubclass(hWnd, subclassProc, subclassID, reinterpret_cast<DWORD_PTR*>(&pData)) == TRUE)
+		if (dmlib_subclass::isSubclassRegistered(hWnd, subID))
 		{
 			if constexpr (!std::is_void_v<T>)
 			{
-				if (pData != nullptr)
+				if (auto* pData = dmlib_subclass::getSubclassData<T>(hWnd, subID);
+					pData != nullptr)
 				{
 					std::unique_ptr<T> u_ptrData(pData);
 					u_ptrData.reset(nullptr);
 				}
 			}
-			return ::RemoveWindowSubclass(hWnd, subclassProc, subclassID);
+			if (const auto subclassID = static_cast<UINT_PTR>(subID);
+				::RemoveWindowSubclass(hWnd, subclassProc, subclassID) == TRUE)
+			{
+				dmlib_subclass::unregisterSubclass(hWnd, subclassID);
+				return TRUE;
+			}
+			return FALSE;
 		}
 		return -1;
 	}
 
+	/**
+	 * @brief Removes a subclass from within its own subclass procedure.
+	 *
+	 * Used mainly in `WM_NCDESTROY` handling, reference data must be deleted by the caller.
+	 *
+	 * @param[in]   hWnd            Window handle.
+	 * @param[in]   subclassProc    Subclass procedure.
+	 * @param[in]   uIdSubclass     Subclass identifier passed to the subclass procedure.
+	 * @return TRUE on success, FALSE on failure.
+	 */
+	inline BOOL RemoveSubclassOnNcDestroy(HWND hWnd, SUBCLASSPROC subclassProc, UINT_PTR uIdSubclass) noexcept
+	{
+		if (::RemoveWindowSubclass(hWnd, subclassProc, uIdSubclass) == TRUE)
+		{
+			dmlib_subclass::unregisterSubclass(hWnd, uIdSubclass);
+			return TRUE;
+		}
+		return FALSE;
+	}
+
+	/// Applies visual style variant to the window and records it for the theme cache.
+	HRESULT setWindowTheme(HWND hWnd, const wchar_t* pszSubAppName, const wchar_t* pszSubIdList) noexcept;
+	/// Invalidates all cached theme handles.
+	void invalidateThemeCache() noexcept;
+	/// Invalidates cached theme handles once per system visual style change.
+	bool invalidateThemeCacheOnSystemChange() noexcept;
+	/// Destroys shared checkbox state icons of list view and tree view controls.
+	void clearCheckboxIcons() noexcept;
+	/// Retrieves generation of the theme cache, incremented by `invalidateThemeCache()`.
+	[[nodiscard]] std::uint32_t getThemeCacheGeneration() noexcept;
+
+	/// Retrieves shared theme handle for the theme class, window variant, DPI, and current mode.
+	[[nodiscard]] HTHEME acquireTheme(HWND hWnd, const wchar_t* themeClass);
+	/// Releases shared theme handle acquired via `acquireTheme`.
+	void releaseTheme(HTHEME hTheme, bool invalidate) noexcept;
+
 	/**
 	 * @class ThemeData
-	 * @brief RAII-style wrapper for `HTHEME` handle tied to a specific theme class.
+	 * @brief RAII-style wrapper for shared `HTHEME` handle tied to a specific theme class.
 	 *
-	 * Prevents leaks by managing the lifecycle of a theme handle opened via `OpenThemeData()`.
-	 * Ensures handles are released properly in the destructor via `CloseThemeData()`.
+	 * Prevents leaks by managing the lifecycle of a theme handle acquired from
+	 * the process-wide theme cache via `acquireTheme()`.
+	 * Handles are shared between controls with the same theme class, variant, DPI, and mode,
+	 * and released properly in the destructor via `releaseTheme()`.
+	 * Handle from invalidated cache generation is replaced in `ensureTheme()`.
 	 *
 	 * Usage:
-	 * - Construct with a valid theme class name (e.g. `L"Button"`).
-	 * - Call `ensureTheme(HWND)` before drawing to open the theme handle.
+	 * - Construct with a valid theme class name literal (e.g. `L"Button"`).
+	 * - Call `ensureTheme(HWND)` before drawing to acquire the theme handle.
 	 * - Access the active handle via `getHTheme()`.
+	 * - Call `closeTheme()` on theme or DPI change, the shared handle is invalidated,
+	 *   so following `ensureTheme()` calls open a new handle only once.
 	 *
 	 * Copying and moving are explicitly disabled to preserve exclusive ownership.
+	 *
+	 * @note Theme class name is not copied, it must have static storage duration.
 	 */
-	class ThemeData
+	class ThemeData : public PoolAllocated<ThemeData>
 	{
 	public:
 		ThemeData() = delete;
 
-		explicit ThemeData(const std::wstring& themeClass) noexcept
+		explicit ThemeData(const wchar_t* themeClass) noexcept
 			: m_themeClass(themeClass)
 		{}
 
@@ -192,14 +315,22 @@ namespace dmlib_subclass
 
 		~ThemeData()
 		{
-			closeTheme();
+			dmlib_subclass::releaseTheme(m_hTheme, false);
 		}
 
 		bool ensureTheme(HWND hWnd) noexcept
 		{
-			if (m_hTheme == nullptr && !m_themeClass.empty())
+			const std::uint32_t generation = dmlib_subclass::getThemeCacheGeneration();
+			if (m_hTheme != nullptr && m_generation != generation)
+			{
+				dmlib_subclass::releaseTheme(m_hTheme, false);
+				m_hTheme = nullptr;
+			}
+
+			if (m_hTheme == nullptr && m_themeClass != nullptr && *m_themeClass != L'\0')
 			{
-				m_hTheme = ::OpenThemeData(hWnd, m_themeClass.c_str());
+				m_hTheme = dmlib_subclass::acquireTheme(hWnd, m_themeClass);
+				m_generation = generation;
 			}
 			return m_hTheme != nullptr;
 		}
@@ -208,7 +339,7 @@ namespace dmlib_subclass
 		{
 			if (m_hTheme != nullptr)
 			{
-				::CloseThemeData(m_hTheme);
+				dmlib_subclass::releaseTheme(m_hTheme, true);
 				m_hTheme = nullptr;
 			}
 		}
@@ -219,31 +350,52 @@ namespace dmlib_subclass
 		}
 
 	private:
-		const std::wstring m_themeClass;
+		const wchar_t* m_themeClass = nullptr;
 		HTHEME m_hTheme = nullptr;
+		std::uint32_t m_generation = 0;
 	};
 
+	/// Update areas up to this number of pixels are painted without back buffer.
+	inline constexpr LONG kMaxDirectPaintArea = 16 * 16;
+
+	/// Borrows back buffer with at least requested size from the per-thread buffer pool.
+	[[nodiscard]] HDC borrowBuffer(HDC hdc, int width, int height) noexcept;
+	/// Returns back buffer borrowed via `borrowBuffer` to the per-thread buffer pool.
+	void returnBuffer(HDC hMemDC) noexcept;
+
 	/**
 	 * @class BufferData
 	 * @brief RAII-style utility for double buffer technique.
 	 *
-	 * Allocates and resizes an offscreen buffer for flicker-free GDI drawing. When
-	 * `ensureBuffer()` is called with a target HDC and client rect, it creates or resizes
-	 * a memory device context and bitmap accordingly. Automatically releases resources
+	 * Provides an offscreen buffer for flicker-free GDI drawing. When `ensureBuffer()`
+	 * is called with a target HDC and buffer rect (usually update region), it either
+	 * borrows a buffer from the per-thread buffer pool (default), or creates or resizes
+	 * a per-control memory device context and bitmap.
+	 * Per-control bitmap is sized with hysteresis, see `getBufferExtent()`.
+	 * Pooled buffer for tiny rect is not borrowed at all, target HDC is used
+	 * directly instead, see `isDirect()`.
+	 * Borrowed buffer is returned via `endPaint()`, per-control buffer is released
 	 * via `releaseBuffer()` and destructor.
 	 *
 	 * Usage:
 	 * - Call `ensureBuffer()` before painting.
 	 * - Draw to `getHMemDC()`.
 	 * - BitBlt back to screen in WM_PAINT.
+	 * - Call `endPaint()` after painting.
 	 *
 	 * Copying and moving are explicitly disabled to preserve exclusive ownership.
+	 *
+	 * @note Per-control buffer should be used for controls which repaint often, e.g. animate.
 	 */
 	class BufferData
 	{
 	public:
 		BufferData() = default;
 
+		explicit BufferData(bool isPooled) noexcept
+			: m_isPooled(isPooled)
+		{}
+
 		BufferData(const BufferData&) = delete;
 		BufferData& operator=(const BufferData&) = delete;
 
@@ -255,29 +407,62 @@ namespace dmlib_subclass
 			releaseBuffer();
 		}
 
-		bool ensureBuffer(HDC hdc, const RECT& rcClient) noexcept
+		bool ensureBuffer(HDC hdc, const RECT& rcBuffer) noexcept
 		{
-			const int width = rcClient.right - rcClient.left;
-			const int height = rcClient.bottom - rcClient.top;
-			if (m_szBuffer.cx != width || m_szBuffer.cy != height)
+			const int width = rcBuffer.right - rcBuffer.left;
+			const int height = rcBuffer.bottom - rcBuffer.top;
+
+			if (m_isPooled)
+			{
+				if (m_hMemDC == nullptr)
+				{
+					m_isDirect = (static_cast<LONG>(width) * height) <= kMaxDirectPaintArea;
+					m_hMemDC = m_isDirect ? hdc : dmlib_subclass::borrowBuffer(hdc, width, height);
+				}
+				return m_hMemDC != nullptr;
+			}
+
+			const int cx = dmlib_subclass::getBufferExtent(m_szBuffer.cx, width);
+			const int cy = dmlib_subclass::getBufferExtent(m_szBuffer.cy, height);
+			if (m_szBuffer.cx != cx || m_szBuffer.cy != cy)
 			{
 				releaseBuffer();
-				m_hMemDC = ::CreateCompatibleDC(hdc);
-				m_hMemBmp = ::CreateCompatibleBitmap(hdc, width, height);
+				m_hMemDC = dmlib_resource::createCompatibleDC(hdc);
+				m_hMemBmp = dmlib_resource::createCompatibleBitmap(hdc, cx, cy);
 				m_holdBmp = static_cast<HBITMAP>(::SelectObject(m_hMemDC, m_hMemBmp));
-				m_szBuffer = { width, height };
+				m_szBuffer = { cx, cy };
+				dmlib_resource::countRate(DarkMode::ResourceType::bufferReallocs);
 			}
 
 			return m_hMemDC != nullptr && m_hMemBmp != nullptr;
 		}
 
+		void endPaint() noexcept
+		{
+			if (m_isPooled && m_hMemDC != nullptr)
+			{
+				if (!m_isDirect)
+				{
+					dmlib_subclass::returnBuffer(m_hMemDC);
+				}
+				m_hMemDC = nullptr;
+				m_isDirect = false;
+			}
+		}
+
 		void releaseBuffer() noexcept
 		{
+			if (m_isPooled)
+			{
+				endPaint();
+				return;
+			}
+
 			if (m_hMemDC != nullptr)
 			{
 				::SelectObject(m_hMemDC, m_holdBmp);
-				::DeleteObject(m_hMemBmp);
-				::DeleteDC(m_hMemDC);
+				dmlib_resource::deleteObject(m_hMemBmp);
+				dmlib_resource::deleteDC(m_hMemDC);
 
 				m_hMemDC = nullptr;
 				m_hMemBmp = nullptr;
@@ -291,13 +476,253 @@ namespace dmlib_subclass
 			return m_hMemDC;
 		}
 
+		/// `getHMemDC()` returns target HDC, content is painted without back buffer.
+		[[nodiscard]] bool isDirect() const noexcept
+		{
+			return m_isDirect;
+		}
+
 	private:
 		HDC m_hMemDC = nullptr;
 		HBITMAP m_hMemBmp = nullptr;
 		HBITMAP m_holdBmp = nullptr;
 		SIZE m_szBuffer{};
+		bool m_isPooled = true;
+		bool m_isDirect = false;
+	};
+
+	/// Invalidates pictures of all paint caches, e.g. after color or mode change.
+	void invalidatePaintCaches() noexcept;
+	/// Retrieves generation of paint caches, incremented by `invalidatePaintCaches()`.
+	[[nodiscard]] std::uint32_t getPaintCacheGeneration() noexcept;
+
+	/// Selects bitmap into the per-thread memory DC shared by paint caches.
+	[[nodiscard]] HDC selectPaintCacheBitmap(HDC hdc, HBITMAP hBmp) noexcept;
+	/// Deselects bitmap selected via `selectPaintCacheBitmap`.
+	void deselectPaintCacheBitmap() noexcept;
+
+	/// Maximum client area in pixels of controls using `PaintCache`.
+	inline constexpr LONG kMaxPaintCacheArea = 256 * 256;
+
+	/**
+	 * @class PaintCache
+	 * @brief Per-control bitmap with last painted picture keyed by `StateHash`.
+	 *
+	 * Used by small controls which repaint the same picture often,
+	 * e.g. dozens of check boxes on dialog activation. When the hash
+	 * of paint inputs matches, picture is only blitted, otherwise
+	 * paint is recorded into the cache bitmap via `beginRecord()`
+	 * and `endRecord()`. Pictures recorded before `invalidatePaintCaches()`
+	 * are not reused.
+	 *
+	 * Control owns only the bitmap, it is selected into the per-thread
+	 * memory DC shared by all paint caches while blitting or recording.
+	 *
+	 * Usage:
+	 * - Call `blit()`, done if it returns `true`.
+	 * - Otherwise paint into DC from `beginRecord()` if not `nullptr`,
+	 *   then call `endRecord()`.
+	 * - Paint directly to target DC if `beginRecord()` returns `nullptr`,
+	 *   e.g. when control is larger than `kMaxPaintCacheArea`
+	 *   or the shared DC is in use by nested painting.
+	 *
+	 * Copying and moving are explicitly disabled to preserve exclusive ownership.
+	 *
+	 * @see StateHash
+	 * @see dmlib_subclass::selectPaintCacheBitmap()
+	 */
+	class PaintCache
+	{
+	public:
+		PaintCache() = default;
+
+		PaintCache(const PaintCache&) = delete;
+		PaintCache& operator=(const PaintCache&) = delete;
+
+		PaintCache(PaintCache&&) = delete;
+		PaintCache& operator=(PaintCache&&) = delete;
+
+		~PaintCache()
+		{
+			releaseBitmap();
+		}
+
+		/// Hash must include client size, so equal hash guarantees same bitmap size.
+		[[nodiscard]] bool blit(HDC hdc, const RECT& rcClient, std::uint64_t hash) const noexcept
+		{
+			if (!m_isValid || m_hash != hash || m_generation != dmlib_subclass::getPaintCacheGeneration())
+			{
+				return false;
+			}
+
+			HDC hMemDC = dmlib_subclass::selectPaintCacheBitmap(hdc, m_hBmp);
+			if (hMemDC == nullptr)
+			{
+				return false;
+			}
+
+			const bool isBlitted = PaintCache::copy(hdc, rcClient, hMemDC);
+			dmlib_subclass::deselectPaintCacheBitmap();
+			return isBlitted;
+		}
+
+		[[nodiscard]] HDC beginRecord(HDC hdc, const RECT& rcClient) noexcept
+		{
+			m_isValid = false;
+
+			const LONG width = rcClient.right - rcClient.left;
+			const LONG height = rcClient.bottom - rcClient.top;
+			if (width <= 0 || height <= 0 || (width * height) > kMaxPaintCacheArea)
+			{
+				releaseBitmap();
+				return nullptr;
+			}
+
+			if (m_hBmp == nullptr || m_szBmp.cx != width || m_szBmp.cy != height)
+			{
+				releaseBitmap();
+				m_hBmp = dmlib_resource::createCompatibleBitmap(hdc, width, height);
+				if (m_hBmp == nullptr)
+				{
+					return nullptr;
+				}
+				m_szBmp = { width, height };
+			}
+
+			m_hRecordDC = dmlib_subclass::selectPaintCacheBitmap(hdc, m_hBmp);
+			return m_hRecordDC;
+		}
+
+		void endRecord(HDC hdc, const RECT& rcClient, std::uint64_t hash) noexcept
+		{
+			if (m_hRecordDC == nullptr)
+			{
+				return;
+			}
+
+			m_hash = hash;
+			m_generation = dmlib_subclass::getPaintCacheGeneration();
+			m_isValid = PaintCache::copy(hdc, rcClient, m_hRecordDC);
+			dmlib_subclass::deselectPaintCacheBitmap();
+			m_hRecordDC = nullptr;
+		}
+
+		void invalidate() noexcept
+		{
+			m_isValid = false;
+		}
+
+	private:
+		static bool copy(HDC hdc, const RECT& rcClient, HDC hMemDC) noexcept
+		{
+			return ::BitBlt(
+				hdc,
+				rcClient.left, rcClient.top,
+				rcClient.right - rcClient.left,
+				rcClient.bottom - rcClient.top,
+				hMemDC,
+				0, 0,
+				SRCCOPY
+			) == TRUE;
+		}
+
+		void releaseBitmap() noexcept
+		{
+			if (m_hBmp != nullptr)
+			{
+				dmlib_resource::deleteObject(m_hBmp);
+				m_hBmp = nullptr;
+				m_szBmp = { 0, 0 };
+			}
+			m_isValid = false;
+		}
+
+		HBITMAP m_hBmp = nullptr;
+		HDC m_hRecordDC = nullptr;
+		SIZE m_szBmp{};
+		std::uint64_t m_hash = 0;
+		std::uint32_t m_generation = 0;
+		bool m_isValid = false;
+	};
+
+	/// Borrows text buffer with at least requested length from the per-thread text pool.
+	[[nodiscard]] wchar_t* borrowText(size_t cch) noexcept;
+	/// Returns text buffer borrowed via `borrowText` to the per-thread text pool.
+	void returnText(const wchar_t* pText) noexcept;
+
+	/**
+	 * @class TextBuffer
+	 * @brief RAII-style scratch buffer for retrieving control texts while painting.
+	 *
+	 * Borrows a buffer from the per-thread text pool in the constructor
+	 * and returns it in the destructor, so steady-state painting does not
+	 * allocate memory for texts.
+	 *
+	 * Usage:
+	 * - Construct with required length including null terminator.
+	 * - Fill `data()` with `GetWindowTextW`, `SB_GETTEXT`, etc. up to `size()` characters.
+	 * - Draw text via `c_str()`.
+	 *
+	 * Copying and moving are explicitly disabled to preserve exclusive ownership.
+	 *
+	 * @note `size()` is 0 if the buffer could not be allocated.
+	 */
+	class TextBuffer
+	{
+	public:
+		TextBuffer() = delete;
+
+		explicit TextBuffer(size_t cch) noexcept
+			: m_text(dmlib_subclass::borrowText(cch))
+			, m_cch((m_text != nullptr) ? cch : 0)
+		{}
+
+		TextBuffer(const TextBuffer&) = delete;
+		TextBuffer& operator=(const TextBuffer&) = delete;
+
+		TextBuffer(TextBuffer&&) = delete;
+		TextBuffer& operator=(TextBuffer&&) = delete;
+
+		~TextBuffer()
+		{
+			dmlib_subclass::returnText(m_text);
+		}
+
+		[[nodiscard]] wchar_t* data() noexcept
+		{
+			return m_text;
+		}
+
+		[[nodiscard]] const wchar_t* c_str() const noexcept
+		{
+			return (m_text != nullptr) ? m_text : L"";
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_cch;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_text == nullptr || *m_text == L'\0';
+		}
+
+	private:
+		wchar_t* m_text = nullptr;
+		size_t m_cch = 0;
 	};
 
+	/// Computes FNV-1a hash of a logical font.
+	[[nodiscard]] std::size_t hashLogFont(const LOGFONTW& lf) noexcept;
+	/// Checks if two logical fonts describe the same font.
+	[[nodiscard]] bool isSameLogFont(const LOGFONTW& lhs, const LOGFONTW& rhs) noexcept;
+
+	/// Retrieves shared font handle for the logical font and DPI.
+	[[nodiscard]] HFONT acquireFont(const LOGFONTW& lf, UINT dpi);
+	/// Releases shared font handle acquired via `acquireFont`.
+	void releaseFont(HFONT hFont, bool invalidate) noexcept;
+
 	/**
 	 * @class FontData
 	 * @brief RAII-style wrapper for managing a GDI font (`HFONT`) resource.
@@ -307,8 +732,12 @@ namespace dmlib_subclass
 	 *
 	 * Usage:
 	 * - Use `setFont()` to assign a new font, deleting any previous one.
+	 * - Use `setSharedFont()` to assign a font from the process-wide font cache,
+	 *   fonts with the same logical font and DPI are shared between controls.
 	 * - `getFont()` provides access to the current `HFONT`.
 	 * - `hasFont()` checks if a valid font is currently held.
+	 * - Call `invalidateFont()` on theme or DPI change, the shared font is invalidated,
+	 *   so following `setSharedFont()` calls create a new font only once.
 	 *
 	 * Copying and moving are explicitly disabled to preserve exclusive ownership.
 	 */
@@ -338,6 +767,13 @@ namespace dmlib_subclass
 			m_hFont = newFont;
 		}
 
+		void setSharedFont(const LOGFONTW& lf, UINT dpi) noexcept
+		{
+			FontData::destroyFont();
+			m_hFont = dmlib_subclass::acquireFont(lf, dpi);
+			m_isShared = true;
+		}
+
 		[[nodiscard]] const HFONT& getFont() const noexcept
 		{
 			return m_hFont;
@@ -349,16 +785,35 @@ namespace dmlib_subclass
 		}
 
 		void destroyFont() noexcept
+		{
+			FontData::resetFont(false);
+		}
+
+		void invalidateFont() noexcept
+		{
+			FontData::resetFont(true);
+		}
+
+	private:
+		void resetFont(bool invalidate) noexcept
 		{
 			if (FontData::hasFont())
 			{
-				::DeleteObject(m_hFont);
+				if (m_isShared)
+				{
+					dmlib_subclass::releaseFont(m_hFont, invalidate);
+				}
+				else
+				{
+					dmlib_resource::deleteObject(m_hFont);
+				}
 				m_hFont = nullptr;
 			}
+			m_isShared = false;
 		}
 
-	private:
 		HFONT m_hFont = nullptr;
+		bool m_isShared = false;
 	};
 
 	/**
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -40,52 +41,34 @@ static constexpr int CP_DROPDOWNITEM = 9; // for some reason mingw use only enum
 #endif
 
 /**
- * @brief Draws a themed owner drawn checkbox, radio, or tri-state button (excluding push-like buttons).
+ * @brief Computes layout of checkbox, radio, or tri-state button.
  *
- * Internally used by @ref paintButton to draw visual elements such as checkbox glyphs
- * or radio indicators alongside styled text. Not used for buttons with `BS_PUSHLIKE`,
- * which require different handling and theming logic.
+ * - Derives alignment, word wrapping, and prefix visibility from style flags and UI state.
+ * - Places glyph box via `GetThemePartSize` and text via `GetThemeBackgroundContentRect`.
+ * - Measures text with `DT_CALCRECT` to place focus rectangle.
  *
- * - Retrieves themed or fallback font for consistent appearance.
- * - Handles alignment, word wrapping, and prefix visibility per style flags.
- * - Draws themed background and glyph using `DrawThemeBackground`.
- * - Uses themed text drawing and applies focus cue when needed.
+ * Font used for text drawing must be already selected into `hdc`.
  *
  * @param[in]   hWnd        Handle to the button control.
- * @param[in]   hdc         Device context for drawing.
+ * @param[in]   hdc         Device context with selected font.
  * @param[in]   hTheme      Active visual style theme handle.
  * @param[in]   iPartID     Part ID (`BP_CHECKBOX`, `BP_RADIOBUTTON`, etc.).
  * @param[in]   iStateID    State ID (`CBS_CHECKEDHOT`, `RBS_UNCHECKEDNORMAL`, etc.).
+ * @param[in]   text        Button text.
+ * @param[out]  layout      Computed layout.
  *
- * @see paintButton()
+ * @see renderButton()
  */
-static void renderButton(
+static void updateButtonLayout(
 	HWND hWnd,
 	HDC hdc,
 	HTHEME hTheme,
 	int iPartID,
-	int iStateID
+	int iStateID,
+	const wchar_t* text,
+	dmlib_subclass::ButtonLayout& layout
 ) noexcept
 {
-	// Font part
-
-	HFONT hFont = nullptr;
-	bool isFontCreated = false;
-	LOGFONT lf{};
-	if (SUCCEEDED(::GetThemeFont(hTheme, hdc, iPartID, iStateID, TMT_FONT, &lf)))
-	{
-		hFont = ::CreateFontIndirectW(&lf);
-		isFontCreated = true;
-	}
-
-	if (hFont == nullptr)
-	{
-		hFont = reinterpret_cast<HFONT>(::SendMessage(hWnd, WM_GETFONT, 0, 0));
-		isFontCreated = false;
-	}
-
-	const auto holdFont = dmlib_paint::GdiObject{ hdc, hFont, !isFontCreated };
-
 	// Style part
 
 	const auto nStyle = ::GetWindowLongPtr(hWnd, GWL_STYLE);
@@ -137,11 +120,6 @@ static void renderButton(
 	RECT rcClient{};
 	::GetClientRect(hWnd, &rcClient);
 
-	std::wstring buffer;
-	const auto bufferLen = static_cast<size_t>(::GetWindowTextLengthW(hWnd));
-	buffer.resize(bufferLen + 1, L'\0');
-	::GetWindowTextW(hWnd, buffer.data(), static_cast<int>(buffer.length()));
-
 	SIZE szBox{};
 	::GetThemePartSize(hTheme, hdc, iPartID, iStateID, nullptr, TS_DRAW, &szBox);
 
@@ -157,25 +135,246 @@ static void renderButton(
 	rcBackground.right = rcBackground.left + szBox.cx;
 	rcText.left = rcBackground.right + 3;
 
+	// Focus rect part
+
+	DTTOPTS dtto{};
+	dtto.dwSize = sizeof(DTTOPTS);
+	dtto.dwFlags = DTT_CALCRECT;
+
+	RECT rcCalc{ rcText };
+	::DrawThemeTextEx(hTheme, hdc, iPartID, iStateID, text, -1, dtFlags | DT_CALCRECT, &rcCalc, &dtto);
+
+	layout.m_rcBox = rcBackground;
+	layout.m_rcText = rcText;
+	layout.m_rcFocus = { rcCalc.left - 1, rcCalc.top, rcCalc.right + 1, rcCalc.bottom + 1 };
+	layout.m_dtFlags = dtFlags;
+	layout.m_uiState = uiState;
+	layout.m_isValid = true;
+}
+
+/**
+ * @brief Draws a themed owner drawn checkbox, radio, or tri-state button (excluding push-like buttons).
+ *
+ * Internally used by @ref paintButton to draw visual elements such as checkbox glyphs
+ * or radio indicators alongside styled text. Not used for buttons with `BS_PUSHLIKE`,
+ * which require different handling and theming logic.
+ *
+ * - Uses shared themed font from the font cache, or fallback font for consistent appearance.
+ * - Uses cached layout, recomputed via @ref updateButtonLayout only after invalidation.
+ * - Draws themed background and glyph using `DrawThemeBackground`.
+ * - Uses themed text drawing and applies focus cue when needed.
+ *
+ * @param[in]       hWnd        Handle to the button control.
+ * @param[in]       hdc         Device context for drawing.
+ * @param[in]       hTheme      Active visual style theme handle.
+ * @param[in,out]   buttonData  Button data with shared font and cached layout.
+ * @param[in]       iPartID     Part ID (`BP_CHECKBOX`, `BP_RADIOBUTTON`, etc.).
+ * @param[in]       iStateID    State ID (`CBS_CHECKEDHOT`, `RBS_UNCHECKEDNORMAL`, etc.).
+ * @param[in]       text        Button text retrieved by the caller.
+ *
+ * @see paintButton()
+ * @see updateButtonLayout()
+ */
+static void renderButton(
+	HWND hWnd,
+	HDC hdc,
+	HTHEME hTheme,
+	dmlib_subclass::ButtonData& buttonData,
+	int iPartID,
+	int iStateID,
+	const wchar_t* text
+) noexcept
+{
+	// Font part
+
+	auto& fontData = buttonData.m_fontData;
+	if (LOGFONT lf{};
+		!fontData.hasFont()
+		&& SUCCEEDED(::GetThemeFont(hTheme, hdc, iPartID, iStateID, TMT_FONT, &lf)))
+	{
+		fontData.setSharedFont(lf, dmlib_dpi::GetDpiForWindow(hWnd));
+	}
+
+	const auto holdFont = dmlib_paint::GdiObject{
+		hdc,
+		(fontData.hasFont()) ? fontData.getFont() : reinterpret_cast<HFONT>(::SendMessage(hWnd, WM_GETFONT, 0, 0)),
+		true
+	};
+
+	// Layout part
+
+	auto& layout = buttonData.m_layout;
+	if (!layout.m_isValid)
+	{
+		updateButtonLayout(hWnd, hdc, hTheme, iPartID, iStateID, text, layout);
+		buttonData.m_paintCache.invalidate(); // cached picture uses old layout
+	}
+
+	// Draw part
+
+	RECT rcClient{};
+	::GetClientRect(hWnd, &rcClient);
+
 	::DrawThemeParentBackground(hWnd, hdc, &rcClient);
-	::DrawThemeBackground(hTheme, hdc, iPartID, iStateID, &rcBackground, nullptr); // draw box
+	::DrawThemeBackground(hTheme, hdc, iPartID, iStateID, &layout.m_rcBox, nullptr); // draw box
 
 	DTTOPTS dtto{};
 	dtto.dwSize = sizeof(DTTOPTS);
 	dtto.dwFlags = DTT_TEXTCOLOR;
 	dtto.crText = (::IsWindowEnabled(hWnd) == FALSE) ? DarkMode::getDisabledTextColor() : DarkMode::getTextColor();
 
-	::DrawThemeTextEx(hTheme, hdc, iPartID, iStateID, buffer.c_str(), -1, dtFlags, &rcText, &dtto);
+	RECT rcText{ layout.m_rcText };
+	::DrawThemeTextEx(hTheme, hdc, iPartID, iStateID, text, -1, layout.m_dtFlags, &rcText, &dtto);
 
 	// Focus rect
 
 	const auto nState = static_cast<DWORD>(::SendMessage(hWnd, BM_GETSTATE, 0, 0));
-	if (((nState & BST_FOCUS) == BST_FOCUS) && ((uiState & UISF_HIDEFOCUS) != UISF_HIDEFOCUS))
+	if (((nState & BST_FOCUS) == BST_FOCUS) && ((layout.m_uiState & UISF_HIDEFOCUS) != UISF_HIDEFOCUS))
+	{
+		::DrawFocusRect(hdc, &layout.m_rcFocus);
+	}
+}
+
+/**
+ * @struct ParentBackground
+ * @brief Parent background inputs of cached button picture.
+ *
+ * Members:
+ * - `m_ptOrigin`: Position of the button in the parent client area.
+ * - `m_hBrush`: Brush returned by the parent for `WM_CTLCOLORSTATIC`.
+ * - `m_color`: Color of the brush, brush handles can be reused after deletion.
+ * - `m_isSolid`: Whether the brush is solid, only then picture can be cached.
+ */
+struct ParentBackground
+{
+	POINT m_ptOrigin{};
+	HBRUSH m_hBrush = nullptr;
+	COLORREF m_color = 0;
+	bool m_isSolid = false;
+};
+
+/**
+ * @brief Retrieves parent background inputs painted below the button by `DrawThemeParentBackground`.
+ *
+ * Device context state changed by the parent in `WM_CTLCOLORSTATIC` is restored.
+ *
+ * @param[in]   hWnd    Handle to the button control.
+ * @param[in]   hdc     Device context passed to the parent.
+ * @return Parent background inputs, `m_isSolid` is `false` if the brush is unknown or not solid.
+ */
+[[nodiscard]] static ParentBackground getParentBackground(HWND hWnd, HDC hdc) noexcept
+{
+	ParentBackground parentBg{};
+	HWND hParent = ::GetParent(hWnd);
+	if (hParent == nullptr)
+	{
+		return parentBg;
+	}
+
+	::MapWindowPoints(hWnd, hParent, &parentBg.m_ptOrigin, 1);
+
+	const int savedDC = ::SaveDC(hdc);
+	parentBg.m_hBrush = reinterpret_cast<HBRUSH>(::SendMessage(hParent, WM_CTLCOLORSTATIC, reinterpret_cast<WPARAM>(hdc), reinterpret_cast<LPARAM>(hWnd)));
+	if (savedDC != 0)
 	{
-		dtto.dwFlags |= DTT_CALCRECT;
-		::DrawThemeTextEx(hTheme, hdc, iPartID, iStateID, buffer.c_str(), -1, dtFlags | DT_CALCRECT, &rcText, &dtto);
-		const RECT rcFocus{ rcText.left - 1, rcText.top, rcText.right + 1, rcText.bottom + 1 };
-		::DrawFocusRect(hdc, &rcFocus);
+		::RestoreDC(hdc, savedDC);
+	}
+
+	if (LOGBRUSH lb{};
+		parentBg.m_hBrush != nullptr
+		&& ::GetObject(parentBg.m_hBrush, sizeof(LOGBRUSH), &lb) == sizeof(LOGBRUSH)
+		&& lb.lbStyle == BS_SOLID)
+	{
+		parentBg.m_color = lb.lbColor;
+		parentBg.m_isSolid = true;
+	}
+	return parentBg;
+}
+
+/**
+ * @brief Renders checkbox, radio, or tri-state button through the paint cache.
+ *
+ * Paint inputs (part and state IDs, size, DPI, theme, focus, text, colors,
+ * position in the parent, and parent background brush) are hashed.
+ * When the hash matches the last painted picture and the layout
+ * is still valid, picture is only blitted from @ref PaintCache.
+ * Otherwise button is rendered via @ref renderButton into the cache bitmap.
+ * Button is not cached if the parent background brush is not a solid brush,
+ * e.g. textured pattern brush.
+ *
+ * @param[in]       hWnd        Handle to the button control.
+ * @param[in]       hdc         Device context for drawing.
+ * @param[in]       hTheme      Active visual style theme handle.
+ * @param[in,out]   buttonData  Button data with cached layout and picture.
+ * @param[in]       iPartID     Part ID (`BP_CHECKBOX`, `BP_RADIOBUTTON`, etc.).
+ * @param[in]       iStateID    State ID (`CBS_CHECKEDHOT`, `RBS_UNCHECKEDNORMAL`, etc.).
+ *
+ * @note Parents painting background in `WM_ERASEBKGND` without the brush
+ *       returned for `WM_CTLCOLORSTATIC` are not detected.
+ *
+ * @see renderButton()
+ * @see dmlib_subclass::PaintCache
+ */
+static void renderButtonCached(
+	HWND hWnd,
+	HDC hdc,
+	HTHEME hTheme,
+	dmlib_subclass::ButtonData& buttonData,
+	int iPartID,
+	int iStateID
+) noexcept
+{
+	RECT rcClient{};
+	::GetClientRect(hWnd, &rcClient);
+
+	const auto textLen = static_cast<size_t>(::GetWindowTextLengthW(hWnd));
+	dmlib_subclass::TextBuffer text{ textLen + 1 };
+	const int copied = (text.size() > 0) ? ::GetWindowTextW(hWnd, text.data(), static_cast<int>(text.size())) : 0;
+
+	const ParentBackground parentBg = getParentBackground(hWnd, hdc);
+	if (!parentBg.m_isSolid)
+	{
+		renderButton(hWnd, hdc, hTheme, buttonData, iPartID, iStateID, text.c_str());
+		return;
+	}
+
+	const auto nState = static_cast<DWORD>(::SendMessage(hWnd, BM_GETSTATE, 0, 0));
+	const dmlib_subclass::ButtonPaintKey key{
+		iPartID,
+		iStateID,
+		static_cast<int>(rcClient.right),
+		static_cast<int>(rcClient.bottom),
+		dmlib_dpi::GetDpiForWindow(hWnd),
+		reinterpret_cast<std::uintptr_t>(hTheme),
+		(nState & BST_FOCUS) == BST_FOCUS,
+		::IsWindowEnabled(hWnd) == TRUE,
+		static_cast<std::uint32_t>(DarkMode::getTextColor()),
+		static_cast<std::uint32_t>(DarkMode::getDisabledTextColor()),
+		static_cast<std::uint32_t>(DarkMode::getDlgBackgroundColor()),
+		static_cast<int>(parentBg.m_ptOrigin.x),
+		static_cast<int>(parentBg.m_ptOrigin.y),
+		reinterpret_cast<std::uintptr_t>(parentBg.m_hBrush),
+		static_cast<std::uint32_t>(parentBg.m_color),
+		text.c_str(),
+		static_cast<size_t>(std::max(copied, 0))
+	};
+	const auto hash = dmlib_subclass::hashButtonPaintKey(key);
+
+	auto& paintCache = buttonData.m_paintCache;
+	if (buttonData.m_layout.m_isValid && paintCache.blit(hdc, rcClient, hash))
+	{
+		return;
+	}
+
+	if (HDC hMemDC = paintCache.beginRecord(hdc, rcClient);
+		hMemDC != nullptr)
+	{
+		renderButton(hWnd, hMemDC, hTheme, buttonData, iPartID, iStateID, text.c_str());
+		paintCache.endRecord(hdc, rcClient, hash);
+	}
+	else
+	{
+		renderButton(hWnd, hdc, hTheme, buttonData, iPartID, iStateID, text.c_str());
 	}
 }
 
@@ -188,7 +387,8 @@ static void renderButton(
  *
  * Paint logic:
  * - Uses buffered animation (if available) to smoothly transition between states.
- * - Falls back to direct drawing via @ref renderButton if animation is not used.
+ * - Without state transition draws via @ref renderButtonCached,
+ *   which blits last picture if paint inputs did not change.
  * - Internally updates the `buttonData.m_iStateID` to preserve the last rendered state.
  * - Not used for `BS_PUSHLIKE` buttons.
  *
@@ -197,6 +397,7 @@ static void renderButton(
  * @param[in,out]   buttonData  Theming and state info, including current theme and last state.
  *
  * @see renderButton()
+ * @see renderButtonCached()
  */
 static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonData) noexcept
 {
@@ -291,7 +492,7 @@ static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonDa
 
 	if (!dmlib_paint::isAnimationEnabled())
 	{
-		renderButton(hWnd, hdc, hTheme, iPartID, iStateID);
+		renderButtonCached(hWnd, hdc, hTheme, buttonData, iPartID, iStateID);
 		buttonData.m_iStateID = iStateID;
 		return;
 	}
@@ -301,6 +502,13 @@ static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonDa
 		return;
 	}
 
+	if (iStateID == buttonData.m_iStateID)
+	{
+		// no transition to animate
+		renderButtonCached(hWnd, hdc, hTheme, buttonData, iPartID, iStateID);
+		return;
+	}
+
 	// Animation part - hover transition
 
 	BP_ANIMATIONPARAMS animParams{};
@@ -314,6 +522,13 @@ static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonDa
 	RECT rcClient{};
 	::GetClientRect(hWnd, &rcClient);
 
+	const auto textLen = static_cast<size_t>(::GetWindowTextLengthW(hWnd));
+	dmlib_subclass::TextBuffer text{ textLen + 1 };
+	if (text.size() > 0)
+	{
+		::GetWindowTextW(hWnd, text.data(), static_cast<int>(text.size()));
+	}
+
 	HDC hdcFrom = nullptr;
 	HDC hdcTo = nullptr;
 	if (HANIMATIONBUFFER hbpAnimation = ::BeginBufferedAnimation(hWnd, hdc, &rcClient, BPBF_COMPATIBLEBITMAP, nullptr, &animParams, &hdcFrom, &hdcTo);
@@ -321,11 +536,11 @@ static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonDa
 	{
 		if (hdcFrom != nullptr)
 		{
-			renderButton(hWnd, hdcFrom, hTheme, iPartID, buttonData.m_iStateID);
+			renderButton(hWnd, hdcFrom, hTheme, buttonData, iPartID, buttonData.m_iStateID, text.c_str());
 		}
 		if (hdcTo != nullptr)
 		{
-			renderButton(hWnd, hdcTo, hTheme, iPartID, iStateID);
+			renderButton(hWnd, hdcTo, hTheme, buttonData, iPartID, iStateID, text.c_str());
 		}
 
 		buttonData.m_iStateID = iStateID;
@@ -333,7 +548,7 @@ static void paintButton(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonDa
 	}
 	else
 	{
-		renderButton(hWnd, hdc, hTheme, iPartID, iStateID);
+		renderButton(hWnd, hdc, hTheme, buttonData, iPartID, iStateID, text.c_str());
 		buttonData.m_iStateID = iStateID;
 	}
 }
@@ -362,6 +577,17 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_DESTROY, WM_ERASEBKGND, WM_PRINTCLIENT,
+		WM_PAINT, WM_SIZE, WM_ENABLE, WM_UPDATEUISTATE,
+		WM_SETTEXT, WM_SETFONT, WM_STYLECHANGED,
+		WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pButtonData = reinterpret_cast<ButtonData*>(dwRefData);
 	auto& themeData = pButtonData->m_themeData;
 
@@ -369,7 +595,7 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, ButtonSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, ButtonSubclass, uIdSubclass);
 			std::unique_ptr<ButtonData> u_u_ptrData(pButtonData);
 			u_u_ptrData.reset(nullptr);
 			break;
@@ -412,6 +638,9 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
 		case WM_DPICHANGED_AFTERPARENT:
 		{
 			themeData.closeTheme();
+			pButtonData->m_fontData.invalidateFont();
+			pButtonData->m_layout.m_isValid = false;
+			pButtonData->m_paintCache.invalidate();
 			if (pButtonData->m_isSizeSet)
 			{
 				if (SIZE szBtn{};
@@ -429,16 +658,33 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
 		case WM_THEMECHANGED:
 		{
 			themeData.closeTheme();
+			pButtonData->m_fontData.invalidateFont();
+			pButtonData->m_layout.m_isValid = false;
+			pButtonData->m_paintCache.invalidate();
 			break;
 		}
 
 		case WM_SIZE:
+		{
+			pButtonData->m_layout.m_isValid = false;
+			::BufferedPaintStopAllAnimations(hWnd);
+			break;
+		}
+
 		case WM_DESTROY:
 		{
 			::BufferedPaintStopAllAnimations(hWnd);
 			break;
 		}
 
+		case WM_SETTEXT:
+		case WM_SETFONT:
+		case WM_STYLECHANGED:
+		{
+			pButtonData->m_layout.m_isValid = false;
+			break;
+		}
+
 		case WM_ENABLE:
 		{
 			if (!DarkMode::isEnabled())
@@ -456,6 +702,7 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
 		{
 			if ((HIWORD(wParam) & (UISF_HIDEACCEL | UISF_HIDEFOCUS)) != 0)
 			{
+				pButtonData->m_layout.m_isValid = false;
 				::InvalidateRect(hWnd, nullptr, FALSE);
 			}
 			break;
@@ -478,23 +725,24 @@ LRESULT CALLBACK dmlib_subclass::ButtonSubclass(
  *
  * Paint logic:
  * - Determines current visual state (`GBS_DISABLED`, `GBS_NORMAL`).
- * - Retrieves themed font via `GetThemeFont` or falls back to dialog font.
+ * - Uses shared themed font from the font cache or falls back to dialog font.
  * - Measures caption text, computes layout and exclusion for frame clipping.
  * - Paints the outer rounded frame via @ref DarkMode::paintRoundFrameRect
  *   using `DarkMode::getEdgePen()`.
  * - Restores clip region and draws text using `DrawThemeTextEx` with custom colors.
  *
- * @param[in]   hWnd        Handle to the group box control.
- * @param[in]   hdc         Device context to draw into.
- * @param[in]   buttonData  Reference to the theming and state info (theme handle).
+ * @param[in]       hWnd        Handle to the group box control.
+ * @param[in]       hdc         Device context to draw into.
+ * @param[in,out]   buttonData  Reference to the theming and state info (theme handle, shared font).
  *
- * @note Ensures proper cleanup of temporary GDI objects (font, clip region).
+ * @note Ensures proper cleanup of temporary GDI objects (clip region).
  *
  * @see DarkMode::paintRoundFrameRect()
  */
-static void paintGroupbox(HWND hWnd, HDC hdc, const dmlib_subclass::ButtonData& buttonData) noexcept
+static void paintGroupbox(HWND hWnd, HDC hdc, dmlib_subclass::ButtonData& buttonData) noexcept
 {
 	const auto& hTheme = buttonData.m_themeData.getHTheme();
+	auto& fontData = buttonData.m_fontData;
 
 	// Style part
 
@@ -504,31 +752,26 @@ static void paintGroupbox(HWND hWnd, HDC hdc, const dmlib_subclass::ButtonData&
 
 	// Font part
 
-	bool isFontCreated = false;
-	HFONT hFont = nullptr;
-	LOGFONT lf{};
-	if (SUCCEEDED(::GetThemeFont(hTheme, hdc, iPartID, iStateID, TMT_FONT, &lf)))
-	{
-		hFont = ::CreateFontIndirectW(&lf);
-		isFontCreated = true;
-	}
-
-	if (hFont == nullptr)
+	if (LOGFONT lf{};
+		!fontData.hasFont()
+		&& SUCCEEDED(::GetThemeFont(hTheme, hdc, iPartID, iStateID, TMT_FONT, &lf)))
 	{
-		hFont = reinterpret_cast<HFONT>(::SendMessage(hWnd, WM_GETFONT, 0, 0));
-		isFontCreated = false;
+		fontData.setSharedFont(lf, dmlib_dpi::GetDpiForWindow(hWnd));
 	}
 
-	const auto holdFont = dmlib_paint::GdiObject{ hdc, hFont, !isFontCreated };
+	const auto holdFont = dmlib_paint::GdiObject{
+		hdc,
+		(fontData.hasFont()) ? fontData.getFont() : reinterpret_cast<HFONT>(::SendMessage(hWnd, WM_GETFONT, 0, 0)),
+		true
+	};
 
 	// Text rectangle part
 
-	std::wstring buffer;
 	const auto bufferLen = static_cast<size_t>(::GetWindowTextLengthW(hWnd));
+	auto buffer = dmlib_subclass::TextBuffer{ bufferLen + 1 };
 	if (bufferLen > 0)
 	{
-		buffer.resize(bufferLen + 1, L'\0');
-		::GetWindowTextW(hWnd, buffer.data(), static_cast<int>(buffer.length()));
+		::GetWindowTextW(hWnd, buffer.data(), static_cast<int>(buffer.size()));
 	}
 
 	const auto nStyle = ::GetWindowLongPtr(hWnd, GWL_STYLE);
@@ -616,6 +859,15 @@ LRESULT CALLBACK dmlib_subclass::GroupboxSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PRINTCLIENT, WM_PAINT,
+		WM_ENABLE, WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pButtonData = reinterpret_cast<ButtonData*>(dwRefData);
 	auto& themeData = pButtonData->m_themeData;
 
@@ -623,7 +875,7 @@ LRESULT CALLBACK dmlib_subclass::GroupboxSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, GroupboxSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, GroupboxSubclass, uIdSubclass);
 			std::unique_ptr<ButtonData> u_ptrData(pButtonData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -666,12 +918,14 @@ LRESULT CALLBACK dmlib_subclass::GroupboxSubclass(
 		case WM_DPICHANGED_AFTERPARENT:
 		{
 			themeData.closeTheme();
+			pButtonData->m_fontData.invalidateFont();
 			return 0;
 		}
 
 		case WM_THEMECHANGED:
 		{
 			themeData.closeTheme();
+			pButtonData->m_fontData.invalidateFont();
 			break;
 		}
 
@@ -902,8 +1156,8 @@ static void paintArrow(
 	}
 
 	const COLORREF clrSelected = getColorFromState(isDisabled, isHot);
-	const auto hBrush = dmlib_paint::GdiObject{ hdc, ::CreateSolidBrush(clrSelected) };
-	const auto hPen = dmlib_paint::GdiObject{ hdc, ::CreatePen(PS_SOLID, 1, clrSelected) };
+	const auto hBrush = dmlib_paint::GdiObject{ hdc, dmlib_resource::createSolidBrush(clrSelected) };
+	const auto hPen = dmlib_paint::GdiObject{ hdc, dmlib_resource::createPen(PS_SOLID, 1, clrSelected) };
 
 	::Polygon(hdc, ptsArrow.data(), static_cast<int>(ptsArrow.size()));
 }
@@ -925,6 +1179,7 @@ static void paintArrow(
  * @param[in,out]   upDownData  Reference to layout and state information (segments, orientation, corner radius).
  *
  * @see UpDownData
+ * @see setUpDownState()
  */
 static void paintUpDown(HWND hWnd, HDC hdc, dmlib_subclass::UpDownData& upDownData) noexcept
 {
@@ -938,24 +1193,25 @@ static void paintUpDown(HWND hWnd, HDC hdc, dmlib_subclass::UpDownData& upDownDa
 	::FillRect(hdc, &upDownData.m_rcClient, DarkMode::getDlgBackgroundBrush());
 	::SetBkMode(hdc, TRANSPARENT);
 
-	POINT ptCursor{};
-	::GetCursorPos(&ptCursor);
-	::ScreenToClient(hWnd, &ptCursor);
-
-	const bool isHotPrev = ::PtInRect(&upDownData.m_rcPrev, ptCursor) == TRUE;
-	const bool isHotNext = ::PtInRect(&upDownData.m_rcNext, ptCursor) == TRUE;
-
-	upDownData.m_wasHotNext = !isHotPrev && (::PtInRect(&upDownData.m_rcClient, ptCursor) == TRUE);
+	using dmlib_subclass::UpDownPart;
+	const bool isPressedPrev = upDownData.m_pressedPart == UpDownPart::prev;
+	const bool isPressedNext = upDownData.m_pressedPart == UpDownPart::next;
+	const bool isHotPrev = isPressedPrev || upDownData.m_hotPart == UpDownPart::prev;
+	const bool isHotNext = isPressedNext || upDownData.m_hotPart == UpDownPart::next;
 
 	if (hasTheme && DarkMode::isAtLeastWindows11() && dmlib_subclass::isThemePrefered())
 	{
 		// all 4 variants of up-down control buttons have enums with same values
-		auto getStateId = [&isDisabled](bool isHot) noexcept
+		auto getStateId = [&isDisabled](bool isHot, bool isPressed) noexcept
 		{
 			if (isDisabled)
 			{
 				return UPS_DISABLED;
 			}
+			if (isPressed)
+			{
+				return UPS_PRESSED;
+			}
 			if (isHot)
 			{
 				return UPS_HOT;
@@ -963,8 +1219,8 @@ static void paintUpDown(HWND hWnd, HDC hdc, dmlib_subclass::UpDownData& upDownDa
 			return UPS_NORMAL;
 		};
 
-		const int stateIdPrev = getStateId(isHotPrev);
-		const int stateIdNext = getStateId(isHotNext);
+		const int stateIdPrev = getStateId(isHotPrev, isPressedPrev);
+		const int stateIdNext = getStateId(isHotNext, isPressedNext);
 
 		RECT rcPrev{ upDownData.m_rcPrev };
 		RECT rcNext{ upDownData.m_rcNext };
@@ -1005,17 +1261,73 @@ static void paintUpDown(HWND hWnd, HDC hdc, dmlib_subclass::UpDownData& upDownDa
 			static constexpr UINT dtFlags = DT_NOPREFIX | DT_CENTER | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP;
 			const LONG offset = isHorz ? 1 : 0;
 
-			RECT rcTextPrev{ upDownData.m_rcPrev.left, upDownData.m_rcPrev.top, upDownData.m_rcPrev.right, upDownData.m_rcPrev.bottom - offset };
-			::SetTextColor(hdc, getColorFromState(isDisabled, isHotPrev));
-			::DrawText(hdc, isHorz ? dmlib_glyph::kArrowLeft : dmlib_glyph::kArrowUp, -1, &rcTextPrev, dtFlags);
+			const RECT rcTextPrev{ upDownData.m_rcPrev.left, upDownData.m_rcPrev.top, upDownData.m_rcPrev.right, upDownData.m_rcPrev.bottom - offset };
+			dmlib_glyph::drawGlyph(hdc, isHorz ? dmlib_glyph::kArrowLeft : dmlib_glyph::kArrowUp, rcTextPrev, dtFlags, getColorFromState(isDisabled, isHotPrev));
 
-			RECT rcTextNext{ upDownData.m_rcNext.left + offset, upDownData.m_rcNext.top, upDownData.m_rcNext.right, upDownData.m_rcNext.bottom - offset };
-			::SetTextColor(hdc, getColorFromState(isDisabled, isHotNext));
-			::DrawText(hdc, isHorz ? dmlib_glyph::kArrowRight : dmlib_glyph::kArrowDown, -1, &rcTextNext, dtFlags);
+			const RECT rcTextNext{ upDownData.m_rcNext.left + offset, upDownData.m_rcNext.top, upDownData.m_rcNext.right, upDownData.m_rcNext.bottom - offset };
+			dmlib_glyph::drawGlyph(hdc, isHorz ? dmlib_glyph::kArrowRight : dmlib_glyph::kArrowDown, rcTextNext, dtFlags, getColorFromState(isDisabled, isHotNext));
 		}
 	}
 }
 
+/**
+ * @brief Invalidates single arrow button of up-down control.
+ *
+ * For vertical control the invalidated band spans the whole client width,
+ * because paint rectangle is shifted by the vertical offset in `WM_PAINT`.
+ *
+ * @param[in] hWnd          Handle to the up-down control.
+ * @param[in] upDownData    Reference to layout information.
+ * @param[in] part          Arrow button to invalidate, no action for `UpDownPart::none`.
+ */
+static void invalidateUpDownPart(HWND hWnd, const dmlib_subclass::UpDownData& upDownData, dmlib_subclass::UpDownPart part) noexcept
+{
+	if (part == dmlib_subclass::UpDownPart::none)
+	{
+		return;
+	}
+
+	RECT rcPart{ (part == dmlib_subclass::UpDownPart::prev) ? upDownData.m_rcPrev : upDownData.m_rcNext };
+	if (!upDownData.m_isHorizontal)
+	{
+		rcPart.left = upDownData.m_rcClient.left;
+	}
+	::InvalidateRect(hWnd, &rcPart, FALSE);
+}
+
+/**
+ * @brief Updates hot and pressed arrow buttons of up-down control.
+ *
+ * Invalidates only arrow buttons whose hot or pressed state changed,
+ * no repaint is requested when the state is unchanged.
+ *
+ * @param[in]       hWnd        Handle to the up-down control.
+ * @param[in,out]   upDownData  Reference to layout and state information.
+ * @param[in]       hotPart     New hovered arrow button.
+ * @param[in]       pressedPart New pressed arrow button.
+ */
+static void setUpDownState(
+	HWND hWnd,
+	dmlib_subclass::UpDownData& upDownData,
+	dmlib_subclass::UpDownPart hotPart,
+	dmlib_subclass::UpDownPart pressedPart
+) noexcept
+{
+	using dmlib_subclass::UpDownPart;
+	for (const auto part : { UpDownPart::prev, UpDownPart::next })
+	{
+		const bool wasHot = upDownData.m_hotPart == part;
+		const bool wasPressed = upDownData.m_pressedPart == part;
+		if (wasHot != (hotPart == part) || wasPressed != (pressedPart == part))
+		{
+			invalidateUpDownPart(hWnd, upDownData, part);
+		}
+	}
+
+	upDownData.m_hotPart = hotPart;
+	upDownData.m_pressedPart = pressedPart;
+}
+
 /**
  * @brief Window subclass procedure for owner drawn up-down (spinner) control.
  *
@@ -1040,6 +1352,16 @@ LRESULT CALLBACK dmlib_subclass::UpDownSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_MOUSEMOVE,
+		WM_MOUSELEAVE, WM_LBUTTONDOWN, WM_LBUTTONDBLCLK, WM_LBUTTONUP,
+		WM_CAPTURECHANGED, WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pUpDownData = reinterpret_cast<UpDownData*>(dwRefData);
 	auto& themeData = pUpDownData->m_themeData;
 	const auto& hMemDC = pUpDownData->m_bufferData.getHMemDC();
@@ -1048,7 +1370,7 @@ LRESULT CALLBACK dmlib_subclass::UpDownSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, UpDownSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, UpDownSubclass, uIdSubclass);
 			std::unique_ptr<UpDownData> u_ptrData(pUpDownData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -1125,25 +1447,56 @@ LRESULT CALLBACK dmlib_subclass::UpDownSubclass(
 				break;
 			}
 
-			if (pUpDownData->m_wasHotNext)
+			const POINT pt{ GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+			setUpDownState(hWnd, *pUpDownData, pUpDownData->hitTest(pt), pUpDownData->m_pressedPart);
+
+			if (!pUpDownData->m_isTrackingMouse)
 			{
-				pUpDownData->m_wasHotNext = false;
-				::RedrawWindow(hWnd, nullptr, nullptr, RDW_INVALIDATE);
+				TRACKMOUSEEVENT tme{};
+				tme.cbSize = sizeof(TRACKMOUSEEVENT);
+				tme.dwFlags = TME_LEAVE;
+				tme.hwndTrack = hWnd;
+				pUpDownData->m_isTrackingMouse = ::TrackMouseEvent(&tme) == TRUE;
 			}
-
 			break;
 		}
 
 		case WM_MOUSELEAVE:
 		{
+			pUpDownData->m_isTrackingMouse = false;
+
 			if (!DarkMode::isEnabled())
 			{
 				break;
 			}
 
-			pUpDownData->m_wasHotNext = false;
-			::RedrawWindow(hWnd, nullptr, nullptr, RDW_INVALIDATE);
+			setUpDownState(hWnd, *pUpDownData, UpDownPart::none, pUpDownData->m_pressedPart);
+			break;
+		}
 
+		case WM_LBUTTONDOWN:
+		case WM_LBUTTONDBLCLK:
+		{
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			const POINT pt{ GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+			const auto part = pUpDownData->hitTest(pt);
+			setUpDownState(hWnd, *pUpDownData, part, part);
+			break;
+		}
+
+		case WM_LBUTTONUP:
+		case WM_CAPTURECHANGED:
+		{
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			setUpDownState(hWnd, *pUpDownData, pUpDownData->m_hotPart, UpDownPart::none);
 			break;
 		}
 
@@ -1155,6 +1508,90 @@ LRESULT CALLBACK dmlib_subclass::UpDownSubclass(
 	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 }
 
+/**
+ * @brief Retrieves rectangles of all tab items into the item cache.
+ *
+ * @param[in]       hWnd    Handle to the tab control.
+ * @param[in,out]   tabData Reference to the control's data with item cache.
+ * @return `false` if the item cache could not be allocated.
+ *
+ * @see TabItem
+ */
+static bool updateTabLayout(HWND hWnd, dmlib_subclass::TabData& tabData) noexcept
+{
+	tabData.m_iSelTab = TabCtrl_GetCurSel(hWnd);
+
+	const auto nTabs = TabCtrl_GetItemCount(hWnd);
+	auto& items = tabData.m_items;
+	try
+	{
+		items.resize(static_cast<size_t>(std::max<int>(nTabs, 0)));
+	}
+	catch (...)
+	{
+		items.clear();
+		tabData.m_isLayoutValid = false;
+		return false;
+	}
+
+	for (int i = 0; i < nTabs; ++i)
+	{
+		TabCtrl_GetItemRect(hWnd, i, &items[static_cast<size_t>(i)].m_rcItem);
+	}
+
+	tabData.m_isLayoutValid = true;
+	return true;
+}
+
+/**
+ * @brief Retrieves label, image, and state of single tab item into the item cache.
+ *
+ * Label is retrieved into `label` and then copied to the cache. If the copy
+ * cannot be allocated, label stays invalid and retrieved text is painted directly.
+ *
+ * @param[in]       hWnd    Handle to the tab control.
+ * @param[in]       i       Index of the tab item.
+ * @param[in,out]   item    Cached tab item to update.
+ * @param[out]      label   Scratch buffer receiving the label.
+ * @return Label to paint, valid until `label` or the tab item changes.
+ */
+static const wchar_t* updateTabItemLabel(HWND hWnd, int i, dmlib_subclass::TabItem& item, dmlib_subclass::TextBuffer& label) noexcept
+{
+	if (label.size() == 0)
+	{
+		return L"";
+	}
+
+	label.data()[0] = L'\0';
+	TCITEM tci{};
+	tci.mask = TCIF_TEXT | TCIF_IMAGE | TCIF_STATE;
+	tci.dwStateMask = TCIS_HIGHLIGHTED;
+	tci.pszText = label.data();
+	tci.cchTextMax = static_cast<int>(label.size());
+
+	const wchar_t* pszText = L"";
+	if (TabCtrl_GetItem(hWnd, i, &tci) == TRUE)
+	{
+		// control can return pointer to its own buffer
+		pszText = (tci.pszText != nullptr) ? tci.pszText : L"";
+		item.m_iImage = tci.iImage;
+		item.m_dwState = tci.dwState;
+	}
+
+	try
+	{
+		item.m_label.assign(pszText);
+		item.m_isLabelValid = true;
+		return item.m_label.c_str();
+	}
+	catch (...)
+	{
+		item.m_label.clear();
+		item.m_isLabelValid = false;
+		return pszText;
+	}
+}
+
 /**
  * @brief Paints a tab item in a tab control.
  *
@@ -1164,45 +1601,40 @@ LRESULT CALLBACK dmlib_subclass::UpDownSubclass(
  *
  * @param[in]   hdc             Handle to the device context used for painting.
  * @param[in]   hWnd            Handle to the parent tab control window.
- * @param[in]   rcItem          Rectangle defining the area of the tab item.
+ * @param[in]   item            Cached tab item with rectangle, image, and state.
+ * @param[in]   label           Text of the tab item.
+ * @param[in]   hImageList      Image list of the tab control, can be `nullptr`.
  * @param[in]   i               Index of the tab item being painted.
  * @param[in]   iSelTab         Index of the currently selected tab.
  * @param[in]   nTabs           Total number of tabs in the tab control.
- * @param[in]   ptCursor        Point representing the current cursor position.
+ * @param[in]   isHot           Whether the tab item is hovered.
  */
 static void paintTabItem(
 	HDC hdc,
 	HWND hWnd,
-	RECT& rcItem,
+	const dmlib_subclass::TabItem& item,
+	const wchar_t* label,
+	HIMAGELIST hImageList,
 	int i,
 	int iSelTab,
 	int nTabs,
-	const POINT& ptCursor
+	bool isHot
 ) noexcept
 {
+	RECT rcItem{ item.m_rcItem };
 	RECT rcFrame{ rcItem };
 
-	const bool isHot = ::PtInRect(&rcItem, ptCursor) == TRUE;
 	const bool isSelectedTab = (i == iSelTab);
 
 	::InflateRect(&rcItem, -1, -1);
 	rcItem.right += 1;
 
-	std::wstring label(MAX_PATH, L'\0');
-	TCITEM tci{};
-	tci.mask = TCIF_TEXT | TCIF_IMAGE | TCIF_STATE;
-	tci.dwStateMask = TCIS_HIGHLIGHTED;
-	tci.pszText = label.data();
-	tci.cchTextMax = MAX_PATH - 1;
-
-	TabCtrl_GetItem(hWnd, i, &tci);
-
 	RECT rcText{ rcItem };
 
 	if (const auto nStyle = ::GetWindowLongPtr(hWnd, GWL_STYLE);
 		(nStyle & TCS_BUTTONS) == TCS_BUTTONS) // is button
 	{
-		const bool isHighlighted = (tci.dwState & TCIS_HIGHLIGHTED) == TCIS_HIGHLIGHTED;
+		const bool isHighlighted = (item.m_dwState & TCIS_HIGHLIGHTED) == TCIS_HIGHLIGHTED;
 		::FillRect(hdc, &rcItem, isHighlighted ? DarkMode::getHotBackgroundBrush() : DarkMode::getDlgBackgroundBrush());
 		::SetTextColor(hdc, isHighlighted ? DarkMode::getLinkTextColor() : DarkMode::getDarkerTextColor());
 	}
@@ -1229,18 +1661,17 @@ static void paintTabItem(
 	}
 
 	// Draw image
-	if (tci.iImage != -1)
+	if (item.m_iImage != -1 && hImageList != nullptr)
 	{
 		int cx = 0;
 		int cy = 0;
-		auto hImagelist = TabCtrl_GetImageList(hWnd);
 		static constexpr int offset = 2;
-		::ImageList_GetIconSize(hImagelist, &cx, &cy);
-		::ImageList_Draw(hImagelist, tci.iImage, hdc, rcText.left + offset, rcText.top + (((rcText.bottom - rcText.top) - cy) / 2), ILD_NORMAL);
+		::ImageList_GetIconSize(hImageList, &cx, &cy);
+		::ImageList_Draw(hImageList, item.m_iImage, hdc, rcText.left + offset, rcText.top + (((rcText.bottom - rcText.top) - cy) / 2), ILD_NORMAL);
 		rcText.left += cx;
 	}
 
-	::DrawText(hdc, label.c_str(), -1, &rcText, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+	::DrawText(hdc, label, -1, &rcText, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
 
 	::FrameRect(hdc, &rcFrame, DarkMode::getEdgeBrush());
 
@@ -1259,75 +1690,150 @@ static void paintTabItem(
 /**
  * @brief Custom paints tab items.
  *
- * Iterates through all tabs in a `SysTabControl32`, applying customized backgrounds,
+ * Iterates through cached tabs of a `SysTabControl32`, applying customized backgrounds,
  * text colors, focus indicators, and optional icon drawing. Handles both button-style
  * (`TCS_BUTTONS`) and standard tab layouts, adapting based on hover state, selection,
  * and focus cue.
  *
  * Paint logic includes:
- * - Retrieves label and optional image via `TCITEM` and `ImageList_Draw`
+ * - Refreshes item rectangles only after invalidation or selection change
+ * - Skips items outside the update rectangle, retrieves labels only for painted
+ *   items without valid cached label
  * - Applies coloring based on selection, hover, and tab style
  * - Clips each tab to avoid flickering during overlapping redraw
  * - Draws optional focus rectangle if control has input focus via keyboard
+ * - Falls back to uncached painting if the item cache cannot be allocated
  *
  * @note Currently only works for horizontal style.
  *
- * @param[in]   hWnd    Handle to the tab control.
- * @param[in]   hdc     Device context to draw into.
- * @param[in]   rect    Tab control rectangle.
+ * @param[in]       hWnd    Handle to the tab control.
+ * @param[in]       hdc     Device context to draw into.
+ * @param[in]       rcPaint Update rectangle from `BeginPaint`.
+ * @param[in,out]   tabData Reference to the control's data with item cache.
  */
-static void paintTab(HWND hWnd, HDC hdc, const RECT& rect) noexcept
+static void paintTab(HWND hWnd, HDC hdc, const RECT& rcPaint, dmlib_subclass::TabData& tabData) noexcept
 {
-	::FillRect(hdc, &rect, DarkMode::getDlgBackgroundBrush());
+	::FillRect(hdc, &rcPaint, DarkMode::getDlgBackgroundBrush());
+
+	const auto nTabs = TabCtrl_GetItemCount(hWnd);
+	bool isCached = true;
+	if (!tabData.m_isLayoutValid
+		|| static_cast<size_t>(std::max<int>(nTabs, 0)) != tabData.m_items.size()
+		|| TabCtrl_GetCurSel(hWnd) != tabData.m_iSelTab)
+	{
+		isCached = updateTabLayout(hWnd, tabData);
+	}
 
 	const auto hPen = dmlib_paint::GdiObject{ hdc, DarkMode::getEdgePen(), true };
 	const auto hFont = dmlib_paint::GdiObject{ hdc, hWnd };
 
-	auto holdClip = ::CreateRectRgn(0, 0, 0, 0);
+	auto holdClip = dmlib_resource::createRectRgn(0, 0, 0, 0);
 	if (::GetClipRgn(hdc, holdClip) != 1)
 	{
-		::DeleteObject(holdClip);
+		dmlib_resource::deleteObject(holdClip);
 		holdClip = nullptr;
 	}
 
-	POINT ptCursor{};
-	::GetCursorPos(&ptCursor);
-	::ScreenToClient(hWnd, &ptCursor);
+	// clip regions are in device coordinates, back buffer can have moved viewport origin
+	POINT ptOrigin{};
+	::GetViewportOrgEx(hdc, &ptOrigin);
 
 	::SetBkMode(hdc, TRANSPARENT);
 
-	const auto iSelTab = TabCtrl_GetCurSel(hWnd);
-	const auto nTabs = TabCtrl_GetItemCount(hWnd);
+	const auto hImageList = TabCtrl_GetImageList(hWnd);
+	const auto iSelTab = tabData.m_iSelTab;
+	auto label = dmlib_subclass::TextBuffer{ MAX_PATH };
 	for (int i = 0; i < nTabs; ++i)
 	{
-		RECT rcItem{};
-		TabCtrl_GetItemRect(hWnd, i, &rcItem);
+		dmlib_subclass::TabItem uncachedItem{};
+		auto& item = isCached ? tabData.m_items[static_cast<size_t>(i)] : uncachedItem;
+		if (!isCached)
+		{
+			TabCtrl_GetItemRect(hWnd, i, &item.m_rcItem);
+		}
 
 		if (RECT rcIntersect{};
-			::IntersectRect(&rcIntersect, &rect, &rcItem) == FALSE)
+			::IntersectRect(&rcIntersect, &rcPaint, &item.m_rcItem) == FALSE)
 		{
 			continue; // Skip to the next iteration when there is no intersection
 		}
 
-		HRGN hClip = ::CreateRectRgnIndirect(&rcItem);
+		const wchar_t* pszLabel = item.m_label.c_str();
+		if (!item.m_isLabelValid)
+		{
+			pszLabel = updateTabItemLabel(hWnd, i, item, label);
+		}
+
+		HRGN hClip = dmlib_resource::createRectRgnIndirect(&item.m_rcItem);
+		::OffsetRgn(hClip, ptOrigin.x, ptOrigin.y);
 		::SelectClipRgn(hdc, hClip);
 
-		paintTabItem(hdc, hWnd, rcItem, i, iSelTab, nTabs, ptCursor);
+		paintTabItem(hdc, hWnd, item, pszLabel, hImageList, i, iSelTab, nTabs, i == tabData.m_iHotItem);
 
 		::SelectClipRgn(hdc, holdClip);
-		::DeleteObject(hClip);
+		dmlib_resource::deleteObject(hClip);
 	}
 
 	::SelectClipRgn(hdc, holdClip);
 	if (holdClip != nullptr)
 	{
-		::DeleteObject(holdClip);
+		dmlib_resource::deleteObject(holdClip);
 		holdClip = nullptr;
 	}
 }
 
 /**
- * @brief Window subclass procedure for owner drawn tab control.
+ * @brief Invalidates single tab item.
+ *
+ * @param[in] hWnd  Handle to the tab control.
+ * @param[in] i     Index of the tab item, no action if negative.
+ */
+static void invalidateTabItem(HWND hWnd, int i) noexcept
+{
+	if (RECT rcItem{};
+		i >= 0 && TabCtrl_GetItemRect(hWnd, i, &rcItem) == TRUE)
+	{
+		// selected tab frame is drawn 1px outside the item rectangle
+		::InflateRect(&rcItem, 1, 1);
+		::InvalidateRect(hWnd, &rcItem, FALSE);
+	}
+}
+
+/**
+ * @brief Handles `WM_PARENTNOTIFY` for the `upDown` tab behavior.
+ *
+ * Subclasses up-down (spinner) child created dynamically
+ * for `TCS_SCROLLOPPOSITE` or overflow.
+ *
+ * @param[in]   hWnd        Handle to the tab control.
+ * @param[in]   uMsg        Message identifier.
+ * @param[in]   wParam      Message-specific data.
+ * @param[in]   lParam      Message-specific data.
+ * @return LRESULT Result of message processing.
+ *
+ * @see DarkMode::setUpDownCtrlSubclass()
+ * @see DarkMode::setTabCtrlUpDownSubclass()
+ */
+static LRESULT onTabParentNotify(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	if (LOWORD(wParam) == WM_CREATE)
+	{
+		auto hUpDown = reinterpret_cast<HWND>(lParam);
+		if (dmlib_subclass::cmpWndClassName(hUpDown, UPDOWN_CLASS))
+		{
+			DarkMode::setUpDownCtrlSubclass(hUpDown);
+			return 0;
+		}
+	}
+	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+/**
+ * @brief Window subclass procedure for tab control.
+ *
+ * Single subclass for tab control, handles enabled `TabBehavior` flags:
+ * - `paint`: owner drawn painting.
+ * - `upDown`: detection and subclassing of up-down (spinner) child.
  *
  * @param[in]   hWnd        Window handle being subclassed.
  * @param[in]   uMsg        Message identifier.
@@ -1338,10 +1844,10 @@ static void paintTab(HWND hWnd, HDC hdc, const RECT& rect) noexcept
  * @return LRESULT Result of message processing.
  *
  * @see paintTab()
- * @see DarkMode::setTabCtrlPaintSubclass()
- * @see DarkMode::removeTabCtrlPaintSubclass()
+ * @see dmlib_subclass::setTabBehavior()
+ * @see dmlib_subclass::removeTabBehavior()
  */
-LRESULT CALLBACK dmlib_subclass::TabPaintSubclass(
+LRESULT CALLBACK dmlib_subclass::TabSubclass(
 	HWND hWnd,
 	UINT uMsg,
 	WPARAM wParam,
@@ -1350,26 +1856,51 @@ LRESULT CALLBACK dmlib_subclass::TabPaintSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ TCM_FIRST, {
+		WM_NCDESTROY, WM_PARENTNOTIFY, WM_ERASEBKGND, WM_PAINT, WM_UPDATEUISTATE,
+		WM_SIZE, WM_SETFONT, WM_STYLECHANGED, WM_HSCROLL, WM_MOUSEMOVE, WM_MOUSELEAVE,
+		TCM_INSERTITEMA, TCM_INSERTITEMW, TCM_DELETEITEM, TCM_DELETEALLITEMS,
+		TCM_SETITEMA, TCM_SETITEMW, TCM_HIGHLIGHTITEM, TCM_SETITEMSIZE, TCM_SETPADDING,
+		TCM_SETMINTABWIDTH, TCM_SETIMAGELIST, TCM_REMOVEIMAGE, TCM_SETCURSEL, TCM_SETCURFOCUS
+	} };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pTabData = reinterpret_cast<TabData*>(dwRefData);
 	const auto& hMemDC = pTabData->m_bufferData.getHMemDC();
 
-	if (const auto nStyle = ::GetWindowLongPtrW(hWnd, GWL_STYLE);
-		((nStyle & (TCS_VERTICAL | TCS_OWNERDRAWFIXED)) != 0)
-		&& (uMsg != WM_NCDESTROY))
+	if (uMsg == WM_NCDESTROY)
 	{
+		RemoveSubclassOnNcDestroy(hWnd, TabSubclass, uIdSubclass);
+		std::unique_ptr<TabData> u_ptrData(pTabData);
+		u_ptrData.reset(nullptr);
 		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 	}
 
-	switch (uMsg)
+	if (uMsg == WM_PARENTNOTIFY)
 	{
-		case WM_NCDESTROY:
+		if (pTabData->hasBehavior(TabBehavior::upDown))
 		{
-			::RemoveWindowSubclass(hWnd, TabPaintSubclass, uIdSubclass);
-			std::unique_ptr<TabData> u_ptrData(pTabData);
-			u_ptrData.reset(nullptr);
-			break;
+			return onTabParentNotify(hWnd, uMsg, wParam, lParam);
 		}
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
 
+	if (!pTabData->hasBehavior(TabBehavior::paint))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	if (const auto nStyle = ::GetWindowLongPtrW(hWnd, GWL_STYLE);
+		(nStyle & (TCS_VERTICAL | TCS_OWNERDRAWFIXED)) != 0)
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	switch (uMsg)
+	{
 		case WM_ERASEBKGND:
 		{
 			if (!DarkMode::isEnabled())
@@ -1400,10 +1931,8 @@ LRESULT CALLBACK dmlib_subclass::TabPaintSubclass(
 				return 0;
 			}
 
-			RECT rcClient{};
-			::GetClientRect(hWnd, &rcClient);
 			dmlib_paint::PaintWithBuffer<TabData>(*pTabData, hdc, ps,
-				[&]() { paintTab(hWnd, hMemDC, rcClient); },
+				[&]() { paintTab(hWnd, hMemDC, ps.rcPaint, *pTabData); },
 				hWnd);
 
 			::EndPaint(hWnd, &ps);
@@ -1419,57 +1948,78 @@ LRESULT CALLBACK dmlib_subclass::TabPaintSubclass(
 			break;
 		}
 
-		default:
+		case WM_MOUSEMOVE:
 		{
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			TCHITTESTINFO hti{};
+			hti.pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+			if (const int iHot = TabCtrl_HitTest(hWnd, &hti);
+				iHot != pTabData->m_iHotItem)
+			{
+				invalidateTabItem(hWnd, pTabData->m_iHotItem);
+				invalidateTabItem(hWnd, iHot);
+				pTabData->m_iHotItem = iHot;
+			}
+
+			if (!pTabData->m_isTrackingMouse)
+			{
+				TRACKMOUSEEVENT tme{};
+				tme.cbSize = sizeof(TRACKMOUSEEVENT);
+				tme.dwFlags = TME_LEAVE;
+				tme.hwndTrack = hWnd;
+				pTabData->m_isTrackingMouse = ::TrackMouseEvent(&tme) == TRUE;
+			}
 			break;
 		}
-	}
-	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
-}
 
-/**
- * @brief Window subclass procedure for tab control's up-down control subclassing.
- *
- * @param[in]   hWnd        Window handle being subclassed.
- * @param[in]   uMsg        Message identifier.
- * @param[in]   wParam      Message-specific data.
- * @param[in]   lParam      Message-specific data.
- * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   Reserved data (unused).
- * @return LRESULT Result of message processing.
- *
- * @see DarkMode::setUpDownCtrlSubclass()
- * @see DarkMode::setTabCtrlUpDownSubclass()
- * @see DarkMode::removeTabCtrlUpDownSubclass()
- */
-LRESULT CALLBACK dmlib_subclass::TabUpDownSubclass(
-	HWND hWnd,
-	UINT uMsg,
-	WPARAM wParam,
-	LPARAM lParam,
-	UINT_PTR uIdSubclass,
-	[[maybe_unused]] DWORD_PTR dwRefData
-)
-{
-	switch (uMsg)
-	{
-		case WM_NCDESTROY:
+		case WM_MOUSELEAVE:
 		{
-			::RemoveWindowSubclass(hWnd, TabUpDownSubclass, uIdSubclass);
+			invalidateTabItem(hWnd, pTabData->m_iHotItem);
+			pTabData->m_iHotItem = -1;
+			pTabData->m_isTrackingMouse = false;
 			break;
 		}
 
-		case WM_PARENTNOTIFY:
+		case TCM_INSERTITEMA:
+		case TCM_INSERTITEMW:
+		case TCM_DELETEITEM:
+		case TCM_DELETEALLITEMS:
 		{
-			if (LOWORD(wParam) == WM_CREATE)
-			{
-				auto hUpDown = reinterpret_cast<HWND>(lParam);
-				if (dmlib_subclass::cmpWndClassName(hUpDown, UPDOWN_CLASS))
-				{
-					DarkMode::setUpDownCtrlSubclass(hUpDown);
-					return 0;
-				}
-			}
+			pTabData->invalidateItems();
+			pTabData->m_iHotItem = -1;
+			break;
+		}
+
+		case TCM_SETITEMA:
+		case TCM_SETITEMW:
+		case TCM_HIGHLIGHTITEM:
+		{
+			pTabData->invalidateItem(static_cast<int>(wParam));
+			break;
+		}
+
+		case WM_SIZE:
+		case WM_SETFONT:
+		case WM_STYLECHANGED:
+		case WM_HSCROLL:
+		case TCM_SETITEMSIZE:
+		case TCM_SETPADDING:
+		case TCM_SETMINTABWIDTH:
+		case TCM_SETIMAGELIST:
+		case TCM_SETCURSEL:
+		case TCM_SETCURFOCUS:
+		{
+			pTabData->invalidateLayout();
+			break;
+		}
+
+		case TCM_REMOVEIMAGE:
+		{
+			pTabData->invalidateItems();
 			break;
 		}
 
@@ -1481,6 +2031,54 @@ LRESULT CALLBACK dmlib_subclass::TabUpDownSubclass(
 	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 }
 
+/**
+ * @brief Enables tab behavior.
+ *
+ * Installs the single tab subclass on first use,
+ * later calls only set the behavior flag.
+ *
+ * @param[in] hWnd      Handle to the tab control.
+ * @param[in] behavior  Behavior to enable.
+ *
+ * @see dmlib_subclass::TabSubclass()
+ * @see dmlib_subclass::removeTabBehavior()
+ */
+void dmlib_subclass::setTabBehavior(HWND hWnd, TabBehavior behavior)
+{
+	static_cast<void>(dmlib_subclass::SetSubclass<TabData>(hWnd, TabSubclass, SubclassID::tab));
+
+	if (auto* pTabData = dmlib_subclass::getSubclassData<TabData>(hWnd, SubclassID::tab);
+		pTabData != nullptr)
+	{
+		pTabData->m_behaviors |= static_cast<std::uint8_t>(behavior);
+		pTabData->invalidateItems();
+	}
+}
+
+/**
+ * @brief Disables tab behavior.
+ *
+ * Removes the single tab subclass when no behavior is left enabled.
+ *
+ * @param[in] hWnd      Handle to the tab control.
+ * @param[in] behavior  Behavior to disable.
+ *
+ * @see dmlib_subclass::TabSubclass()
+ * @see dmlib_subclass::setTabBehavior()
+ */
+void dmlib_subclass::removeTabBehavior(HWND hWnd, TabBehavior behavior)
+{
+	if (auto* pTabData = dmlib_subclass::getSubclassData<TabData>(hWnd, SubclassID::tab);
+		pTabData != nullptr)
+	{
+		pTabData->m_behaviors &= static_cast<std::uint8_t>(~static_cast<std::uint8_t>(behavior));
+		if (pTabData->m_behaviors == 0)
+		{
+			dmlib_subclass::RemoveSubclass<TabData>(hWnd, TabSubclass, SubclassID::tab);
+		}
+	}
+}
+
 /**
  * @brief Paints a custom non-client border for list box and edit controls.
  *
@@ -1510,11 +2108,11 @@ static void ncPaintCustomBorder(HWND hWnd, const dmlib_subclass::BorderMetricsDa
 		rcClient.bottom += borderMetricsData.m_yScroll;
 	}
 
-	const HPEN hPen = ::CreatePen(PS_SOLID, 1, (::IsWindowEnabled(hWnd) == TRUE) ? DarkMode::getBackgroundColor() : DarkMode::getDlgBackgroundColor());
+	const HPEN hPen = dmlib_resource::createPen(PS_SOLID, 1, (::IsWindowEnabled(hWnd) == TRUE) ? DarkMode::getBackgroundColor() : DarkMode::getDlgBackgroundColor());
 	RECT rcInner{ rcClient };
 	::InflateRect(&rcInner, -1, -1);
 	dmlib_paint::paintFrameRect(hdc, rcInner, hPen);
-	::DeleteObject(hPen);
+	dmlib_resource::deleteObject(hPen);
 
 	POINT ptCursor{};
 	::GetCursorPos(&ptCursor);
@@ -1567,13 +2165,22 @@ LRESULT CALLBACK dmlib_subclass::CustomBorderSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_NCPAINT, WM_NCCALCSIZE, WM_MOUSEMOVE,
+		WM_MOUSELEAVE, WM_DPICHANGED_AFTERPARENT
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pBorderMetricsData = reinterpret_cast<BorderMetricsData*>(dwRefData);
 
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, CustomBorderSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, CustomBorderSubclass, uIdSubclass);
 			std::unique_ptr<BorderMetricsData> u_ptrData(pBorderMetricsData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -1776,10 +2383,9 @@ static void renderComboBoxEdit(HWND hWnd, HDC hdc, dmlib_subclass::ComboBoxData&
 		{
 			const auto holdFont = dmlib_paint::GdiObject{ hdc, hWnd };
 
-			::SetTextColor(hdc, getColorFromState(isDisabled, isHot));
 			static constexpr UINT dtFlags = DT_NOPREFIX | DT_CENTER | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP;
 			::SetBkMode(hdc, TRANSPARENT);
-			::DrawText(hdc, dmlib_glyph::kArrowDown, -1, &rcArrow, dtFlags);
+			dmlib_glyph::drawGlyph(hdc, dmlib_glyph::kArrowDown, rcArrow, dtFlags, getColorFromState(isDisabled, isHot));
 		}
 	}
 
@@ -1809,9 +2415,9 @@ static void renderComboBoxEdit(HWND hWnd, HDC hdc, dmlib_subclass::ComboBoxData&
 		rcInner.right = rcArrow.left - 1;
 	}
 
-	HPEN hInnerPen = ::CreatePen(PS_SOLID, 1, isDisabled ? DarkMode::getDlgBackgroundColor() : DarkMode::getBackgroundColor());
+	HPEN hInnerPen = dmlib_resource::createPen(PS_SOLID, 1, isDisabled ? DarkMode::getDlgBackgroundColor() : DarkMode::getBackgroundColor());
 	dmlib_paint::paintFrameRect(hdc, rcInner, hInnerPen);
-	::DeleteObject(hInnerPen);
+	dmlib_resource::deleteObject(hInnerPen);
 	::InflateRect(&rcInner, -1, -1);
 	::FillRect(hdc, &rcInner, isDisabled ? DarkMode::getDlgBackgroundBrush() : DarkMode::getCtrlBackgroundBrush());
 
@@ -1880,7 +2486,7 @@ static void renderComboBoxList(HWND hWnd, HDC hdc, dmlib_subclass::ComboBoxData&
 		index != CB_ERR)
 	{
 		const auto bufferLen = static_cast<size_t>(::SendMessage(hWnd, CB_GETLBTEXTLEN, static_cast<WPARAM>(index), 0));
-		std::wstring buffer(bufferLen + 1, L'\0');
+		auto buffer = dmlib_subclass::TextBuffer{ bufferLen + 1 };
 		::SendMessage(hWnd, CB_GETLBTEXT, static_cast<WPARAM>(index), reinterpret_cast<LPARAM>(buffer.data()));
 
 		RECT rcText{ cbi.rcItem };
@@ -1923,9 +2529,8 @@ static void renderComboBoxList(HWND hWnd, HDC hdc, dmlib_subclass::ComboBoxData&
 	}
 	else
 	{
-		::SetTextColor(hdc, getColorFromState(isDisabled, isHot));
 		static constexpr UINT dtFlags = DT_NOPREFIX | DT_CENTER | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP;
-		::DrawText(hdc, dmlib_glyph::kArrowDown, -1, &rcArrow, dtFlags);
+		dmlib_glyph::drawGlyph(hdc, dmlib_glyph::kArrowDown, rcArrow, dtFlags, getColorFromState(isDisabled, isHot));
 	}
 
 	// Frame part
@@ -2063,6 +2668,15 @@ LRESULT CALLBACK dmlib_subclass::ComboBoxSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_ENABLE,
+		WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pComboboxData = reinterpret_cast<ComboBoxData*>(dwRefData);
 	auto& themeData = pComboboxData->m_themeData;
 	const auto& hMemDC = pComboboxData->m_bufferData.getHMemDC();
@@ -2071,7 +2685,7 @@ LRESULT CALLBACK dmlib_subclass::ComboBoxSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, ComboBoxSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, ComboBoxSubclass, uIdSubclass);
 			std::unique_ptr<ComboBoxData> u_ptrData(pComboboxData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -2180,11 +2794,17 @@ LRESULT CALLBACK dmlib_subclass::ComboBoxExSubclass(
 	[[maybe_unused]] DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_ERASEBKGND, WM_CTLCOLOREDIT, WM_CTLCOLORLISTBOX, WM_COMMAND };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, ComboBoxExSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, ComboBoxExSubclass, uIdSubclass);
 			dmlib_hook::unhookSysColor();
 			break;
 		}
@@ -2319,11 +2939,17 @@ LRESULT CALLBACK dmlib_subclass::ListViewSubclass(
 	[[maybe_unused]] DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_PAINT, WM_CTLCOLOREDIT, WM_NOTIFY, WM_DPICHANGED_AFTERPARENT };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, ListViewSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, ListViewSubclass, uIdSubclass);
 			dmlib_hook::unhookSysColor();
 			break;
 		}
@@ -2410,7 +3036,7 @@ LRESULT CALLBACK dmlib_subclass::ListViewSubclass(
  * @param[in]   hdc             Device context to draw into.
  * @param[in]   headerData      Reference to the header's theme, state, and style data.
  * @param[in]   i               Zero-based index of the header item to paint.
- * @param[in]   rcItem          Rect used by Header_GetItemRect.
+ * @param[in]   rcItem          Item rectangle from `Header_GetItemRect`.
  * @param[in]   hasGridlines    True when parent ListView displays gridlines.
  * @param[in]   dtto            DTTOPTS for DrawThemeTextEx.
  */
@@ -2426,8 +3052,7 @@ static void paintHeaderItem(
 {
 	const HTHEME& hTheme = headerData.m_themeData.getHTheme();
 
-	Header_GetItemRect(hWnd, i, &rcItem);
-	const bool isOnItem = ::PtInRect(&rcItem, headerData.m_pt) == TRUE;
+	const bool isOnItem = (i == headerData.m_iHotItem);
 
 	// Different visual styles have different vertical alignments.
 	// This part is for header item rectangle.
@@ -2445,11 +3070,11 @@ static void paintHeaderItem(
 		::FillRect(hdc, &rcTmp, DarkMode::getHeaderHotBackgroundBrush());
 	}
 
-	std::wstring buffer(MAX_PATH, L'\0');
+	auto buffer = dmlib_subclass::TextBuffer{ MAX_PATH };
 	HDITEM hdi{};
 	hdi.mask = HDI_TEXT | HDI_FORMAT;
 	hdi.pszText = buffer.data();
-	hdi.cchTextMax = MAX_PATH - 1;
+	hdi.cchTextMax = static_cast<int>(buffer.size());
 
 	Header_GetItem(hWnd, i, &hdi);
 
@@ -2526,16 +3151,17 @@ static void paintHeaderItem(
  *
  * Paint logic:
  * - Determines if the parent list view is in report mode and has gridlines.
- * - Iterates over all header items
+ * - Iterates over header items, skips items outside the update rectangle.
  *
  * @param[in]       hWnd        Handle to the header control.
  * @param[in]       hdc         Device context to draw into.
+ * @param[in]       rcPaint     Update rectangle from `BeginPaint`.
  * @param[in,out]   headerData  Reference to the header's theme, state, and style data.
  *
  * @see HeaderData
  * @see paintHeaderItem()
  */
-static void paintHeader(HWND hWnd, HDC hdc, dmlib_subclass::HeaderData& headerData) noexcept
+static void paintHeader(HWND hWnd, HDC hdc, const RECT& rcPaint, dmlib_subclass::HeaderData& headerData) noexcept
 {
 	auto& themeData = headerData.m_themeData;
 	const auto& hTheme = themeData.getHTheme();
@@ -2545,9 +3171,7 @@ static void paintHeader(HWND hWnd, HDC hdc, dmlib_subclass::HeaderData& headerDa
 	::SetBkMode(hdc, TRANSPARENT);
 	const auto holdPen = dmlib_paint::GdiObject{ hdc, DarkMode::getHeaderEdgePen(), true };
 
-	RECT rcHeader{};
-	::GetClientRect(hWnd, &rcHeader);
-	::FillRect(hdc, &rcHeader, DarkMode::getHeaderBackgroundBrush());
+	::FillRect(hdc, &rcPaint, DarkMode::getHeaderBackgroundBrush());
 
 	// Font part
 
@@ -2556,7 +3180,7 @@ static void paintHeader(HWND hWnd, HDC hdc, dmlib_subclass::HeaderData& headerDa
 		&& hasTheme
 		&& SUCCEEDED(::GetThemeFont(hTheme, hdc, HP_HEADERITEM, HIS_NORMAL, TMT_FONT, &lf)))
 	{
-		fontData.setFont(::CreateFontIndirectW(&lf));
+		fontData.setSharedFont(lf, dmlib_dpi::GetDpiForWindow(hWnd));
 	}
 
 	const auto holdFont = dmlib_paint::GdiObject{
@@ -2592,10 +3216,38 @@ static void paintHeader(HWND hWnd, HDC hdc, dmlib_subclass::HeaderData& headerDa
 	RECT rcItem{};
 	for (int i = 0; i < count; i++)
 	{
+		Header_GetItemRect(hWnd, i, &rcItem);
+
+		// hot background can be offset by 1px to the neighbor item
+		RECT rcTest{ rcItem };
+		::InflateRect(&rcTest, 1, 0);
+		if (RECT rcIntersect{};
+			::IntersectRect(&rcIntersect, &rcPaint, &rcTest) == FALSE)
+		{
+			continue;
+		}
+
 		paintHeaderItem(hWnd, hdc, headerData, i, rcItem, hasGridlines, dtto);
 	}
 }
 
+/**
+ * @brief Invalidates single header item.
+ *
+ * @param[in] hWnd  Handle to the header control.
+ * @param[in] i     Index of the header item, no action if negative.
+ */
+static void invalidateHeaderItem(HWND hWnd, int i) noexcept
+{
+	if (RECT rcItem{};
+		i >= 0 && Header_GetItemRect(hWnd, i, &rcItem) == TRUE)
+	{
+		// hot background can be offset by 1px to the neighbor item
+		::InflateRect(&rcItem, 1, 0);
+		::InvalidateRect(hWnd, &rcItem, FALSE);
+	}
+}
+
 /**
  * @brief Window subclass procedure for owner drawn header control.
  *
@@ -2619,6 +3271,16 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_LBUTTONDOWN,
+		WM_LBUTTONUP, WM_MOUSEMOVE, WM_MOUSELEAVE, WM_DPICHANGED_AFTERPARENT,
+		WM_THEMECHANGED
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pHeaderData = reinterpret_cast<HeaderData*>(dwRefData);
 	auto& themeData = pHeaderData->m_themeData;
 	const auto& hMemDC = pHeaderData->m_bufferData.getHMemDC();
@@ -2627,7 +3289,7 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, HeaderSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, HeaderSubclass, uIdSubclass);
 			std::unique_ptr<HeaderData> u_ptrData(pHeaderData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -2664,7 +3326,7 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 			}
 
 			dmlib_paint::PaintWithBuffer<HeaderData>(*pHeaderData, hdc, ps,
-				[&]() { paintHeader(hWnd, hMemDC, *pHeaderData); },
+				[&]() { paintHeader(hWnd, hMemDC, ps.rcPaint, *pHeaderData); },
 				hWnd);
 
 			::EndPaint(hWnd, &ps);
@@ -2674,12 +3336,14 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 		case WM_DPICHANGED_AFTERPARENT:
 		{
 			themeData.closeTheme();
+			pHeaderData->m_fontData.invalidateFont();
 			return 0;
 		}
 
 		case WM_THEMECHANGED:
 		{
 			themeData.closeTheme();
+			pHeaderData->m_fontData.invalidateFont();
 			break;
 		}
 
@@ -2691,6 +3355,7 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 			}
 
 			pHeaderData->m_isPressed = true;
+			invalidateHeaderItem(hWnd, pHeaderData->m_iHotItem);
 			break;
 		}
 
@@ -2702,6 +3367,7 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 			}
 
 			pHeaderData->m_isPressed = false;
+			invalidateHeaderItem(hWnd, pHeaderData->m_iHotItem);
 			break;
 		}
 
@@ -2725,10 +3391,17 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 				pHeaderData->m_isHot = true;
 			}
 
-			pHeaderData->m_pt.x = GET_X_LPARAM(lParam);
-			pHeaderData->m_pt.y = GET_Y_LPARAM(lParam);
+			HDHITTESTINFO hdhti{};
+			hdhti.pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+			::SendMessage(hWnd, HDM_HITTEST, 0, reinterpret_cast<LPARAM>(&hdhti));
 
-			::InvalidateRect(hWnd, nullptr, FALSE);
+			const int iHot = ((hdhti.flags & (HHT_ONHEADER | HHT_ONDIVIDER | HHT_ONDIVOPEN)) != 0) ? hdhti.iItem : -1;
+			if (iHot != pHeaderData->m_iHotItem)
+			{
+				invalidateHeaderItem(hWnd, pHeaderData->m_iHotItem);
+				invalidateHeaderItem(hWnd, iHot);
+				pHeaderData->m_iHotItem = iHot;
+			}
 			break;
 		}
 
@@ -2742,10 +3415,8 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 			const LRESULT retVal = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 
 			pHeaderData->m_isHot = false;
-			pHeaderData->m_pt.x = LONG_MIN;
-			pHeaderData->m_pt.y = LONG_MIN;
-
-			::InvalidateRect(hWnd, nullptr, TRUE);
+			invalidateHeaderItem(hWnd, pHeaderData->m_iHotItem);
+			pHeaderData->m_iHotItem = -1;
 
 			return retVal;
 		}
@@ -2758,6 +3429,128 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
 	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 }
 
+/**
+ * @brief Retrieves rectangles of all status bar parts into the part cache.
+ *
+ * Texts of all parts are marked for retrieval on next paint.
+ *
+ * @param[in]       hWnd            Handle to the status bar control.
+ * @param[in,out]   statusBarData   Reference to the control's data with part cache.
+ * @return `false` if the part cache could not be allocated.
+ *
+ * @see StatusBarPart
+ */
+static bool updateStatusBarLayout(HWND hWnd, dmlib_subclass::StatusBarData& statusBarData) noexcept
+{
+	const auto nParts = static_cast<int>(::SendMessage(hWnd, SB_GETPARTS, 0, 0));
+	auto& parts = statusBarData.m_parts;
+	try
+	{
+		parts.resize(static_cast<size_t>(std::max<int>(nParts, 0)));
+	}
+	catch (...)
+	{
+		parts.clear();
+		statusBarData.m_isLayoutValid = false;
+		return false;
+	}
+
+	for (int i = 0; i < nParts; ++i)
+	{
+		auto& part = parts[static_cast<size_t>(i)];
+		::SendMessage(hWnd, SB_GETRECT, static_cast<WPARAM>(i), reinterpret_cast<LPARAM>(&part.m_rcPart));
+		part.m_isTextValid = false;
+	}
+	statusBarData.m_isLayoutValid = true;
+	return true;
+}
+
+/**
+ * @brief Retrieves text and drawing type of single status bar part into the part cache.
+ *
+ * Text is retrieved into `str` and then copied to the cache. If the copy
+ * cannot be allocated, text stays invalid and `str` is painted instead.
+ *
+ * @param[in]       hWnd        Handle to the status bar control.
+ * @param[in]       i           Zero-based part index.
+ * @param[in]       retValLen   Value returned by `SB_GETTEXTLENGTH` for the part.
+ * @param[out]      str         Scratch buffer with room for the text and null terminator.
+ * @param[in,out]   part        Cached part to update.
+ * @return Text to paint, valid until `str` or the part changes.
+ */
+static const wchar_t* updateStatusBarPartText(
+	HWND hWnd,
+	int i,
+	LRESULT retValLen,
+	dmlib_subclass::TextBuffer& str,
+	dmlib_subclass::StatusBarPart& part
+) noexcept
+{
+	part.m_type = HIWORD(retValLen);
+	if (str.size() == 0)
+	{
+		return L"";
+	}
+
+	part.m_itemData = ::SendMessage(hWnd, SB_GETTEXT, static_cast<WPARAM>(i), reinterpret_cast<LPARAM>(str.data()));
+	try
+	{
+		part.m_text.assign(str.c_str());
+		part.m_isTextValid = true;
+		return part.m_text.c_str();
+	}
+	catch (...)
+	{
+		part.m_text.clear();
+		part.m_isTextValid = false;
+		return str.c_str();
+	}
+}
+
+/**
+ * @brief Paints text of single status bar part, or lets the parent draw owner drawn part.
+ *
+ * @param[in]   hWnd    Handle to the status bar control.
+ * @param[in]   hdc     Device context to paint into.
+ * @param[in]   i       Zero-based part index.
+ * @param[in]   part    Part with drawing type and item data.
+ * @param[in]   text    Text of the part.
+ * @param[in]   rcPart  Text rectangle of the part.
+ */
+static void paintStatusBarPart(
+	HWND hWnd,
+	HDC hdc,
+	int i,
+	const dmlib_subclass::StatusBarPart& part,
+	const wchar_t* text,
+	const RECT& rcPart
+) noexcept
+{
+	// With `SBT_OWNERDRAW` flag parent will draw status bar.
+	if (*text == L'\0' && (part.m_type & SBT_OWNERDRAW) != 0)
+	{
+		const auto id = static_cast<UINT>(::GetDlgCtrlID(hWnd));
+		DRAWITEMSTRUCT dis{
+			0
+			, 0
+			, static_cast<UINT>(i)
+			, ODA_DRAWENTIRE
+			, id
+			, hWnd
+			, hdc
+			, rcPart
+			, static_cast<ULONG_PTR>(part.m_itemData)
+		};
+
+		::SendMessage(::GetParent(hWnd), WM_DRAWITEM, id, reinterpret_cast<LPARAM>(&dis));
+	}
+	else
+	{
+		RECT rcText{ rcPart };
+		::DrawText(hdc, text, -1, &rcText, DT_SINGLELINE | DT_VCENTER | DT_LEFT);
+	}
+}
+
 /**
  * @brief Custom paints a status bar control.
  *
@@ -2765,13 +3558,18 @@ LRESULT CALLBACK dmlib_subclass::HeaderSubclass(
  * custom brushes, pens, and fonts. Supports owner-drawn parts and adapts
  * to the control's style flags and part configuration.
  *
+ * Part rectangles and texts are taken from the part cache, only parts
+ * intersecting the update rectangle are painted. If the cache cannot be
+ * allocated, parts are retrieved and painted without caching.
+ *
  * @param[in]       hWnd            Handle to the status bar control.
  * @param[in]       hdc             Device context to paint into.
- * @param[in,out]   statusBarData   Reference to the control's theme, buffer, and font data.
+ * @param[in]       rcPaint         Update rectangle from `BeginPaint`.
+ * @param[in,out]   statusBarData   Reference to the control's theme, buffer, font data, and part cache.
  *
  * @see StatusBarData
  */
-static void paintStatusBar(HWND hWnd, HDC hdc, dmlib_subclass::StatusBarData& statusBarData) noexcept
+static void paintStatusBar(HWND hWnd, HDC hdc, const RECT& rcPaint, dmlib_subclass::StatusBarData& statusBarData) noexcept
 {
 	struct
 	{
@@ -2794,11 +3592,18 @@ static void paintStatusBar(HWND hWnd, HDC hdc, dmlib_subclass::StatusBarData& st
 	RECT rcClient{};
 	::GetClientRect(hWnd, &rcClient);
 
-	::FillRect(hdc, &rcClient, DarkMode::getBackgroundBrush());
+	::FillRect(hdc, &rcPaint, DarkMode::getBackgroundBrush());
 
-	const auto nParts = static_cast<int>(::SendMessage(hWnd, SB_GETPARTS, 0, 0));
-	std::wstring str;
-	RECT rcPart{};
+	bool isCached = true;
+	if (!statusBarData.m_isLayoutValid)
+	{
+		isCached = updateStatusBarLayout(hWnd, statusBarData);
+	}
+
+	auto& parts = statusBarData.m_parts;
+	const auto nParts = isCached
+		? static_cast<int>(parts.size())
+		: static_cast<int>(::SendMessage(hWnd, SB_GETPARTS, 0, 0));
 	RECT rcIntersect{};
 	// no edge before size grip
 	const int iLastDiv = nParts - (hasSizeGrip ? 1 : 0);
@@ -2806,8 +3611,16 @@ static void paintStatusBar(HWND hWnd, HDC hdc, dmlib_subclass::StatusBarData& st
 	const bool drawEdge = (nParts >= 2 || !hasSizeGrip);
 	for (int i = 0; i < nParts; ++i)
 	{
-		::SendMessage(hWnd, SB_GETRECT, static_cast<WPARAM>(i), reinterpret_cast<LPARAM>(&rcPart));
-		if (::IntersectRect(&rcIntersect, &rcPart, &rcClient) == FALSE)
+		dmlib_subclass::StatusBarPart uncachedPart{};
+		auto& part = isCached ? parts[static_cast<size_t>(i)] : uncachedPart;
+		if (!isCached)
+		{
+			::SendMessage(hWnd, SB_GETRECT, static_cast<WPARAM>(i), reinterpret_cast<LPARAM>(&part.m_rcPart));
+		}
+
+		RECT rcPart{ part.m_rcPart };
+		if (::IntersectRect(&rcIntersect, &rcPart, &rcClient) == FALSE
+			|| ::IntersectRect(&rcIntersect, &rcPart, &rcPaint) == FALSE)
 		{
 			continue;
 		}
@@ -2824,34 +3637,15 @@ static void paintStatusBar(HWND hWnd, HDC hdc, dmlib_subclass::StatusBarData& st
 		rcPart.left += borders.between;
 		rcPart.right -= borders.vertical;
 
-		const LRESULT retValLen = ::SendMessage(hWnd, SB_GETTEXTLENGTH, static_cast<WPARAM>(i), 0);
-		const DWORD cchText = LOWORD(retValLen);
-
-		str.resize(static_cast<size_t>(cchText) + 1);
-		const LRESULT retValText = ::SendMessage(hWnd, SB_GETTEXT, static_cast<WPARAM>(i), reinterpret_cast<LPARAM>(str.data()));
-
-		// With `SBT_OWNERDRAW` flag parent will draw status bar.
-		if (cchText == 0 && (HIWORD(retValLen) & SBT_OWNERDRAW) != 0)
-		{
-			const auto id = static_cast<UINT>(::GetDlgCtrlID(hWnd));
-			DRAWITEMSTRUCT dis{
-				0
-				, 0
-				, static_cast<UINT>(i)
-				, ODA_DRAWENTIRE
-				, id
-				, hWnd
-				, hdc
-				, rcPart
-				, static_cast<ULONG_PTR>(retValText)
-			};
-
-			::SendMessage(::GetParent(hWnd), WM_DRAWITEM, id, reinterpret_cast<LPARAM>(&dis));
-		}
-		else
+		if (part.m_isTextValid)
 		{
-			::DrawText(hdc, str.c_str(), -1, &rcPart, DT_SINGLELINE | DT_VCENTER | DT_LEFT);
+			paintStatusBarPart(hWnd, hdc, i, part, part.m_text.c_str(), rcPart);
+			continue;
 		}
+
+		const LRESULT retValLen = ::SendMessage(hWnd, SB_GETTEXTLENGTH, static_cast<WPARAM>(i), 0);
+		auto str = dmlib_subclass::TextBuffer{ static_cast<size_t>(LOWORD(retValLen)) + 1 };
+		paintStatusBarPart(hWnd, hdc, i, part, updateStatusBarPartText(hWnd, i, retValLen, str, part), rcPart);
 	}
 
 #if 0 // for horizontal edge
@@ -2874,7 +3668,10 @@ static void paintStatusBar(HWND hWnd, HDC hdc, dmlib_subclass::StatusBarData& st
 			RECT rcGrip{ rcClient };
 			rcGrip.left = rcGrip.right - szGrip.cx;
 			rcGrip.top = rcGrip.bottom - szGrip.cy;
-			::DrawThemeBackground(hTheme, hdc, SP_GRIPPER, 0, &rcGrip, nullptr);
+			if (::IntersectRect(&rcIntersect, &rcGrip, &rcPaint) == TRUE)
+			{
+				::DrawThemeBackground(hTheme, hdc, SP_GRIPPER, 0, &rcGrip, nullptr);
+			}
 		}
 	}
 }
@@ -2902,6 +3699,17 @@ LRESULT CALLBACK dmlib_subclass::StatusBarSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_SIZE, WM_SETFONT,
+		WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED,
+		WM_SETTEXT, SB_SETTEXTA, SB_SETTEXTW, SB_SETPARTS,
+		SB_SETMINHEIGHT, SB_SIMPLE
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pStatusBarData = reinterpret_cast<StatusBarData*>(dwRefData);
 	auto& themeData = pStatusBarData->m_themeData;
 	const auto& hMemDC = pStatusBarData->m_bufferData.getHMemDC();
@@ -2910,7 +3718,7 @@ LRESULT CALLBACK dmlib_subclass::StatusBarSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, StatusBarSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, StatusBarSubclass, uIdSubclass);
 			std::unique_ptr<StatusBarData> u_ptrData(pStatusBarData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -2947,7 +3755,7 @@ LRESULT CALLBACK dmlib_subclass::StatusBarSubclass(
 			}
 
 			dmlib_paint::PaintWithBuffer<StatusBarData>(*pStatusBarData, hdc, ps,
-				[&]() { paintStatusBar(hWnd, hMemDC, *pStatusBarData); },
+				[&]() { paintStatusBar(hWnd, hMemDC, ps.rcPaint, *pStatusBarData); },
 				hWnd);
 
 			::EndPaint(hWnd, &ps);
@@ -2959,8 +3767,8 @@ LRESULT CALLBACK dmlib_subclass::StatusBarSubclass(
 		{
 			themeData.closeTheme();
 
-			const auto lf = LOGFONT{ dmlib_dpi::getSysFontForDpi(::GetParent(hWnd), dmlib_dpi::FontType::status) };
-			pStatusBarData->m_fontData.setFont(::CreateFontIndirectW(&lf));
+			pStatusBarData->updateFont(hWnd);
+			pStatusBarData->invalidateLayout();
 
 			if (uMsg != WM_THEMECHANGED)
 			{
@@ -2969,6 +3777,52 @@ LRESULT CALLBACK dmlib_subclass::StatusBarSubclass(
 			break;
 		}
 
+		case SB_SETTEXTW:
+		{
+			// Skip unchanged text, so caret moves with same text do not repaint the part.
+			const auto idx = static_cast<size_t>(LOBYTE(LOWORD(wParam)));
+			const auto type = static_cast<WORD>(LOWORD(wParam) & 0xFF00);
+			if (DarkMode::isEnabled()
+				&& pStatusBarData->m_isLayoutValid
+				&& idx < pStatusBarData->m_parts.size()
+				&& (type & SBT_OWNERDRAW) == 0
+				&& lParam != 0)
+			{
+				const auto& part = pStatusBarData->m_parts[idx];
+				if (part.m_isTextValid
+					&& part.m_type == type
+					&& part.m_text == reinterpret_cast<const wchar_t*>(lParam))
+				{
+					return TRUE;
+				}
+			}
+			pStatusBarData->invalidatePart(idx);
+			break;
+		}
+
+		case SB_SETTEXTA:
+		{
+			pStatusBarData->invalidatePart(static_cast<size_t>(LOBYTE(LOWORD(wParam))));
+			break;
+		}
+
+		case WM_SETTEXT:
+		{
+			// sets text of part 0
+			pStatusBarData->invalidatePart(0);
+			break;
+		}
+
+		case WM_SIZE:
+		case WM_SETFONT:
+		case SB_SETPARTS:
+		case SB_SETMINHEIGHT:
+		case SB_SIMPLE:
+		{
+			pStatusBarData->invalidateLayout();
+			break;
+		}
+
 		default:
 		{
 			break;
@@ -3002,7 +3856,7 @@ static void getProgressBarRects(HWND hWnd, RECT* rcEmpty, RECT* rcFilled) noexce
 	const int iMin = range.iLow;
 
 	const int currPos = pos - iMin;
-	if (currPos != 0)
+	if (currPos != 0 && range.iHigh != iMin)
 	{
 		const int totalWidth = rcEmpty->right - rcEmpty->left;
 		rcFilled->left = rcEmpty->left;
@@ -3014,6 +3868,141 @@ static void getProgressBarRects(HWND hWnd, RECT* rcEmpty, RECT* rcFilled) noexce
 	}
 }
 
+/**
+ * @brief Retrieves rectangle inside progress bar frame.
+ *
+ * @param[in]   hWnd    Handle to the progress bar control.
+ * @param[out]  rcBar   Receives client rectangle without frame.
+ */
+static void getProgressBarInnerRect(HWND hWnd, RECT& rcBar) noexcept
+{
+	::GetClientRect(hWnd, &rcBar);
+	::InflateRect(&rcBar, -1, -1);
+	rcBar.left = 1;
+}
+
+/**
+ * @brief Invalidates only the strip between previous and current fill edge.
+ *
+ * Whole bar is invalidated when previous edge is unknown.
+ *
+ * @param[in]       hWnd            Handle to the progress bar control.
+ * @param[in,out]   progressBarData Reference to the control's data, fill edge is updated.
+ * @return `true` if fill edge moved and some part was invalidated.
+ */
+static bool invalidateProgressBarFill(HWND hWnd, dmlib_subclass::ProgressBarData& progressBarData) noexcept
+{
+	RECT rcBar{};
+	getProgressBarInnerRect(hWnd, rcBar);
+
+	RECT rcFill{ rcBar.left, rcBar.top, rcBar.left, rcBar.bottom };
+	RECT rcEmpty{ rcBar };
+	getProgressBarRects(hWnd, &rcEmpty, &rcFill);
+
+	const int iOldEdge = progressBarData.m_iFillEdge;
+	const int iNewEdge = rcFill.right;
+	if (iOldEdge == iNewEdge)
+	{
+		return false;
+	}
+
+	if (iOldEdge >= 0)
+	{
+		rcBar.left = std::min(iOldEdge, iNewEdge);
+		rcBar.right = std::max(iOldEdge, iNewEdge);
+	}
+
+	progressBarData.m_iFillEdge = iNewEdge;
+	::InvalidateRect(hWnd, &rcBar, FALSE);
+	return true;
+}
+
+/**
+ * @brief Returns minimum interval between progress bar fill repaints.
+ *
+ * Interval matches refresh rate of the display, `USER_TIMER_MINIMUM`
+ * is used as lower bound and 60 Hz when rate is not known.
+ *
+ * @param[in] hWnd Handle to the progress bar control.
+ * @return Interval in milliseconds.
+ */
+[[nodiscard]] static UINT getProgressBarFrameInterval(HWND hWnd) noexcept
+{
+	int refreshRate = 0;
+	if (HDC hdc = ::GetDC(hWnd);
+		hdc != nullptr)
+	{
+		refreshRate = ::GetDeviceCaps(hdc, VREFRESH);
+		::ReleaseDC(hWnd, hdc);
+	}
+
+	static constexpr int kDefaultRefreshRate = 60;
+	if (refreshRate <= 1) // 0 and 1 mean default hardware rate
+	{
+		refreshRate = kDefaultRefreshRate;
+	}
+
+	return std::max<UINT>(static_cast<UINT>(1000 / refreshRate), USER_TIMER_MINIMUM);
+}
+
+/// Timer ID used to coalesce progress bar fill repaints.
+static constexpr UINT_PTR kProgressBarTimerID = 0x4450; // 'DP'
+
+/**
+ * @brief Repaints changed part of the progress bar fill at most once per display frame.
+ *
+ * First change is invalidated immediately and starts throttle timer,
+ * changes during the running timer are only marked and invalidated on `WM_TIMER`.
+ *
+ * @param[in]       hWnd            Handle to the progress bar control.
+ * @param[in,out]   progressBarData Reference to the control's data.
+ */
+static void scheduleProgressBarFill(HWND hWnd, dmlib_subclass::ProgressBarData& progressBarData) noexcept
+{
+	if (progressBarData.m_isTimerActive)
+	{
+		progressBarData.m_isFillDirty = true;
+		return;
+	}
+
+	if (!invalidateProgressBarFill(hWnd, progressBarData))
+	{
+		return;
+	}
+
+	if (progressBarData.m_frameInterval == 0)
+	{
+		progressBarData.m_frameInterval = getProgressBarFrameInterval(hWnd);
+	}
+
+	progressBarData.m_isTimerActive = ::SetTimer(hWnd, kProgressBarTimerID, progressBarData.m_frameInterval, nullptr) != 0;
+}
+
+/**
+ * @brief Forwards message to the progress bar and drops invalidation done by the control itself.
+ *
+ * Custom paint depends only on position, range and state, so redraws
+ * requested by the control (position change, state change, animation timers)
+ * are replaced by invalidating only the changed part.
+ * Update region pending before the message is kept.
+ *
+ * @param[in] hWnd      Handle to the progress bar control.
+ * @param[in] uMsg      Message identifier.
+ * @param[in] wParam    Message-specific data.
+ * @param[in] lParam    Message-specific data.
+ * @return Result of the default message processing.
+ */
+static LRESULT defProgressBarProcNoRedraw(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) noexcept
+{
+	const bool hasUpdate = ::GetUpdateRect(hWnd, nullptr, FALSE) == TRUE;
+	const LRESULT result = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	if (!hasUpdate)
+	{
+		::ValidateRect(hWnd, nullptr);
+	}
+	return result;
+}
+
 /**
  * @brief Custom paints a progress bar control with dark mode styling.
  *
@@ -3021,14 +4010,17 @@ static void getProgressBarRects(HWND hWnd, RECT* rcEmpty, RECT* rcFilled) noexce
  * brushes and themed drawing. Uses the current progress state to determine the
  * visual style (e.g., normal, paused, error).
  *
- * @param[in]   hWnd            Handle to the progress bar control.
- * @param[in]   hdc             Device context to paint into.
- * @param[in]   progressBarData Reference to the control's theme and state data.
+ * Records painted fill edge, so later position changes
+ * invalidate only the strip between old and new edge.
+ *
+ * @param[in]       hWnd            Handle to the progress bar control.
+ * @param[in]       hdc             Device context to paint into.
+ * @param[in,out]   progressBarData Reference to the control's theme and state data.
  *
  * @see ProgressBarData
  * @see DarkMode::getProgressBarRects()
  */
-static void paintProgressBar(HWND hWnd, HDC hdc, const dmlib_subclass::ProgressBarData& progressBarData) noexcept
+static void paintProgressBar(HWND hWnd, HDC hdc, dmlib_subclass::ProgressBarData& progressBarData) noexcept
 {
 	const auto& hTheme = progressBarData.m_themeData.getHTheme();
 
@@ -3040,8 +4032,9 @@ static void paintProgressBar(HWND hWnd, HDC hdc, const dmlib_subclass::ProgressB
 	::InflateRect(&rcClient, -1, -1);
 	rcClient.left = 1;
 
-	RECT rcFill{};
+	RECT rcFill{ rcClient.left, rcClient.top, rcClient.left, rcClient.bottom };
 	getProgressBarRects(hWnd, &rcClient, &rcFill);
+	progressBarData.m_iFillEdge = rcFill.right;
 	::DrawThemeBackground(hTheme, hdc, PP_FILL, progressBarData.m_iStateID, &rcFill, nullptr);
 	::FillRect(hdc, &rcClient, DarkMode::getCtrlBackgroundBrush());
 }
@@ -3103,6 +4096,16 @@ LRESULT CALLBACK dmlib_subclass::ProgressBarSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_TIMER,
+		WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED,
+		PBM_SETRANGE, PBM_SETPOS, PBM_DELTAPOS, PBM_STEPIT, PBM_SETRANGE32, PBM_SETSTATE
+	};
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pProgressBarData = reinterpret_cast<ProgressBarData*>(dwRefData);
 	auto& themeData = pProgressBarData->m_themeData;
 	const auto& hMemDC = pProgressBarData->m_bufferData.getHMemDC();
@@ -3111,7 +4114,11 @@ LRESULT CALLBACK dmlib_subclass::ProgressBarSubclass(
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, ProgressBarSubclass, uIdSubclass);
+			if (pProgressBarData->m_isTimerActive)
+			{
+				::KillTimer(hWnd, kProgressBarTimerID);
+			}
+			RemoveSubclassOnNcDestroy(hWnd, ProgressBarSubclass, uIdSubclass);
 			std::unique_ptr<ProgressBarData> u_ptrData(pProgressBarData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -3155,9 +4162,33 @@ LRESULT CALLBACK dmlib_subclass::ProgressBarSubclass(
 			return 0;
 		}
 
+		case WM_TIMER:
+		{
+			if (wParam == kProgressBarTimerID)
+			{
+				::KillTimer(hWnd, kProgressBarTimerID);
+				pProgressBarData->m_isTimerActive = false;
+				if (pProgressBarData->m_isFillDirty)
+				{
+					pProgressBarData->m_isFillDirty = false;
+					scheduleProgressBarFill(hWnd, *pProgressBarData);
+				}
+				return 0;
+			}
+
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			// animation timers of the control (smooth fill, marquee) do not change custom paint
+			return defProgressBarProcNoRedraw(hWnd, uMsg, wParam, lParam);
+		}
+
 		case WM_DPICHANGED_AFTERPARENT:
 		{
 			themeData.closeTheme();
+			pProgressBarData->m_frameInterval = 0; // can be on different display
 			return 0;
 		}
 
@@ -3167,10 +4198,49 @@ LRESULT CALLBACK dmlib_subclass::ProgressBarSubclass(
 			break;
 		}
 
+		case PBM_SETRANGE:
+		case PBM_SETPOS:
+		case PBM_DELTAPOS:
+		case PBM_STEPIT:
+		case PBM_SETRANGE32:
+		{
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			const LRESULT result = defProgressBarProcNoRedraw(hWnd, uMsg, wParam, lParam);
+			scheduleProgressBarFill(hWnd, *pProgressBarData);
+			return result;
+		}
+
 		case PBM_SETSTATE:
 		{
-			pProgressBarData->m_iStateID = getProgressBarState(wParam);
-			break;
+			const int iStateID = getProgressBarState(wParam);
+			const bool isChanged = iStateID != pProgressBarData->m_iStateID;
+			pProgressBarData->m_iStateID = iStateID;
+			if (!DarkMode::isEnabled())
+			{
+				break;
+			}
+
+			// state changes only fill color, empty part is kept
+			const LRESULT result = defProgressBarProcNoRedraw(hWnd, uMsg, wParam, lParam);
+			if (isChanged)
+			{
+				RECT rcFill{};
+				getProgressBarInnerRect(hWnd, rcFill);
+				if (pProgressBarData->m_iFillEdge >= 0)
+				{
+					rcFill.right = std::min(rcFill.right, pProgressBarData->m_iFillEdge);
+				}
+
+				if (dmlib_paint::isRectValid(rcFill))
+				{
+					::InvalidateRect(hWnd, &rcFill, FALSE);
+				}
+			}
+			return result;
 		}
 
 		default:
@@ -3204,13 +4274,19 @@ LRESULT CALLBACK dmlib_subclass::StaticTextSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_ENABLE };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pStaticTextData = reinterpret_cast<StaticTextData*>(dwRefData);
 
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, StaticTextSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, StaticTextSubclass, uIdSubclass);
 			std::unique_ptr<StaticTextData> u_ptrData(pStaticTextData);
 			u_ptrData.reset(nullptr);
 			break;
@@ -3318,11 +4394,17 @@ LRESULT CALLBACK dmlib_subclass::IPAddressSubclass(
 	[[maybe_unused]] DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT, WM_CTLCOLOREDIT };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, IPAddressSubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, IPAddressSubclass, uIdSubclass);
 			break;
 		}
 
@@ -3400,11 +4482,17 @@ LRESULT CALLBACK dmlib_subclass::HotKeySubclass(
 	[[maybe_unused]] DWORD_PTR dwRefData
 )
 {
+	static constexpr MsgFilter kMsgFilter{ WM_NCDESTROY, WM_ERASEBKGND, WM_PAINT };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, HotKeySubclass, uIdSubclass);
+			RemoveSubclassOnNcDestroy(hWnd, HotKeySubclass, uIdSubclass);
 			dmlib_hook::unhookSysColor();
 			break;
 		}
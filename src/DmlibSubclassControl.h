@@ -17,6 +17,9 @@
 #include <vsstyle.h>
 
 #include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 #include "DmlibDpi.h"
 #include "DmlibPaintHelper.h"
@@ -31,6 +34,28 @@ namespace DarkMode
 
 namespace dmlib_subclass
 {
+	/**
+	 * @struct ButtonLayout
+	 * @brief Cached layout of checkbox, radio, or tri-state button.
+	 *
+	 * Members:
+	 * - `m_rcBox` : Rectangle of the check box or radio glyph.
+	 * - `m_rcText` : Rectangle for the text.
+	 * - `m_rcFocus` : Focus rectangle around the measured text.
+	 * - `m_dtFlags` : `DrawText` flags derived from style and UI state.
+	 * - `m_uiState` : UI state from `WM_QUERYUISTATE`.
+	 * - `m_isValid` : Indicates whether the layout has to be recomputed.
+	 */
+	struct ButtonLayout
+	{
+		RECT m_rcBox{};
+		RECT m_rcText{};
+		RECT m_rcFocus{};
+		DWORD m_dtFlags = 0;
+		DWORD m_uiState = 0;
+		bool m_isValid = false;
+	};
+
 	/**
 	 * @struct ButtonData
 	 * @brief Stores button theming state and original size metadata.
@@ -42,6 +67,9 @@ namespace dmlib_subclass
 	 *
 	 * Members:
 	 * - `m_themeData` : RAII-managed theme handle for `VSCLASS_BUTTON`.
+	 * - `m_fontData` : Shared themed font for text drawing.
+	 * - `m_layout` : Cached layout for checkbox, radio, or tri-state button.
+	 * - `m_paintCache` : Last painted picture of checkbox, radio, or tri-state button.
 	 * - `m_szBtn` : Original size extracted from the button rectangle.
 	 * - `m_iStateID` : Current visual state ID (e.g. pressed, disabled, ...).
 	 * - `m_isSizeSet` : Indicates whether `m_szBtn` holds a valid measurement.
@@ -51,10 +79,16 @@ namespace dmlib_subclass
 	 *   is a checkbox/radio/tri-state type without `BS_MULTILINE`.
 	 *
 	 * @see ThemeData
+	 * @see FontData
+	 * @see ButtonLayout
+	 * @see PaintCache
 	 */
-	struct ButtonData
+	struct ButtonData : public PoolAllocated<ButtonData>
 	{
 		ThemeData m_themeData{ VSCLASS_BUTTON };
+		FontData m_fontData;
+		ButtonLayout m_layout;
+		PaintCache m_paintCache;
 		SIZE m_szBtn{};
 
 		int m_iStateID = 0;
@@ -96,6 +130,16 @@ namespace dmlib_subclass
 		}
 	};
 
+	/**
+	 * @brief Arrow buttons of up-down control used for hot and pressed state tracking.
+	 */
+	enum class UpDownPart : std::uint8_t
+	{
+		none,
+		prev,  ///< Up or left arrow button.
+		next   ///< Down or right arrow button.
+	};
+
 	/**
 	 * @struct UpDownData
 	 * @brief Stores layout and state for a owner drawn up-down (spinner) control.
@@ -109,7 +153,9 @@ namespace dmlib_subclass
 	 * - `m_rcPrev`, `m_rcNext`: Rectangles for the up/down or left/right arrow buttons.
 	 * - `m_cornerRoundness`: Optional roundness for corners (used in Windows 11+ with tabs).
 	 * - `m_isHorizontal`: `true` if the control is horizontal (`UDS_HORZ` style).
-	 * - `m_wasHotNext`: Last hover state (used for hover feedback).
+	 * - `m_hotPart`: Currently hovered arrow button.
+	 * - `m_pressedPart`: Currently pressed arrow button.
+	 * - `m_isTrackingMouse`: Indicates whether `WM_MOUSELEAVE` tracking is active.
 	 *
 	 * Constructor behavior:
 	 * - Detects orientation from `GWL_STYLE`.
@@ -119,11 +165,13 @@ namespace dmlib_subclass
 	 * Usage:
 	 * - `updateRect(HWND)`: Refreshes rectangle from control handle.
 	 * - `updateRect(RECT)`: Checks for rectangle change and updates it.
+	 * - `hitTest(POINT)`: Returns arrow button under the point.
 	 *
 	 * @see ThemeData
 	 * @see BufferData
+	 * @see UpDownPart
 	 */
-	struct UpDownData
+	struct UpDownData : public PoolAllocated<UpDownData>
 	{
 		ThemeData m_themeData{ VSCLASS_SPIN };
 		BufferData m_bufferData;
@@ -133,7 +181,9 @@ namespace dmlib_subclass
 		RECT m_rcNext{};
 		int m_cornerRoundness = 0;
 		bool m_isHorizontal = false;
-		bool m_wasHotNext = false;
+		UpDownPart m_hotPart = UpDownPart::none;
+		UpDownPart m_pressedPart = UpDownPart::none;
+		bool m_isTrackingMouse = false;
 
 		UpDownData() = delete;
 
@@ -200,20 +250,111 @@ namespace dmlib_subclass
 			}
 			return false;
 		}
+
+		[[nodiscard]] UpDownPart hitTest(POINT pt) const noexcept
+		{
+			if (::PtInRect(&m_rcPrev, pt) == TRUE)
+			{
+				return UpDownPart::prev;
+			}
+			if (::PtInRect(&m_rcNext, pt) == TRUE)
+			{
+				return UpDownPart::next;
+			}
+			return UpDownPart::none;
+		}
+	};
+
+	/**
+	 * @brief Behaviors handled by the single tab control subclass.
+	 *
+	 * @see TabSubclass()
+	 */
+	enum class TabBehavior : std::uint8_t
+	{
+		none   = 0,
+		paint  = 1 << 0,  ///< Owner drawn painting.
+		upDown = 1 << 1   ///< Detection and subclassing of up-down (spinner) child.
+	};
+
+	/**
+	 * @struct TabItem
+	 * @brief Cached rectangle, label, image, and state of single tab item.
+	 *
+	 * Members:
+	 * - `m_rcItem` : Item rectangle from `TCM_GETITEMRECT`.
+	 * - `m_label` : Item text.
+	 * - `m_iImage` : Image list index, `-1` if item has no image.
+	 * - `m_dwState` : Item state (`TCIS_HIGHLIGHTED`).
+	 * - `m_isLabelValid` : Indicates whether label, image, and state have to be retrieved again.
+	 */
+	struct TabItem
+	{
+		RECT m_rcItem{};
+		std::wstring m_label;
+		int m_iImage = -1;
+		DWORD m_dwState = 0;
+		bool m_isLabelValid = false;
 	};
 
 	/**
 	 * @struct TabData
-	 * @brief Simple wrapper for `BufferData`.
+	 * @brief Stores buffer data, enabled tab behaviors, and cached tab items.
 	 *
 	 * Members:
 	 * - `m_bufferData` : Buffer wrapper for flicker-free custom painting.
+	 * - `m_items` : Cached tab items.
+	 * - `m_iSelTab` : Selected tab for which item rectangles were retrieved.
+	 * - `m_iHotItem` : Currently hovered tab, `-1` if none.
+	 * - `m_behaviors` : Bitmask of enabled `TabBehavior` flags.
+	 * - `m_isLayoutValid` : Indicates whether item rectangles have to be retrieved again.
+	 * - `m_isTrackingMouse` : Indicates whether `WM_MOUSELEAVE` tracking is active.
+	 *
+	 * Usage:
+	 * - `invalidateLayout()`: Forces retrieval of item rectangles on next paint.
+	 * - `invalidateItems()`: Forces retrieval of item rectangles and all labels on next paint.
+	 * - `invalidateItem(int)`: Forces retrieval of item rectangles and single label on next paint.
 	 *
 	 * @see BufferData
+	 * @see TabItem
 	 */
-	struct TabData
+	struct TabData : public PoolAllocated<TabData>
 	{
 		BufferData m_bufferData;
+		std::vector<TabItem> m_items;
+		int m_iSelTab = -1;
+		int m_iHotItem = -1;
+		std::uint8_t m_behaviors = 0;
+		bool m_isLayoutValid = false;
+		bool m_isTrackingMouse = false;
+
+		[[nodiscard]] bool hasBehavior(TabBehavior behavior) const noexcept
+		{
+			return (m_behaviors & static_cast<std::uint8_t>(behavior)) != 0;
+		}
+
+		void invalidateLayout() noexcept
+		{
+			m_isLayoutValid = false;
+		}
+
+		void invalidateItems() noexcept
+		{
+			m_isLayoutValid = false;
+			for (auto& item : m_items)
+			{
+				item.m_isLabelValid = false;
+			}
+		}
+
+		void invalidateItem(int i) noexcept
+		{
+			m_isLayoutValid = false;
+			if (i >= 0 && static_cast<size_t>(i) < m_items.size())
+			{
+				m_items[static_cast<size_t>(i)].m_isLabelValid = false;
+			}
+		}
 	};
 
 	/**
@@ -234,7 +375,7 @@ namespace dmlib_subclass
 	 * @note Values are initialized from `GetSystemMetrics()` at construction time.
 	 *       Currently there is no dynamic handling for dpi changes.
 	 */
-	struct BorderMetricsData
+	struct BorderMetricsData : public PoolAllocated<BorderMetricsData>
 	{
 		UINT m_dpi = USER_DEFAULT_SCREEN_DPI;
 		LONG m_xEdge = ::GetSystemMetrics(SM_CXEDGE);
@@ -284,7 +425,7 @@ namespace dmlib_subclass
 	 * @see ThemeData
 	 * @see BufferData
 	 */
-	struct ComboBoxData
+	struct ComboBoxData : public PoolAllocated<ComboBoxData>
 	{
 		ThemeData m_themeData{ VSCLASS_COMBOBOX };
 		BufferData m_bufferData;
@@ -311,8 +452,8 @@ namespace dmlib_subclass
 	 * - `m_themeData` : RAII-managed theme handle for `VSCLASS_HEADER`.
 	 * - `m_bufferData` : Buffer wrapper for flicker-free custom painting.
 	 * - `m_fontData` : Font resource wrapper for text drawing.
-	 * - `m_pt` : Last known mouse position in client coordinates (LONG_MIN if uninitialized).
-	 * - `m_isHot` : True if the mouse is currently over a header item.
+	 * - `m_iHotItem` : Index of the hovered header item, `-1` if none.
+	 * - `m_isHot` : True if the mouse is currently tracked over the header.
 	 * - `m_hasBtnStyle` : True if the header uses button-style items (`HDF_BUTTON`).
 	 * - `m_isPressed` : True if a header item is currently pressed.
 	 *
@@ -324,13 +465,13 @@ namespace dmlib_subclass
 	 * @see BufferData
 	 * @see FontData
 	 */
-	struct HeaderData
+	struct HeaderData : public PoolAllocated<HeaderData>
 	{
 		ThemeData m_themeData{ VSCLASS_HEADER };
 		BufferData m_bufferData;
 		FontData m_fontData{ nullptr };
 
-		POINT m_pt{ LONG_MIN, LONG_MIN };
+		int m_iHotItem = -1;
 		bool m_isHot = false;
 		bool m_hasBtnStyle = true;
 		bool m_isPressed = false;
@@ -342,6 +483,26 @@ namespace dmlib_subclass
 		{}
 	};
 
+	/**
+	 * @struct StatusBarPart
+	 * @brief Cached rectangle and text of single status bar part.
+	 *
+	 * Members:
+	 * - `m_rcPart` : Part rectangle from `SB_GETRECT`.
+	 * - `m_text` : Part text from `SB_GETTEXT`.
+	 * - `m_itemData` : Value returned by `SB_GETTEXT`, item data for owner drawn parts.
+	 * - `m_type` : Drawing type (`SBT_*` flags) from `SB_GETTEXTLENGTH`.
+	 * - `m_isTextValid` : Indicates whether text has to be retrieved again.
+	 */
+	struct StatusBarPart
+	{
+		RECT m_rcPart{};
+		std::wstring m_text;
+		LRESULT m_itemData = 0;
+		WORD m_type = 0;
+		bool m_isTextValid = false;
+	};
+
 	/**
 	 * @struct StatusBarData
 	 * @brief Stores theme, buffer, and font data for a status bar control.
@@ -352,26 +513,62 @@ namespace dmlib_subclass
 	 * - `m_themeData` : RAII-managed theme handle for `VSCLASS_HEADER`.
 	 * - `m_bufferData` : Buffer wrapper for flicker-free custom painting.
 	 * - `m_fontData` : Font resource wrapper for text drawing.
+	 * - `m_parts` : Cached rectangles and texts of parts.
+	 * - `m_isLayoutValid` : Indicates whether part rectangles have to be retrieved again.
 	 *
 	 * Constructor behavior:
 	 * - Deleted default constructor to enforce explicit font initialization.
-	 * - Explicit constructor taking `HFONT` to initialize `m_fontData`.
+	 * - Explicit constructor taking `HWND` to initialize `m_fontData`
+	 *   with shared system status font for the parent's DPI.
+	 *
+	 * Usage:
+	 * - `updateFont(HWND)`: Replaces the font on theme or DPI change.
+	 * - `invalidateLayout()`: Forces retrieval of all parts on next paint.
+	 * - `invalidatePart(size_t)`: Forces retrieval of single part's text on next paint.
 	 *
 	 * @see ThemeData
 	 * @see BufferData
 	 * @see FontData
+	 * @see StatusBarPart
 	 */
-	struct StatusBarData
+	struct StatusBarData : public PoolAllocated<StatusBarData>
 	{
 		ThemeData m_themeData{ VSCLASS_STATUS };
 		BufferData m_bufferData;
 		FontData m_fontData;
+		std::vector<StatusBarPart> m_parts;
+		bool m_isLayoutValid = false;
 
 		StatusBarData() = delete;
 
-		explicit StatusBarData(const HFONT& hFont) noexcept
-			: m_fontData(hFont)
-		{}
+		explicit StatusBarData(HWND hWnd) noexcept
+		{
+			StatusBarData::updateFont(hWnd);
+		}
+
+		void updateFont(HWND hWnd) noexcept
+		{
+			const auto lf = LOGFONT{ dmlib_dpi::getSysFontForDpi(::GetParent(hWnd), dmlib_dpi::FontType::status) };
+			m_fontData.invalidateFont();
+			m_fontData.setSharedFont(lf, dmlib_dpi::GetDpiForParent(hWnd));
+		}
+
+		void invalidateLayout() noexcept
+		{
+			m_isLayoutValid = false;
+		}
+
+		void invalidatePart(size_t idx) noexcept
+		{
+			if (idx < m_parts.size())
+			{
+				m_parts[idx].m_isTextValid = false;
+			}
+			else
+			{
+				m_isLayoutValid = false;
+			}
+		}
 	};
 
 	/**
@@ -383,8 +580,12 @@ namespace dmlib_subclass
 	 *
 	 * Members:
 	 * - `m_themeData` : RAII-managed theme handle for `VSCLASS_PROGRESS`.
-	 * - `m_bufferData` : Buffer wrapper for flicker-free custom painting.
+	 * - `m_bufferData` : Per-control buffer wrapper for flicker-free custom painting, progress bar repaints often.
 	 * - `m_iStateID` : Current progress bar state (e.g., `PBFS_NORMAL`, `PBFS_PAUSED`, `PBFS_ERROR`, `PBFS_PARTIAL`).
+	 * - `m_iFillEdge` : Right edge of the fill which is painted or already invalidated, `-1` if unknown.
+	 * - `m_frameInterval` : Minimum interval in ms between fill repaints, `0` until queried from display refresh rate.
+	 * - `m_isTimerActive` : Whether repaint throttle timer is running.
+	 * - `m_isFillDirty` : Whether position changed while throttle timer was running.
 	 *
 	 * Constructor behavior:
 	 * - Initializes `m_iStateID` by querying the control with `PBM_GETSTATE`.
@@ -392,12 +593,16 @@ namespace dmlib_subclass
 	 * @see ThemeData
 	 * @see BufferData
 	 */
-	struct ProgressBarData
+	struct ProgressBarData : public PoolAllocated<ProgressBarData>
 	{
 		ThemeData m_themeData{ VSCLASS_PROGRESS };
-		BufferData m_bufferData;
+		BufferData m_bufferData{ false };
 
 		int m_iStateID = PBFS_PARTIAL;
+		int m_iFillEdge = -1;
+		UINT m_frameInterval = 0;
+		bool m_isTimerActive = false;
+		bool m_isFillDirty = false;
 
 		explicit ProgressBarData(HWND hWnd) noexcept
 			: m_iStateID(static_cast<int>(::SendMessage(hWnd, PBM_GETSTATE, 0, 0)))
@@ -418,7 +623,7 @@ namespace dmlib_subclass
 	 * - Default constructor initializes `m_isEnabled` to `true`.
 	 * - Explicit constructor queries the control's enabled state via `IsWindowEnabled(hWnd)`.
 	 */
-	struct StaticTextData
+	struct StaticTextData : public PoolAllocated<StaticTextData>
 	{
 		bool m_isEnabled = true;
 
@@ -432,8 +637,7 @@ namespace dmlib_subclass
 	LRESULT CALLBACK ButtonSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK GroupboxSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK UpDownSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK TabPaintSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK TabUpDownSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
+	LRESULT CALLBACK TabSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK CustomBorderSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK ComboBoxSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK ComboBoxExSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
@@ -444,4 +648,9 @@ namespace dmlib_subclass
 	LRESULT CALLBACK StaticTextSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK IPAddressSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
 	LRESULT CALLBACK HotKeySubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
+
+	/// Enables tab behavior, installs tab subclass if it is not installed yet.
+	void setTabBehavior(HWND hWnd, TabBehavior behavior);
+	/// Disables tab behavior, removes tab subclass when no behavior is left.
+	void removeTabBehavior(HWND hWnd, TabBehavior behavior);
 } // namespace dmlib_subclass
@@ -23,6 +23,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "DarkModeSubclass.h"
 #include "DmlibDpi.h"
@@ -34,7 +35,7 @@
 #include "UAHMenuBar.h"
 
 /**
- * @brief Window subclass procedure for handling `WM_ERASEBKGND` message.
+ * @brief Handles `WM_ERASEBKGND` message for the `eraseBg` window behavior.
  *
  * Handles `WM_ERASEBKGND` to fill the window's client area with the custom color brush,
  * preventing default light gray flicker or mismatched fill.
@@ -43,30 +44,15 @@
  * @param[in]   uMsg        Message identifier.
  * @param[in]   wParam      Message-specific data.
  * @param[in]   lParam      Message-specific data.
- * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   Reserved data (unused).
  * @return LRESULT Result of message processing.
  *
  * @see DarkMode::setWindowEraseBgSubclass()
  * @see DarkMode::removeWindowEraseBgSubclass()
  */
-LRESULT CALLBACK dmlib_subclass::WindowEraseBgSubclass(
-	HWND hWnd,
-	UINT uMsg,
-	WPARAM wParam,
-	LPARAM lParam,
-	UINT_PTR uIdSubclass,
-	[[maybe_unused]] DWORD_PTR dwRefData
-)
+static LRESULT onWindowEraseBg(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
 	switch (uMsg)
 	{
-		case WM_NCDESTROY:
-		{
-			::RemoveWindowSubclass(hWnd, WindowEraseBgSubclass, uIdSubclass);
-			break;
-		}
-
 		case WM_ERASEBKGND:
 		{
 			if (!DarkMode::isEnabled())
@@ -113,17 +99,17 @@ static LRESULT onCtlColorStaticHelper(LPARAM lParam, WPARAM wParam)
 		return DarkMode::onCtlColorDlgLinkText(hdc, isChildEnabled);
 	}
 
-	if (DWORD_PTR dwRefDataStaticText = 0;
-		::GetWindowSubclass(hChild, dmlib_subclass::StaticTextSubclass, static_cast<UINT_PTR>(dmlib_subclass::SubclassID::staticText), &dwRefDataStaticText) == TRUE)
+	if (const auto* pStaticTextData = dmlib_subclass::getSubclassData<dmlib_subclass::StaticTextData>(hChild, dmlib_subclass::SubclassID::staticText);
+		pStaticTextData != nullptr)
 	{
-		const bool isTextEnabled = (reinterpret_cast<dmlib_subclass::StaticTextData*>(dwRefDataStaticText))->m_isEnabled;
+		const bool isTextEnabled = pStaticTextData->m_isEnabled;
 		return DarkMode::onCtlColorDlgStaticText(hdc, isTextEnabled);
 	}
 	return DarkMode::onCtlColorDlg(hdc);
 }
 
 /**
- * @brief Window subclass procedure for handling `WM_CTLCOLOR*` messages.
+ * @brief Handles `WM_CTLCOLOR*` messages for the `ctlColor` window behavior.
  *
  * Handles control drawing messages to apply foreground and background
  * styling based on control type and class.
@@ -132,16 +118,12 @@ static LRESULT onCtlColorStaticHelper(LPARAM lParam, WPARAM wParam)
  * - `WM_CTLCOLOREDIT`, `WM_CTLCOLORLISTBOX`, `WM_CTLCOLORDLG`, `WM_CTLCOLORSTATIC`
  * - `WM_PRINTCLIENT` for removing light border for push buttons in dark mode
  *
- * Cleans up subclass on `WM_NCDESTROY`
- *
  * Uses `DarkMode::onCtlColor*` utilities.
  *
  * @param[in]   hWnd        Window handle being subclassed.
  * @param[in]   uMsg        Message identifier.
  * @param[in]   wParam      Message-specific data.
  * @param[in]   lParam      Message-specific data.
- * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   Reserved data (unused).
  * @return LRESULT Result of message processing.
  *
  * @see DarkMode::onCtlColor()
@@ -150,23 +132,10 @@ static LRESULT onCtlColorStaticHelper(LPARAM lParam, WPARAM wParam)
  * @see DarkMode::onCtlColorDlgLinkText()
  * @see DarkMode::onCtlColorListbox()
  */
-LRESULT CALLBACK dmlib_subclass::WindowCtlColorSubclass(
-	HWND hWnd,
-	UINT uMsg,
-	WPARAM wParam,
-	LPARAM lParam,
-	UINT_PTR uIdSubclass,
-	[[maybe_unused]] DWORD_PTR dwRefData
-)
+static LRESULT onWindowCtlColor(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
 	switch (uMsg)
 	{
-		case WM_NCDESTROY:
-		{
-			::RemoveWindowSubclass(hWnd, WindowCtlColorSubclass, uIdSubclass);
-			break;
-		}
-
 		case WM_CTLCOLOREDIT:
 		{
 			if (!DarkMode::isEnabled())
@@ -371,11 +340,10 @@ LRESULT CALLBACK dmlib_subclass::WindowCtlColorSubclass(
 	rcArrow.bottom -= dmlib_dpi::scale(3, lptbcd->nmcd.hdr.hwndFrom);
 
 	::SetBkMode(lptbcd->nmcd.hdc, TRANSPARENT);
-	::SetTextColor(lptbcd->nmcd.hdc, DarkMode::getTextColor());
 
 	const auto hFont = dmlib_paint::GdiObject{ lptbcd->nmcd.hdc, lptbcd->nmcd.hdr.hwndFrom };
 	static constexpr UINT dtFlags = DT_CENTER | DT_VCENTER | DT_SINGLELINE | DT_NOCLIP | DT_NOPREFIX;
-	::DrawText(lptbcd->nmcd.hdc, dmlib_glyph::kTriangleDown, -1, &rcArrow, dtFlags);
+	dmlib_glyph::drawGlyph(lptbcd->nmcd.hdc, dmlib_glyph::kTriangleDown, rcArrow, dtFlags, DarkMode::getTextColor());
 
 	return CDRF_DODEFAULT;
 }
@@ -851,12 +819,12 @@ static void postpaintTreeViewItem(const LPNMTVCUSTOMDRAW& lptvcd) noexcept
 				dmlib_paint::paintRoundRect(lpnmcd->hdc, rbBand.rcChevronLocation, DarkMode::getEdgePen(), DarkMode::getCtrlBackgroundBrush(), roundness, roundness);
 			}
 
-			::SetTextColor(lpnmcd->hdc, isHot ? DarkMode::getTextColor() : DarkMode::getDarkerTextColor());
 			::SetBkMode(lpnmcd->hdc, TRANSPARENT);
 
 			const auto hFont = dmlib_paint::GdiObject{ lpnmcd->hdc, lpnmcd->hdr.hwndFrom };
 			static constexpr UINT dtFlags = DT_CENTER | DT_TOP | DT_SINGLELINE | DT_NOCLIP | DT_NOPREFIX;
-			::DrawText(lpnmcd->hdc, dmlib_glyph::kChevron, -1, &rbBand.rcChevronLocation, dtFlags);
+			const COLORREF clrChevron = isHot ? DarkMode::getTextColor() : DarkMode::getDarkerTextColor();
+			dmlib_glyph::drawGlyph(lpnmcd->hdc, dmlib_glyph::kChevron, rbBand.rcChevronLocation, dtFlags, clrChevron);
 		}
 
 		// paints gripper edge
@@ -924,7 +892,7 @@ static void postpaintTreeViewItem(const LPNMTVCUSTOMDRAW& lptvcd) noexcept
  * @param[in]   lParam      Message-specific data.
  * @return LRESULT Result of message processing.
  *
- * @see dmlib_subclass::WindowNotifySubclass()
+ * @see onWindowNotify()
  */
 static LRESULT onNotifyCustomDraw(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
@@ -962,7 +930,7 @@ static LRESULT onNotifyCustomDraw(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lP
 }
 
 /**
- * @brief Window subclass procedure for handling `WM_NOTIFY` message for custom draw for supported controls.
+ * @brief Handles `WM_NOTIFY` message for the `notify` window behavior.
  *
  * Handles `WM_NOTIFY` for custom draw for supported controls:
  * - toolbar, list view, tree view, trackbar, and rebar.
@@ -971,31 +939,16 @@ static LRESULT onNotifyCustomDraw(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lP
  * @param[in]   uMsg        Message identifier.
  * @param[in]   wParam      Message-specific data.
  * @param[in]   lParam      Message-specific data.
- * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   Reserved data (unused).
  * @return LRESULT Result of message processing.
  *
  * @see onNotifyCustomDraw()
  * @see DarkMode::setWindowNotifyCustomDrawSubclass()
  * @see DarkMode::removeWindowNotifyCustomDrawSubclass()
  */
-LRESULT CALLBACK dmlib_subclass::WindowNotifySubclass(
-	HWND hWnd,
-	UINT uMsg,
-	WPARAM wParam,
-	LPARAM lParam,
-	UINT_PTR uIdSubclass,
-	[[maybe_unused]] DWORD_PTR dwRefData
-)
+static LRESULT onWindowNotify(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
 	switch (uMsg)
 	{
-		case WM_NCDESTROY:
-		{
-			::RemoveWindowSubclass(hWnd, WindowNotifySubclass, uIdSubclass);
-			break;
-		}
-
 		case WM_NOTIFY:
 		{
 			if (!DarkMode::isEnabled())
@@ -1015,64 +968,195 @@ LRESULT CALLBACK dmlib_subclass::WindowNotifySubclass(
 }
 
 
+/**
+ * @struct MenuBarItem
+ * @brief Cached text and measured text extent of single menu bar item.
+ */
+struct MenuBarItem
+{
+	std::wstring m_text;
+	SIZE m_szText{};
+	bool m_isValid = false;
+};
+
+/**
+ * @struct MenuBarData
+ * @brief Theme data, bar geometry and item cache for the `menuBar` window behavior.
+ *
+ * Members:
+ * - `m_themeData`: Theme data with "Menu" theme class.
+ * - `m_hMenu`: Menu the cache belongs to, cache is dropped when menu changes.
+ * - `m_items`: Cached items indexed by menu bar position.
+ * - `m_rcBar`: Menu bar rectangle relative to the window rectangle.
+ * - `m_isBarValid`: Indicates whether `m_rcBar` is up to date.
+ *
+ * Item cache is invalidated on `WM_INITMENU`, `WM_UAHMEASUREMENUITEM`,
+ * DPI and theme change, bar geometry also on `WM_NCCALCSIZE`
+ * (window resize and `DrawMenuBar`).
+ */
+struct MenuBarData
+{
+	dmlib_subclass::ThemeData m_themeData{ VSCLASS_MENU };
+	HMENU m_hMenu = nullptr;
+	std::vector<MenuBarItem> m_items;
+	RECT m_rcBar{};
+	bool m_isBarValid = false;
+
+	void invalidate() noexcept
+	{
+		m_isBarValid = false;
+		for (auto& item : m_items)
+		{
+			item.m_isValid = false;
+		}
+	}
+
+	void setMenu(HMENU hMenu) noexcept
+	{
+		if (m_hMenu != hMenu)
+		{
+			m_hMenu = hMenu;
+			m_items.clear();
+			m_isBarValid = false;
+		}
+	}
+};
+
+/**
+ * @brief Retrieves cached menu bar rectangle relative to the window rectangle.
+ *
+ * Uses `GetMenuBarInfo` and `GetWindowRect` only when the cached rectangle is invalid.
+ *
+ * @param[in]       hWnd            Handle to the window with a menu bar.
+ * @param[in,out]   menuBarData     Menu bar cache.
+ * @return Reference to the cached rectangle, empty if the window has no menu bar.
+ */
+static const RECT& getMenuBarRect(HWND hWnd, MenuBarData& menuBarData) noexcept
+{
+	if (!menuBarData.m_isBarValid)
+	{
+		MENUBARINFO mbi{};
+		mbi.cbSize = sizeof(MENUBARINFO);
+		if (::GetMenuBarInfo(hWnd, OBJID_MENU, 0, &mbi) == FALSE)
+		{
+			menuBarData.m_rcBar = {};
+		}
+		else
+		{
+			RECT rcWindow{};
+			::GetWindowRect(hWnd, &rcWindow);
+
+			// the rcBar is offset by the window rect
+			menuBarData.m_rcBar = mbi.rcBar;
+			::OffsetRect(&menuBarData.m_rcBar, -rcWindow.left, -rcWindow.top);
+		}
+		menuBarData.m_isBarValid = true;
+	}
+	return menuBarData.m_rcBar;
+}
+
 /**
  * @brief Fills the menu bar background custom color.
  *
- * Uses `GetMenuBarInfo` and `GetWindowRect` to compute the menu bar rectangle
- * in client-relative coordinates, then fills it with @ref DarkMode::getDlgBackgroundBrush.
+ * Uses cached menu bar rectangle in window-relative coordinates,
+ * then fills it with @ref DarkMode::getDlgBackgroundBrush.
  *
- * @param[in]   hWnd    Handle to the window with a menu bar.
- * @param[in]   hdc     Target device context for painting.
+ * @param[in]       hWnd        Handle to the window with a menu bar.
+ * @param[in]       UDM         Reference to `UAHMENU` struct from `WM_UAHDRAWMENU`.
+ * @param[in,out]   menuBarData Menu bar cache.
  *
  * @note Offsets top slightly to account for non-client overlap.
  *
- * @see dmlib_subclass::WindowMenuBarSubclass()
+ * @see onWindowMenuBar()
+ * @see getMenuBarRect()
  */
-static void paintMenuBar(HWND hWnd, HDC hdc) noexcept
+static void paintMenuBar(HWND hWnd, const UAHMENU& UDM, MenuBarData& menuBarData) noexcept
 {
-	// get the menubar rect
-	MENUBARINFO mbi{};
-	mbi.cbSize = sizeof(MENUBARINFO);
-	::GetMenuBarInfo(hWnd, OBJID_MENU, 0, &mbi);
-
-	RECT rcWindow{};
-	::GetWindowRect(hWnd, &rcWindow);
-
-	// the rcBar is offset by the window rect
-	RECT rcBar{ mbi.rcBar };
-	::OffsetRect(&rcBar, -rcWindow.left, -rcWindow.top);
+	menuBarData.setMenu(UDM.hmenu);
 
+	RECT rcBar{ getMenuBarRect(hWnd, menuBarData) };
 	rcBar.top -= 1;
 
-	::FillRect(hdc, &rcBar, DarkMode::getDlgBackgroundBrush());
+	::FillRect(UDM.hdc, &rcBar, DarkMode::getDlgBackgroundBrush());
 }
 
 /**
- * @brief Paints a single menu bar item with custom colors based on state.
- *
- * Measures and draws menu item text using `DrawThemeTextEx`, and
- * fills background using appropriate brush based on `ODS_*` item state.
+ * @brief Retrieves cached menu bar item, refreshing it if invalid.
  *
- * @param[in,out]   UDMI    Reference to `UAHDRAWMENUITEM` struct from `WM_UAHDRAWMENUITEM`.
- * @param[in]       hTheme  The themed handle to `VSCLASS_MENU` (via @ref ThemeData).
+ * Item string is retrieved with `GetMenuItemInfoW` and its extent
+ * is measured with `GetThemeTextExtent` only on cache miss.
  *
- * @see dmlib_subclass::WindowMenuBarSubclass()
+ * @param[in]       UDMI        Reference to `UAHDRAWMENUITEM` struct from `WM_UAHDRAWMENUITEM`.
+ * @param[in]       hTheme      The themed handle to `VSCLASS_MENU`.
+ * @param[in,out]   menuBarData Menu bar cache.
+ * @return Reference to the cached item.
  */
-static void paintMenuBarItems(UAHDRAWMENUITEM& UDMI, const HTHEME& hTheme)
+static const MenuBarItem& getMenuBarItem(const UAHDRAWMENUITEM& UDMI, HTHEME hTheme, MenuBarData& menuBarData)
 {
+	menuBarData.setMenu(UDMI.um.hmenu);
+
+	const auto idx = static_cast<size_t>(UDMI.umi.iPosition);
+	if (idx >= menuBarData.m_items.size())
+	{
+		menuBarData.m_items.resize(idx + 1);
+	}
+
+	auto& item = menuBarData.m_items[idx];
+	if (item.m_isValid)
+	{
+		return item;
+	}
+
 	// get the menu item string
-	std::wstring buffer(MAX_PATH, L'\0');
+	auto buffer = dmlib_subclass::TextBuffer{ MAX_PATH };
 	MENUITEMINFO mii{};
 	mii.cbSize = sizeof(MENUITEMINFO);
 	mii.fMask = MIIM_STRING;
 	mii.dwTypeData = buffer.data();
-	mii.cch = MAX_PATH - 1;
+	mii.cch = static_cast<UINT>(buffer.size());
+
+	if (::GetMenuItemInfoW(UDMI.um.hmenu, static_cast<UINT>(UDMI.umi.iPosition), TRUE, &mii) == TRUE)
+	{
+		item.m_text.assign(buffer.c_str(), mii.cch);
+	}
+	else
+	{
+		item.m_text.clear();
+	}
+
+	RECT rcExtent{};
+	::GetThemeTextExtent(hTheme, UDMI.um.hdc, MENU_BARITEM, MBI_NORMAL, item.m_text.c_str(), static_cast<int>(item.m_text.size()), DT_SINGLELINE, nullptr, &rcExtent);
+	item.m_szText = { rcExtent.right - rcExtent.left, rcExtent.bottom - rcExtent.top };
+	item.m_isValid = true;
+
+	return item;
+}
+
+/**
+ * @brief Paints a single menu bar item with custom colors based on state.
+ *
+ * Draws cached menu item text using `DrawThemeTextEx` centered by cached extent,
+ * and fills background using appropriate brush based on `ODS_*` item state.
+ *
+ * @param[in,out]   UDMI        Reference to `UAHDRAWMENUITEM` struct from `WM_UAHDRAWMENUITEM`.
+ * @param[in]       hTheme      The themed handle to `VSCLASS_MENU` (via @ref ThemeData).
+ * @param[in,out]   menuBarData Menu bar cache.
+ *
+ * @see onWindowMenuBar()
+ * @see getMenuBarItem()
+ */
+static void paintMenuBarItems(UAHDRAWMENUITEM& UDMI, const HTHEME& hTheme, MenuBarData& menuBarData)
+{
+	if (UDMI.umi.iPosition < 0)
+	{
+		return;
+	}
 
-	::GetMenuItemInfoW(UDMI.um.hmenu, static_cast<UINT>(UDMI.umi.iPosition), TRUE, &mii);
+	const auto& item = getMenuBarItem(UDMI, hTheme, menuBarData);
 
 	// get the item state for drawing
 
-	DWORD dwFlags = DT_CENTER | DT_SINGLELINE | DT_VCENTER;
+	DWORD dwFlags = DT_SINGLELINE;
 
 	int iTextStateID = MBI_NORMAL;
 	int iBackgroundStateID = MBI_NORMAL;
@@ -1165,24 +1249,37 @@ static void paintMenuBarItems(UAHDRAWMENUITEM& UDMI, const HTHEME& hTheme)
 		}
 	}
 
-	::DrawThemeTextEx(hTheme, UDMI.um.hdc, MENU_BARITEM, iTextStateID, buffer.c_str(), static_cast<int>(mii.cch), dwFlags, &UDMI.dis.rcItem, &dttopts);
+	// center text by cached extent, no need for text layout with DT_CENTER | DT_VCENTER
+	const RECT& rcItem = UDMI.dis.rcItem;
+	RECT rcText{ rcItem };
+	if (const LONG cx = rcItem.right - rcItem.left; item.m_szText.cx < cx)
+	{
+		rcText.left += (cx - item.m_szText.cx) / 2;
+		rcText.right = rcText.left + item.m_szText.cx;
+	}
+	if (const LONG cy = rcItem.bottom - rcItem.top; item.m_szText.cy < cy)
+	{
+		rcText.top += (cy - item.m_szText.cy) / 2;
+		rcText.bottom = rcText.top + item.m_szText.cy;
+	}
+
+	::DrawThemeTextEx(hTheme, UDMI.um.hdc, MENU_BARITEM, iTextStateID, item.m_text.c_str(), static_cast<int>(item.m_text.size()), dwFlags, &rcText, &dttopts);
 }
 
 /**
  * @brief Over-paints the 1-pixel light line under a menu bar with custom color.
  *
  * Called post-paint to overwrite non-client leftovers that break custom color styling.
- * Computes exact line position based on `MenuBarInfo`, and fills with custom color.
+ * Computes exact line position based on client rectangle, and fills with custom color.
  *
- * @param[in] hWnd Handle to the window with a menu bar.
+ * @param[in]       hWnd        Handle to the window with a menu bar.
+ * @param[in,out]   menuBarData Menu bar cache, used to check if the window has menu bar.
  *
- * @see dmlib_subclass::WindowMenuBarSubclass()
+ * @see onWindowMenuBar()
  */
-static void drawUAHMenuNCBottomLine(HWND hWnd) noexcept
+static void drawUAHMenuNCBottomLine(HWND hWnd, MenuBarData& menuBarData) noexcept
 {
-	MENUBARINFO mbi{};
-	mbi.cbSize = sizeof(MENUBARINFO);
-	if (::GetMenuBarInfo(hWnd, OBJID_MENU, 0, &mbi) == FALSE)
+	if (::IsRectEmpty(&getMenuBarRect(hWnd, menuBarData)) == TRUE)
 	{
 		return;
 	}
@@ -1208,7 +1305,7 @@ static void drawUAHMenuNCBottomLine(HWND hWnd) noexcept
 }
 
 /**
- * @brief Window subclass procedure for custom color for themed menu bar.
+ * @brief Handles menu bar messages for the `menuBar` window behavior.
  *
  * Applies custom colors for menu bar, but not for popup menus.
  *
@@ -1216,129 +1313,304 @@ static void drawUAHMenuNCBottomLine(HWND hWnd) noexcept
  * @param[in]   uMsg        Message identifier.
  * @param[in]   wParam      Message-specific data.
  * @param[in]   lParam      Message-specific data.
- * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   ThemeData instance.
+ * @param[in,out] menuBarData Theme data with "Menu" theme class and menu bar cache.
  * @return LRESULT Result of message processing.
  *
  * @see DarkMode::setWindowMenuBarSubclass()
  * @see DarkMode::removeWindowMenuBarSubclass()
  */
-LRESULT CALLBACK dmlib_subclass::WindowMenuBarSubclass(
-	HWND hWnd,
-	UINT uMsg,
-	WPARAM wParam,
-	LPARAM lParam,
-	UINT_PTR uIdSubclass,
-	DWORD_PTR dwRefData
-)
+static LRESULT onWindowMenuBar(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, MenuBarData& menuBarData)
 {
-	auto* pMenuThemeData = reinterpret_cast<ThemeData*>(dwRefData);
+	// cache invalidation is needed also while dark mode is disabled
+	switch (uMsg)
+	{
+		case WM_INITMENU:
+		{
+			menuBarData.invalidate();
+			return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WM_UAHMEASUREMENUITEM:
+		{
+			const auto* pMMI = reinterpret_cast<UAHMEASUREMENUITEM*>(lParam);
+			if (const auto idx = static_cast<size_t>(pMMI->umi.iPosition);
+				pMMI->um.hmenu == menuBarData.m_hMenu && idx < menuBarData.m_items.size())
+			{
+				menuBarData.m_items[idx].m_isValid = false;
+			}
+			menuBarData.m_isBarValid = false;
+			return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WM_NCCALCSIZE:
+		{
+			menuBarData.m_isBarValid = false;
+			return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WM_DPICHANGED:
+		case WM_DPICHANGED_AFTERPARENT:
+		case WM_THEMECHANGED:
+		{
+			menuBarData.m_themeData.closeTheme();
+			menuBarData.invalidate();
+			return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+		}
+
+		default:
+		{
+			break;
+		}
+	}
 
-	if (uMsg != WM_NCDESTROY && (!DarkMode::isEnabled() || !pMenuThemeData->ensureTheme(hWnd)))
+	if (!DarkMode::isEnabled() || !menuBarData.m_themeData.ensureTheme(hWnd))
 	{
 		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 	}
 
 	switch (uMsg)
 	{
-		case WM_NCDESTROY:
-		{
-			::RemoveWindowSubclass(hWnd, WindowMenuBarSubclass, uIdSubclass);
-			std::unique_ptr<ThemeData> ptrData(pMenuThemeData);
-			break;
-		}
-
 		case WM_UAHDRAWMENU:
 		{
-			auto* pUDM = reinterpret_cast<UAHMENU*>(lParam);
-			paintMenuBar(hWnd, pUDM->hdc);
+			const auto* pUDM = reinterpret_cast<UAHMENU*>(lParam);
+			paintMenuBar(hWnd, *pUDM, menuBarData);
 
 			return 0;
 		}
 
 		case WM_UAHDRAWMENUITEM:
 		{
-			const auto& hTheme = pMenuThemeData->getHTheme();
+			const auto& hTheme = menuBarData.m_themeData.getHTheme();
 			auto* pUDMI = reinterpret_cast<UAHDRAWMENUITEM*>(lParam);
-			paintMenuBarItems(*pUDMI, hTheme);
+			paintMenuBarItems(*pUDMI, hTheme, menuBarData);
 
 			return 0;
 		}
 
-#if 0 // for debugging
-		case WM_UAHMEASUREMENUITEM:
+		case WM_NCACTIVATE:
+		case WM_NCPAINT:
 		{
-			auto* pMMI = reinterpret_cast<UAHMEASUREMENUITEM*>(lParam);
-			return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+			const LRESULT retVal = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+			drawUAHMenuNCBottomLine(hWnd, menuBarData);
+			return retVal;
 		}
-#endif
 
-		case WM_DPICHANGED:
-		case WM_DPICHANGED_AFTERPARENT:
-		case WM_THEMECHANGED:
+		default:
+		{
+			break;
+		}
+	}
+	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+/**
+ * @brief Handles `WM_SETTINGCHANGE` message for the `settingChange` window behavior.
+ *
+ * Handles `WM_SETTINGCHANGE` to perform changes for dark mode based on system setting.
+ *
+ * @param[in]   hWnd        Window handle being subclassed.
+ * @param[in]   uMsg        Message identifier.
+ * @param[in]   wParam      Message-specific data.
+ * @param[in]   lParam      Message-specific data.
+ * @return LRESULT Result of message processing.
+ *
+ * @see DarkMode::setWindowSettingChangeSubclass()
+ * @see DarkMode::removeWindowSettingChangeSubclass()
+ */
+static LRESULT onWindowSettingChange(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	switch (uMsg)
+	{
+		case WM_SETTINGCHANGE:
+		{
+			if (DarkMode::handleSettingChange(lParam))
+			{
+				DarkMode::setDarkTitleBarEx(hWnd, true);
+				DarkMode::setChildCtrlsTheme(hWnd);
+				::RedrawWindow(hWnd, nullptr, nullptr, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN | RDW_UPDATENOW | RDW_FRAME);
+			}
+			break;
+		}
+
+		default:
 		{
-			pMenuThemeData->closeTheme();
 			break;
 		}
+	}
+	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+/**
+ * @class WindowSubclassData
+ * @brief Reference data for the single parent window subclass.
+ *
+ * Members:
+ * - `m_behaviors`: Bitmask of enabled `WindowBehavior` flags.
+ * - `m_menuBarData`: Menu theme data and menu bar cache, exists only while `menuBar` behavior is enabled.
+ */
+struct WindowSubclassData : public dmlib_subclass::PoolAllocated<WindowSubclassData>
+{
+	std::uint8_t m_behaviors = 0;
+	std::unique_ptr<MenuBarData> m_menuBarData;
+
+	[[nodiscard]] bool hasBehavior(dmlib_subclass::WindowBehavior behavior) const noexcept
+	{
+		return (m_behaviors & static_cast<std::uint8_t>(behavior)) != 0;
+	}
+};
+
+/**
+ * @brief Maps message to the window behavior handling it.
+ *
+ * Message sets of behaviors do not overlap, so each message is dispatched
+ * to at most one handler.
+ *
+ * @param[in] uMsg Message identifier.
+ * @return Behavior handling the message, or `WindowBehavior::none`.
+ */
+[[nodiscard]] static constexpr dmlib_subclass::WindowBehavior getMsgBehavior(UINT uMsg) noexcept
+{
+	using dmlib_subclass::WindowBehavior;
+
+	switch (uMsg)
+	{
+		case WM_ERASEBKGND:
+		{
+			return WindowBehavior::eraseBg;
+		}
+
+		case WM_CTLCOLOREDIT:
+		case WM_CTLCOLORLISTBOX:
+		case WM_CTLCOLORDLG:
+		case WM_CTLCOLORSTATIC:
+		case WM_PRINTCLIENT:
+		{
+			return WindowBehavior::ctlColor;
+		}
+
+		case WM_NOTIFY:
+		{
+			return WindowBehavior::notify;
+		}
 
+		case WM_UAHDRAWMENU:
+		case WM_UAHDRAWMENUITEM:
+		case WM_UAHMEASUREMENUITEM:
+		case WM_INITMENU:
+		case WM_NCCALCSIZE:
+		case WM_DPICHANGED:
+		case WM_DPICHANGED_AFTERPARENT:
+		case WM_THEMECHANGED:
 		case WM_NCACTIVATE:
 		case WM_NCPAINT:
 		{
-			const LRESULT retVal = ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
-			drawUAHMenuNCBottomLine(hWnd);
-			return retVal;
+			return WindowBehavior::menuBar;
+		}
+
+		case WM_SETTINGCHANGE:
+		{
+			return WindowBehavior::settingChange;
 		}
 
 		default:
 		{
-			break;
+			return WindowBehavior::none;
 		}
 	}
-	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 }
 
 /**
- * @brief Window subclass procedure for handling `WM_SETTINGCHANGE` message.
+ * @brief Single window subclass procedure for parent windows.
  *
- * Handles `WM_SETTINGCHANGE` to perform changes for dark mode based on system setting.
+ * Replaces separate subclasses for erase background, control colors,
+ * custom draw notifications, menu bar, and setting change.
+ * Each message is looked up once and dispatched only to the handler
+ * of enabled behavior, other messages go directly to `DefSubclassProc`.
+ *
+ * Cleans up subclass and reference data on `WM_NCDESTROY`.
  *
  * @param[in]   hWnd        Window handle being subclassed.
  * @param[in]   uMsg        Message identifier.
  * @param[in]   wParam      Message-specific data.
  * @param[in]   lParam      Message-specific data.
  * @param[in]   uIdSubclass Subclass identifier.
- * @param[in]   dwRefData   Reserved data (unused).
+ * @param[in]   dwRefData   WindowSubclassData instance.
  * @return LRESULT Result of message processing.
  *
- * @see DarkMode::setWindowSettingChangeSubclass()
- * @see DarkMode::removeWindowSettingChangeSubclass()
+ * @see dmlib_subclass::setWindowBehavior()
+ * @see dmlib_subclass::removeWindowBehavior()
  */
-LRESULT CALLBACK dmlib_subclass::WindowSettingChangeSubclass(
+LRESULT CALLBACK dmlib_subclass::WindowSubclass(
 	HWND hWnd,
 	UINT uMsg,
 	WPARAM wParam,
 	LPARAM lParam,
 	UINT_PTR uIdSubclass,
-	[[maybe_unused]] DWORD_PTR dwRefData
+	DWORD_PTR dwRefData
 )
 {
-	switch (uMsg)
+	static constexpr MsgFilter kMsgFilter{
+		WM_NCDESTROY, WM_ERASEBKGND, WM_CTLCOLOREDIT, WM_CTLCOLORLISTBOX,
+		WM_CTLCOLORDLG, WM_CTLCOLORSTATIC, WM_PRINTCLIENT, WM_NOTIFY,
+		WM_UAHDRAWMENU, WM_UAHDRAWMENUITEM, WM_UAHMEASUREMENUITEM, WM_INITMENU,
+		WM_NCCALCSIZE, WM_DPICHANGED, WM_DPICHANGED_AFTERPARENT, WM_THEMECHANGED,
+		WM_NCACTIVATE, WM_NCPAINT, WM_SETTINGCHANGE
+	};
+	if (!kMsgFilter.contains(uMsg))
 	{
-		case WM_NCDESTROY:
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	auto* pWindowData = reinterpret_cast<WindowSubclassData*>(dwRefData);
+
+	if (uMsg == WM_NCDESTROY)
+	{
+		dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, WindowSubclass, uIdSubclass);
+		std::unique_ptr<WindowSubclassData> ptrData(pWindowData);
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	if (uMsg == WM_THEMECHANGED)
+	{
+		// only top-level windows get system changes, children and
+		// per-window `SetWindowTheme` keep the shared cache
+		if (::GetAncestor(hWnd, GA_ROOT) == hWnd)
 		{
-			::RemoveWindowSubclass(hWnd, WindowSettingChangeSubclass, uIdSubclass);
-			break;
+			dmlib_subclass::invalidateThemeCacheOnSystemChange();
 		}
+	}
 
-		case WM_SETTINGCHANGE:
+	const auto behavior = getMsgBehavior(uMsg);
+	if (behavior == WindowBehavior::none || !pWindowData->hasBehavior(behavior))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
+	switch (behavior)
+	{
+		case WindowBehavior::eraseBg:
 		{
-			if (DarkMode::handleSettingChange(lParam))
-			{
-				DarkMode::setDarkTitleBarEx(hWnd, true);
-				DarkMode::setChildCtrlsTheme(hWnd);
-				::RedrawWindow(hWnd, nullptr, nullptr, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN | RDW_UPDATENOW | RDW_FRAME);
-			}
-			break;
+			return onWindowEraseBg(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WindowBehavior::ctlColor:
+		{
+			return onWindowCtlColor(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WindowBehavior::notify:
+		{
+			return onWindowNotify(hWnd, uMsg, wParam, lParam);
+		}
+
+		case WindowBehavior::menuBar:
+		{
+			return onWindowMenuBar(hWnd, uMsg, wParam, lParam, *pWindowData->m_menuBarData);
+		}
+
+		case WindowBehavior::settingChange:
+		{
+			return onWindowSettingChange(hWnd, uMsg, wParam, lParam);
 		}
 
 		default:
@@ -1349,6 +1621,79 @@ LRESULT CALLBACK dmlib_subclass::WindowSettingChangeSubclass(
 	return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
 }
 
+/**
+ * @brief Retrieves reference data of installed window subclass.
+ *
+ * @param[in] hWnd Handle to the window.
+ * @return Pointer to `WindowSubclassData`, or `nullptr` if subclass is not installed.
+ */
+[[nodiscard]] static WindowSubclassData* getWindowSubclassData(HWND hWnd) noexcept
+{
+	return dmlib_subclass::getSubclassData<WindowSubclassData>(hWnd, dmlib_subclass::SubclassID::window);
+}
+
+/**
+ * @brief Enables window behavior.
+ *
+ * Installs the single window subclass on first use,
+ * later calls only set the behavior flag.
+ *
+ * @param[in] hWnd      Handle to the parent window.
+ * @param[in] behavior  Behavior to enable.
+ *
+ * @see dmlib_subclass::WindowSubclass()
+ * @see dmlib_subclass::removeWindowBehavior()
+ */
+void dmlib_subclass::setWindowBehavior(HWND hWnd, WindowBehavior behavior)
+{
+	auto* pWindowData = getWindowSubclassData(hWnd);
+	if (pWindowData == nullptr)
+	{
+		if (dmlib_subclass::SetSubclass<WindowSubclassData>(hWnd, WindowSubclass, SubclassID::window) != TRUE)
+		{
+			return;
+		}
+		pWindowData = getWindowSubclassData(hWnd);
+	}
+
+	if (behavior == WindowBehavior::menuBar && pWindowData->m_menuBarData == nullptr)
+	{
+		pWindowData->m_menuBarData = std::make_unique<MenuBarData>();
+	}
+	pWindowData->m_behaviors |= static_cast<std::uint8_t>(behavior);
+}
+
+/**
+ * @brief Disables window behavior.
+ *
+ * Removes the single window subclass when no behavior is left enabled.
+ *
+ * @param[in] hWnd      Handle to the parent window.
+ * @param[in] behavior  Behavior to disable.
+ *
+ * @see dmlib_subclass::WindowSubclass()
+ * @see dmlib_subclass::setWindowBehavior()
+ */
+void dmlib_subclass::removeWindowBehavior(HWND hWnd, WindowBehavior behavior)
+{
+	auto* pWindowData = getWindowSubclassData(hWnd);
+	if (pWindowData == nullptr)
+	{
+		return;
+	}
+
+	pWindowData->m_behaviors &= static_cast<std::uint8_t>(~static_cast<std::uint8_t>(behavior));
+	if (behavior == WindowBehavior::menuBar)
+	{
+		pWindowData->m_menuBarData.reset();
+	}
+
+	if (pWindowData->m_behaviors == 0)
+	{
+		dmlib_subclass::RemoveSubclass<WindowSubclassData>(hWnd, WindowSubclass, SubclassID::window);
+	}
+}
+
 /**
  * @class TaskDlgData
  * @brief Class to handle colors for task dialog.
@@ -1361,7 +1706,7 @@ LRESULT CALLBACK dmlib_subclass::WindowSettingChangeSubclass(
  *
  * Copying and moving are explicitly disabled to preserve exclusive ownership.
  */
-class TaskDlgData
+class TaskDlgData : public dmlib_subclass::PoolAllocated<TaskDlgData>
 {
 public:
 	TaskDlgData() noexcept
@@ -1380,7 +1725,7 @@ class TaskDlgData
 			}
 		}
 
-		m_hBrushBg = ::CreateSolidBrush(m_clrBg);
+		m_hBrushBg = dmlib_resource::createSolidBrush(m_clrBg);
 	}
 
 	TaskDlgData(const TaskDlgData&) = delete;
@@ -1391,7 +1736,7 @@ class TaskDlgData
 
 	~TaskDlgData()
 	{
-		::DeleteObject(m_hBrushBg);
+		dmlib_resource::deleteObject(m_hBrushBg);
 	}
 
 	[[nodiscard]] COLORREF getTextColor() const noexcept
@@ -1449,13 +1794,19 @@ static LRESULT CALLBACK DarkTaskDlgSubclass(
 	DWORD_PTR dwRefData
 )
 {
+	static constexpr dmlib_subclass::MsgFilter kMsgFilter{ WM_NCDESTROY, WM_ERASEBKGND, WM_CTLCOLORDLG, WM_CTLCOLORSTATIC, WM_PRINTCLIENT };
+	if (!kMsgFilter.contains(uMsg))
+	{
+		return ::DefSubclassProc(hWnd, uMsg, wParam, lParam);
+	}
+
 	auto* pTaskDlgData = reinterpret_cast<TaskDlgData*>(dwRefData);
 
 	switch (uMsg)
 	{
 		case WM_NCDESTROY:
 		{
-			::RemoveWindowSubclass(hWnd, DarkTaskDlgSubclass, uIdSubclass);
+			dmlib_subclass::RemoveSubclassOnNcDestroy(hWnd, DarkTaskDlgSubclass, uIdSubclass);
 			std::unique_ptr<TaskDlgData> ptrData(pTaskDlgData);
 			break;
 		}
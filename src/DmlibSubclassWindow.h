@@ -14,13 +14,33 @@
 
 #include <windows.h>
 
+#include <cstdint>
+
 namespace dmlib_subclass
 {
-	LRESULT CALLBACK WindowEraseBgSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK WindowCtlColorSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK WindowNotifySubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK WindowMenuBarSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
-	LRESULT CALLBACK WindowSettingChangeSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
+	/**
+	 * @brief Behaviors handled by the single parent window subclass.
+	 *
+	 * Values are bit flags stored in one mask per window.
+	 *
+	 * @see WindowSubclass()
+	 */
+	enum class WindowBehavior : std::uint8_t
+	{
+		none          = 0,
+		eraseBg       = 1 << 0,  ///< `WM_ERASEBKGND`
+		ctlColor      = 1 << 1,  ///< `WM_CTLCOLOR*` and `WM_PRINTCLIENT`
+		notify        = 1 << 2,  ///< `WM_NOTIFY` custom draw
+		menuBar       = 1 << 3,  ///< UAH menu bar messages
+		settingChange = 1 << 4   ///< `WM_SETTINGCHANGE`
+	};
+
+	LRESULT CALLBACK WindowSubclass(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData);
+
+	/// Enables behavior, installs window subclass if it is not installed yet.
+	void setWindowBehavior(HWND hWnd, WindowBehavior behavior);
+	/// Disables behavior, removes window subclass when no behavior is left.
+	void removeWindowBehavior(HWND hWnd, WindowBehavior behavior);
 
 	void setTaskDlgChildCtrlsSubclassAndTheme(HWND hWnd);
 
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @namespace dmlib_test
+ * @brief Minimal test helpers for host tests without external framework.
+ */
+namespace dmlib_test
+{
+	/// Number of failed checks in the current test executable.
+	inline int g_failures = 0;
+
+	/// Reports failed check.
+	inline void reportFailure(const char* expr, const char* file, int line) noexcept
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+		++g_failures;
+	}
+
+	/// Returns process exit code and prints summary.
+	[[nodiscard]] inline int finish(const char* name) noexcept
+	{
+		if (g_failures == 0)
+		{
+			std::printf("%s: all checks passed\n", name);
+			return 0;
+		}
+		std::fprintf(stderr, "%s: %d check(s) failed\n", name, g_failures);
+		return 1;
+	}
+
+	/**
+	 * @brief Measures average duration of one call of the callable.
+	 *
+	 * @param[in]   name        Benchmark name printed with the result.
+	 * @param[in]   iterations  Number of calls.
+	 * @param[in]   fn          Callable to measure.
+	 * @return Average duration of one call in nanoseconds.
+	 */
+	template <typename Fn>
+	inline double benchmark(const char* name, int iterations, Fn&& fn)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			fn();
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		const double perCall = elapsed.count() / static_cast<double>(iterations);
+		std::printf("%-40s %12.1f ns/call (%d calls)\n", name, perCall, iterations);
+		return perCall;
+	}
+} // namespace dmlib_test
+
+/// Checks the condition, failures are counted and reported but do not stop the test.
+#define DMLIB_CHECK(expr) \
+	do { if (!(expr)) { dmlib_test::reportFailure(#expr, __FILE__, __LINE__); } } while (false)
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#pragma once
+
+#include <chrono>
+
+namespace dmlib_test
+{
+	/**
+	 * @struct FakeClock
+	 * @brief Manually advanced clock for deterministic time budget tests.
+	 */
+	struct FakeClock
+	{
+		using rep = long long;
+		using period = std::milli;
+		using duration = std::chrono::duration<rep, period>;
+		using time_point = std::chrono::time_point<FakeClock>;
+		static constexpr bool is_steady = true;
+
+		inline static rep s_now = 0;
+
+		[[nodiscard]] static time_point now() noexcept
+		{
+			return time_point{ duration{ s_now } };
+		}
+
+		static void advance(rep ms) noexcept
+		{
+			s_now += ms;
+		}
+	};
+} // namespace dmlib_test
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibMsgFilter.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	using dmlib_subclass::MsgFilter;
+
+	// values from winuser.h and commctrl.h
+	constexpr unsigned int kWmSetText = 0x000C;
+	constexpr unsigned int kWmGetText = 0x000D;
+	constexpr unsigned int kWmPaint = 0x000F;
+	constexpr unsigned int kWmEraseBkgnd = 0x0014;
+	constexpr unsigned int kWmSetFont = 0x0030;
+	constexpr unsigned int kWmNcDestroy = 0x0082;
+	constexpr unsigned int kWmNcHitTest = 0x0084;
+	constexpr unsigned int kWmTimer = 0x0113;
+	constexpr unsigned int kWmMouseMove = 0x0200;
+	constexpr unsigned int kWmMouseLeave = 0x02A3;
+	constexpr unsigned int kWmDpiChangedAfterParent = 0x02E3;
+	constexpr unsigned int kTcmFirst = 0x1300;
+	constexpr unsigned int kTcmSetCurSel = kTcmFirst + 12;
+	constexpr unsigned int kTcmInsertItemW = kTcmFirst + 62;
+	constexpr unsigned int kTcmGetItemRect = kTcmFirst + 10;
+
+	/// Stands for subclass reference data, state read by every handled message.
+	struct MockData
+	{
+		int m_painted = 0;
+		int m_hot = 0;
+		int m_dirty = 0;
+	};
+
+	volatile long long g_sink = 0;
+
+	/// Stands for `DefSubclassProc`, not inlined like the real call into comctl32.
+#if defined(_MSC_VER)
+	__declspec(noinline)
+#else
+	__attribute__((noinline))
+#endif
+	long long defProc(unsigned int msg, long long lParam) noexcept
+	{
+		return static_cast<long long>(msg) ^ lParam;
+	}
+
+	/// Message switch shaped like tab control subclass procedure.
+	long long dispatch(MockData& data, unsigned int msg, long long lParam) noexcept
+	{
+		switch (msg)
+		{
+			case kWmNcDestroy:
+			{
+				data = MockData{};
+				break;
+			}
+
+			case kWmPaint:
+			case kWmEraseBkgnd:
+			{
+				++data.m_painted;
+				return 0;
+			}
+
+			case kWmSetFont:
+			case kWmSetText:
+			case kWmDpiChangedAfterParent:
+			case kTcmInsertItemW:
+			case kTcmSetCurSel:
+			{
+				++data.m_dirty;
+				break;
+			}
+
+			case kWmMouseMove:
+			{
+				data.m_hot = static_cast<int>(lParam & 0xFF);
+				break;
+			}
+
+			case kWmMouseLeave:
+			{
+				data.m_hot = -1;
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+		return defProc(msg, lParam);
+	}
+
+	constexpr MsgFilter kMsgFilter{ kTcmFirst, {
+		kWmNcDestroy, kWmPaint, kWmEraseBkgnd, kWmSetFont, kWmSetText,
+		kWmDpiChangedAfterParent, kWmMouseMove, kWmMouseLeave, kTcmInsertItemW, kTcmSetCurSel
+	} };
+} // anonymous namespace
+
+/**
+ * Compares filtered and unfiltered mock dispatch over message stream
+ * dominated by unhandled messages, e.g. hit tests, timers, and text queries.
+ */
+int main()
+{
+	constexpr size_t kStreamSize = 4096;
+	constexpr int kIterations = 2000;
+
+	// mostly messages which subclass does not handle
+	const unsigned int unhandled[] = { kWmGetText, kWmNcHitTest, kWmTimer, kTcmGetItemRect, kWmGetText };
+	const unsigned int handled[] = { kWmPaint, kWmMouseMove, kWmSetText, kTcmSetCurSel, kWmMouseLeave };
+
+	std::mt19937 rng{ 42 };
+	std::uniform_int_distribution<int> pct{ 0, 99 };
+	std::uniform_int_distribution<size_t> pick{ 0, 4 };
+	std::vector<unsigned int> stream(kStreamSize);
+	for (auto& msg : stream)
+	{
+		msg = (pct(rng) < 90) ? unhandled[pick(rng)] : handled[pick(rng)];
+	}
+
+	MockData unfilteredData;
+	const double unfilteredNs = dmlib_test::benchmark("unfiltered dispatch (4096 msgs)", kIterations, [&]() {
+		long long sum = 0;
+		for (size_t i = 0; i < stream.size(); ++i)
+		{
+			sum += dispatch(unfilteredData, stream[i], static_cast<long long>(i));
+		}
+		g_sink = g_sink + sum;
+	});
+
+	MockData filteredData;
+	const double filteredNs = dmlib_test::benchmark("filtered dispatch (4096 msgs)", kIterations, [&]() {
+		long long sum = 0;
+		for (size_t i = 0; i < stream.size(); ++i)
+		{
+			const unsigned int msg = stream[i];
+			const auto lParam = static_cast<long long>(i);
+			sum += kMsgFilter.contains(msg) ? dispatch(filteredData, msg, lParam) : defProc(msg, lParam);
+		}
+		g_sink = g_sink + sum;
+	});
+
+	std::printf("%-40s %12.1f ns/msg\n", "unfiltered", unfilteredNs / kStreamSize);
+	std::printf("%-40s %12.1f ns/msg\n", "filtered", filteredNs / kStreamSize);
+
+	DMLIB_CHECK(unfilteredData.m_painted == filteredData.m_painted);
+	DMLIB_CHECK(unfilteredData.m_dirty == filteredData.m_dirty);
+	DMLIB_CHECK(unfilteredData.m_hot == filteredData.m_hot);
+
+	return dmlib_test::finish("bench_msgfilter");
+}
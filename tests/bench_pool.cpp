@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibPool.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	std::ptrdiff_t g_stateBytes = 0;
+
+	/// Keeps the compiler from eliding allocation pairs.
+	void* volatile g_sink = nullptr;
+
+	/// Size of typical subclass reference data, e.g. button data with cached metrics.
+	struct Payload
+	{
+		std::array<int, 24> m_values{};
+	};
+
+	struct PooledData : public dmlib_subclass::PoolAllocated<PooledData>
+	{
+		Payload m_payload;
+	};
+
+	struct HeapData
+	{
+		Payload m_payload;
+	};
+
+	/// Number of controls of a larger dialog.
+	constexpr size_t kCtrlCount = 64;
+
+	/// Simulates opening and closing a dialog, all controls are allocated, then freed.
+	template <typename T>
+	void openCloseDialog(std::vector<std::unique_ptr<T>>& ctrls)
+	{
+		for (size_t i = 0; i < kCtrlCount; ++i)
+		{
+			ctrls.push_back(std::make_unique<T>());
+			ctrls.back()->m_payload.m_values[0] = static_cast<int>(i);
+			g_sink = ctrls.back().get();
+		}
+		ctrls.clear();
+	}
+} // anonymous namespace
+
+void dmlib_subclass::addStateBytes(std::ptrdiff_t delta) noexcept
+{
+	g_stateBytes += delta;
+}
+
+/**
+ * Compares `SubclassPool` with global `new`/`delete` for subclass reference data.
+ */
+int main()
+{
+	constexpr int kIterations = 200000;
+
+	std::vector<std::unique_ptr<PooledData>> pooled;
+	std::vector<std::unique_ptr<HeapData>> heap;
+	pooled.reserve(kCtrlCount);
+	heap.reserve(kCtrlCount);
+
+	// warm up, pool slabs are allocated once
+	openCloseDialog(pooled);
+	openCloseDialog(heap);
+
+	const double poolNs = dmlib_test::benchmark("pool new/delete (64 controls)", kIterations, [&pooled]() {
+		openCloseDialog(pooled);
+	});
+	const double heapNs = dmlib_test::benchmark("global new/delete (64 controls)", kIterations, [&heap]() {
+		openCloseDialog(heap);
+	});
+	std::printf("%-40s %12.2fx\n", "global / pool", heapNs / poolNs);
+
+	dmlib_test::benchmark("pool single new/delete", kIterations * 10, []() {
+		auto pData = std::make_unique<PooledData>();
+		g_sink = pData.get();
+	});
+	dmlib_test::benchmark("global single new/delete", kIterations * 10, []() {
+		auto pData = std::make_unique<HeapData>();
+		g_sink = pData.get();
+	});
+
+	DMLIB_CHECK(g_stateBytes == 0);
+	return dmlib_test::finish("bench_pool");
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibRaster.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "DmlibTest.h"
+
+/**
+ * Measures throughput of span fill and rounded rectangle painting
+ * for typical control sizes (button, edit, large panel).
+ */
+int main()
+{
+	constexpr int kWidth = 1024;
+	constexpr int kHeight = 512;
+	std::vector<std::uint32_t> pixels(static_cast<size_t>(kWidth) * kHeight, 0);
+	dmlib_raster::Surface surface{ pixels.data(), kWidth, kHeight, kWidth };
+	const dmlib_raster::Rect clip{ 0, 0, kWidth, kHeight };
+
+	const double spanNs = dmlib_test::benchmark("fillSpan 1024 px", 200000, [&]() {
+		dmlib_raster::fillSpan(pixels.data(), kWidth, 0x00202020);
+	});
+	std::printf("%-40s %12.1f Mpx/s\n", "fillSpan throughput", kWidth / spanNs * 1000.0);
+
+	struct Case
+	{
+		const char* m_name;
+		dmlib_raster::Rect m_rect;
+		int m_radius;
+		int m_iterations;
+	};
+
+	const dmlib_raster::ShapeStyle style{ 0x00383838, 0x00646464, 1, true };
+	for (const Case& c : {
+		Case{ "paintRoundRect button 75x23 r4", { 10, 10, 85, 33 }, 4, 200000 },
+		Case{ "paintRoundRect edit 300x24 r4", { 10, 10, 310, 34 }, 4, 100000 },
+		Case{ "paintRoundRect panel 1000x500 r8", { 10, 5, 1010, 505 }, 8, 2000 },
+		Case{ "paintRoundRect panel 1000x500 r0", { 10, 5, 1010, 505 }, 0, 2000 } })
+	{
+		const double ns = dmlib_test::benchmark(c.m_name, c.m_iterations, [&]() {
+			dmlib_raster::paintRoundRect(surface, clip, c.m_rect, c.m_radius, style);
+		});
+		const double area = static_cast<double>(c.m_rect.m_right - c.m_rect.m_left) * (c.m_rect.m_bottom - c.m_rect.m_top);
+		std::printf("%-40s %12.1f Mpx/s\n", "  throughput", area / ns * 1000.0);
+	}
+
+	DMLIB_CHECK(pixels[static_cast<size_t>(kWidth) * 20 + 20] == 0x00383838);
+	return dmlib_test::finish("bench_raster");
+}
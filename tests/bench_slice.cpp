@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibSlice.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	using Clock = std::chrono::steady_clock;
+	using Micros = std::chrono::microseconds;
+
+	/**
+	 * @struct MockNode
+	 * @brief Node of mock window tree, index `0` means no node.
+	 *
+	 * Members:
+	 * - `m_parent`: Parent node index.
+	 * - `m_isVisible`: Stands for `WS_VISIBLE` style.
+	 * - `m_cost`: Time spent theming the node, hidden nodes get only cheap deferred subclass.
+	 */
+	struct MockNode
+	{
+		int m_parent = 0;
+		bool m_isVisible = true;
+		Micros m_cost{ 0 };
+	};
+
+	/// Property sheet with tab pages, only the page selected last time is visible, pages have group boxes.
+	std::vector<MockNode> buildPropertySheet(int pages, int groupsPerPage, int ctrlsPerGroup)
+	{
+		std::mt19937 rng{ 7 };
+		std::uniform_int_distribution<int> costDist{ 100, 600 };
+		std::uniform_int_distribution<int> hiddenDist{ 0, 9 };
+
+		std::vector<MockNode> nodes{ MockNode{}, MockNode{} }; // unused 0 and root 1
+		auto add = [&nodes](int parent, bool isVisible, Micros cost) {
+			nodes.push_back(MockNode{ parent, isVisible, cost });
+			return static_cast<int>(nodes.size()) - 1;
+		};
+
+		add(1, true, Micros{ costDist(rng) }); // tab control
+		for (int page = 0; page < pages; ++page)
+		{
+			const int pageNode = add(1, page == pages / 2, Micros{ 30 });
+			for (int group = 0; group < groupsPerPage; ++group)
+			{
+				const int groupNode = add(pageNode, true, Micros{ costDist(rng) });
+				for (int ctrl = 0; ctrl < ctrlsPerGroup; ++ctrl)
+				{
+					add(groupNode, hiddenDist(rng) != 0, Micros{ costDist(rng) });
+				}
+			}
+		}
+		return nodes;
+	}
+
+	[[nodiscard]] bool isShown(const std::vector<MockNode>& nodes, int node)
+	{
+		if (!nodes[static_cast<size_t>(node)].m_isVisible)
+		{
+			return false;
+		}
+
+		return dmlib_slice::findHiddenAncestor(node, 1,
+			[&nodes](int current) { return nodes[static_cast<size_t>(current)].m_parent; },
+			[&nodes](int current) { return nodes[static_cast<size_t>(current)].m_isVisible; }) == 0;
+	}
+
+	/// Stands for theming, hidden controls only get lightweight deferred subclass.
+	void themeNode(const MockNode& node, bool isNodeShown)
+	{
+		const auto deadline = Clock::now() + (isNodeShown ? node.m_cost : Micros{ 20 });
+		while (Clock::now() < deadline)
+		{
+		}
+	}
+
+	/// Job list shaped like the asynchronous theming jobs.
+	struct Job
+	{
+		unsigned m_id = 0;
+		std::vector<int> m_children;
+		size_t m_next = 0;
+	};
+
+	struct
+	{
+		std::mutex m_mutex;
+		std::vector<std::unique_ptr<Job>> m_jobs;
+	} g_jobs;
+
+	struct RunResult
+	{
+		std::vector<double> m_sliceMs;
+		double m_shownDoneMs = 0.0;
+		size_t m_processed = 0;
+	};
+
+	/// Processes the job in slices like the timer procedure, time between slices is not counted.
+	void runJob(RunResult& result, const std::vector<MockNode>& nodes, unsigned id, std::chrono::milliseconds budget, size_t shownCount)
+	{
+		std::chrono::duration<double, std::milli> busy{ 0 };
+		size_t shownDone = 0;
+		result.m_shownDoneMs = 0.0;
+		bool isDone = false;
+		while (!isDone)
+		{
+			const auto start = Clock::now();
+			isDone = dmlib_slice::runSlice(budget, [&]() -> bool {
+				int node = 0;
+				bool hasMore = false;
+				{
+					const std::lock_guard<std::mutex> lock(g_jobs.m_mutex);
+					auto it = std::find_if(g_jobs.m_jobs.begin(), g_jobs.m_jobs.end(), [id](const auto& pJob) {
+						return pJob->m_id == id;
+					});
+					if (it == g_jobs.m_jobs.end() || (*it)->m_next >= (*it)->m_children.size())
+					{
+						return false;
+					}
+					auto& job = **it;
+					node = job.m_children[job.m_next++];
+					hasMore = job.m_next < job.m_children.size();
+				}
+
+				const bool isNodeShown = isShown(nodes, node);
+				themeNode(nodes[static_cast<size_t>(node)], isNodeShown);
+				++result.m_processed;
+				if (isNodeShown && ++shownDone == shownCount)
+				{
+					const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+					result.m_shownDoneMs = (busy + elapsed).count();
+				}
+				return hasMore;
+			});
+			const std::chrono::duration<double, std::milli> slice = Clock::now() - start;
+			busy += slice;
+			result.m_sliceMs.push_back(slice.count());
+		}
+	}
+
+	/// Number of repeated runs, slice durations of all runs are collected for percentiles.
+	constexpr int kRounds = 20;
+
+	RunResult runRounds(const std::vector<MockNode>& nodes, unsigned id, std::chrono::milliseconds budget, size_t shownCount)
+	{
+		RunResult result;
+		double shownDoneMs = 0.0;
+		for (int round = 0; round < kRounds; ++round)
+		{
+			{
+				const std::lock_guard<std::mutex> lock(g_jobs.m_mutex);
+				g_jobs.m_jobs[id - 1]->m_next = 0;
+			}
+			runJob(result, nodes, id, budget, shownCount);
+			shownDoneMs += result.m_shownDoneMs;
+		}
+		result.m_shownDoneMs = shownDoneMs / kRounds;
+		return result;
+	}
+
+	void report(const char* name, RunResult& result, unsigned sliceMs)
+	{
+		auto& durations = result.m_sliceMs;
+		std::sort(durations.begin(), durations.end());
+		const double maxMs = durations.back();
+		const double p99Ms = durations[std::min(durations.size() - 1, (durations.size() * 99) / 100)];
+		std::printf("%-24s slices %5zu  max %6.2f ms  p99 %6.2f ms  budget %u ms  all shown themed after %6.2f ms\n",
+			name, durations.size(), maxMs, p99Ms, sliceMs, result.m_shownDoneMs);
+	}
+} // anonymous namespace
+
+/**
+ * Measures per-slice latency of asynchronous theming of a mock property sheet
+ * with mixed visible and hidden controls, with and without shown-first ordering.
+ * Slice may exceed the budget by at most one item, item costs are up to 0.6 ms.
+ */
+int main()
+{
+	const auto nodes = buildPropertySheet(8, 6, 15);
+	const unsigned sliceMs = dmlib_slice::getSliceMs(0);
+	const auto budget = std::chrono::milliseconds(sliceMs);
+
+	std::vector<int> children;
+	for (int node = 2; node < static_cast<int>(nodes.size()); ++node)
+	{
+		children.push_back(node); // pre-order like `EnumChildWindows`
+	}
+
+	const auto shownCount = static_cast<size_t>(std::count_if(children.begin(), children.end(), [&nodes](int node) {
+		return isShown(nodes, node);
+	}));
+
+	// decoy jobs, worst case look-up of the last job
+	for (unsigned id = 1; id <= 8; ++id)
+	{
+		auto pJob = std::make_unique<Job>();
+		pJob->m_id = id;
+		g_jobs.m_jobs.push_back(std::move(pJob));
+	}
+
+	g_jobs.m_jobs[6]->m_children = children;
+	auto unordered = runRounds(nodes, 7, budget, shownCount);
+
+	auto ordered = children;
+	const auto itHidden = dmlib_slice::orderShownFirst(ordered.begin(), ordered.end(), [&nodes](int node) {
+		return isShown(nodes, node);
+	});
+	g_jobs.m_jobs[7]->m_children = ordered;
+	auto shownFirst = runRounds(nodes, 8, budget, shownCount);
+
+	std::printf("%zu nodes, %zu shown\n", children.size(), shownCount);
+	report("enumeration order", unordered, sliceMs);
+	report("shown first", shownFirst, sliceMs);
+
+	DMLIB_CHECK(static_cast<size_t>(itHidden - ordered.begin()) == shownCount);
+	DMLIB_CHECK(unordered.m_processed == children.size() * kRounds);
+	DMLIB_CHECK(shownFirst.m_processed == children.size() * kRounds);
+	DMLIB_CHECK(shownFirst.m_shownDoneMs > 0.0);
+
+	return dmlib_test::finish("bench_slice");
+}
@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibAtlas.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	/// Font description similar to `LOGFONT`, height already scaled for DPI.
+	struct MockFont
+	{
+		int m_height = 0;
+		int m_weight = 400;
+		std::wstring m_face;
+	};
+
+	struct MockFontEqual
+	{
+		bool operator()(const MockFont& lhs, const MockFont& rhs) const noexcept
+		{
+			return lhs.m_height == rhs.m_height && lhs.m_weight == rhs.m_weight && lhs.m_face == rhs.m_face;
+		}
+	};
+
+	struct MockFontHash
+	{
+		std::size_t operator()(const MockFont& font) const
+		{
+			return std::hash<std::wstring>{}(font.m_face) ^ static_cast<std::size_t>(font.m_height * 31 + font.m_weight);
+		}
+	};
+
+	/// Worst case hash, every font collides.
+	struct CollidingHash
+	{
+		std::size_t operator()(const MockFont&) const noexcept
+		{
+			return 42;
+		}
+	};
+
+	/// Font height for point size at DPI, same as `-MulDiv(pt, dpi, 72)`.
+	int scaleHeight(int pointSize, int dpi)
+	{
+		return -((pointSize * dpi) + 36) / 72;
+	}
+
+	/// Tracks occupancy of the page to detect overlapping rectangles.
+	struct Occupancy
+	{
+		int m_size = 0;
+		std::vector<int> m_cells;
+
+		explicit Occupancy(int size)
+			: m_size(size)
+			, m_cells(static_cast<size_t>(size) * static_cast<size_t>(size), 0)
+		{}
+
+		/// Marks rectangle, returns `false` if it overlaps or exceeds the page.
+		bool mark(int x, int y, int width, int height)
+		{
+			if (x < 0 || y < 0 || x + width > m_size || y + height > m_size)
+			{
+				return false;
+			}
+
+			bool isFree = true;
+			for (int row = y; row < y + height; ++row)
+			{
+				for (int col = x; col < x + width; ++col)
+				{
+					int& cell = m_cells[static_cast<size_t>(row * m_size + col)];
+					isFree = isFree && cell == 0;
+					cell = 1;
+				}
+			}
+			return isFree;
+		}
+	};
+
+	constexpr std::uint32_t kDarkColor = 0x00C0C0C0;
+	constexpr std::uint32_t kLightColor = 0x00202020;
+} // anonymous namespace
+
+static void testPackerFill()
+{
+	dmlib_glyph::ShelfPacker packer{ 64, 64 };
+	Occupancy occupancy{ 64 };
+
+	int count = 0;
+	int x = 0;
+	int y = 0;
+	while (packer.pack(8, 8, x, y))
+	{
+		DMLIB_CHECK(occupancy.mark(x, y, 8, 8));
+		++count;
+	}
+	// page is filled completely without gaps
+	DMLIB_CHECK(count == 64);
+	DMLIB_CHECK(!packer.pack(1, 1, x, y));
+
+	packer.reset();
+	DMLIB_CHECK(packer.pack(8, 8, x, y));
+	DMLIB_CHECK(x == 0 && y == 0);
+}
+
+static void testPackerMixedSizes()
+{
+	dmlib_glyph::ShelfPacker packer{ 100, 100 };
+	Occupancy occupancy{ 100 };
+
+	const std::vector<std::pair<int, int>> sizes{
+		{ 10, 20 }, { 7, 12 }, { 30, 20 }, { 5, 12 }, { 60, 9 }, { 9, 20 }, { 40, 12 }, { 11, 9 }
+	};
+
+	int x = 0;
+	int y = 0;
+	for (int round = 0; round < 20; ++round)
+	{
+		for (const auto& [width, height] : sizes)
+		{
+			if (packer.pack(width, height, x, y))
+			{
+				DMLIB_CHECK(occupancy.mark(x, y, width, height));
+			}
+		}
+	}
+
+	// lower shelf is preferred when it fits
+	dmlib_glyph::ShelfPacker shelves{ 100, 100 };
+	DMLIB_CHECK(shelves.pack(10, 20, x, y) && y == 0);
+	DMLIB_CHECK(shelves.pack(10, 30, x, y) && y == 20);
+	DMLIB_CHECK(shelves.pack(10, 15, x, y) && y == 0 && x == 10);
+	DMLIB_CHECK(shelves.pack(10, 25, x, y) && y == 20 && x == 10);
+}
+
+static void testPackerOverflow()
+{
+	dmlib_glyph::ShelfPacker packer{ 32, 32 };
+	int x = 0;
+	int y = 0;
+
+	DMLIB_CHECK(!packer.pack(0, 5, x, y));
+	DMLIB_CHECK(!packer.pack(5, 0, x, y));
+	DMLIB_CHECK(!packer.pack(33, 5, x, y));
+	DMLIB_CHECK(!packer.pack(5, 33, x, y));
+
+	DMLIB_CHECK(packer.pack(32, 20, x, y));
+	// remaining height is 12, taller shelf cannot be opened
+	DMLIB_CHECK(!packer.pack(4, 13, x, y));
+	DMLIB_CHECK(packer.pack(4, 12, x, y) && y == 20);
+	DMLIB_CHECK(packer.pack(28, 12, x, y) && x == 4);
+	DMLIB_CHECK(!packer.pack(1, 1, x, y));
+}
+
+static void testIndexEviction()
+{
+	// 32x32 pages with 16x16 cells: 4 cells per page, at most 2 pages
+	dmlib_glyph::AtlasIndex index{ 32, 2 };
+	int pagesAdded = 0;
+	int evictions = 0;
+	auto addPage = [&pagesAdded]() { ++pagesAdded; return true; };
+	auto evict = [&evictions]() { ++evictions; };
+
+	for (std::uint32_t glyph = 0; glyph < 8; ++glyph)
+	{
+		const auto* cell = index.insert({ 0, glyph, kDarkColor }, 16, 16, addPage, evict);
+		DMLIB_CHECK(cell != nullptr);
+		DMLIB_CHECK(cell != nullptr && cell->m_page == glyph / 4);
+	}
+	DMLIB_CHECK(pagesAdded == 2);
+	DMLIB_CHECK(evictions == 0);
+	DMLIB_CHECK(index.getCellCount() == 8);
+
+	for (std::uint32_t glyph = 0; glyph < 8; ++glyph)
+	{
+		DMLIB_CHECK(index.find({ 0, glyph, kDarkColor }) != nullptr);
+	}
+
+	// atlas is full, everything is evicted and packing starts over
+	const auto* cell = index.insert({ 0, 100, kDarkColor }, 16, 16, addPage, evict);
+	DMLIB_CHECK(cell != nullptr && cell->m_page == 0 && cell->m_x == 0 && cell->m_y == 0);
+	DMLIB_CHECK(evictions == 1);
+	DMLIB_CHECK(pagesAdded == 3);
+	DMLIB_CHECK(index.getPageCount() == 1);
+	DMLIB_CHECK(index.getCellCount() == 1);
+	DMLIB_CHECK(index.find({ 0, 0, kDarkColor }) == nullptr);
+	DMLIB_CHECK(index.find({ 0, 100, kDarkColor }) != nullptr);
+
+	// cell larger than page never fits, no page is created
+	DMLIB_CHECK(index.insert({ 0, 101, kDarkColor }, 33, 8, addPage, evict) == nullptr);
+	DMLIB_CHECK(index.insert({ 0, 101, kDarkColor }, 0, 8, addPage, evict) == nullptr);
+	DMLIB_CHECK(pagesAdded == 3);
+	DMLIB_CHECK(evictions == 1);
+
+	index.clear();
+	DMLIB_CHECK(index.getPageCount() == 0);
+	DMLIB_CHECK(index.getCellCount() == 0);
+}
+
+static void testIndexPageFailure()
+{
+	dmlib_glyph::AtlasIndex index{ 32, 2 };
+	int evictions = 0;
+	const auto* cell = index.insert({ 0, 1, kDarkColor }, 8, 8, []() { return false; }, [&evictions]() { ++evictions; });
+	DMLIB_CHECK(cell == nullptr);
+	DMLIB_CHECK(index.getPageCount() == 0);
+	DMLIB_CHECK(index.getCellCount() == 0);
+	DMLIB_CHECK(evictions == 0);
+}
+
+template <typename Hash>
+static void checkFontIds()
+{
+	dmlib_glyph::FontTable<MockFont, Hash, MockFontEqual> fonts;
+
+	std::vector<std::uint32_t> ids;
+	for (int dpi : { 96, 120, 144, 192 })
+	{
+		ids.push_back(fonts.getId({ scaleHeight(9, dpi), 400, L"Segoe UI" }));
+		ids.push_back(fonts.getId({ scaleHeight(9, dpi), 700, L"Segoe UI" }));
+		ids.push_back(fonts.getId({ scaleHeight(9, dpi), 400, L"Segoe UI Symbol" }));
+	}
+
+	DMLIB_CHECK(fonts.size() == ids.size());
+	DMLIB_CHECK(std::set<std::uint32_t>(ids.begin(), ids.end()).size() == ids.size());
+
+	// same font at same DPI maps to the same identifier
+	DMLIB_CHECK(fonts.getId({ scaleHeight(9, 144), 400, L"Segoe UI" }) == ids[6]);
+	DMLIB_CHECK(fonts.size() == ids.size());
+
+	fonts.clear();
+	DMLIB_CHECK(fonts.size() == 0);
+}
+
+static void testFontIds()
+{
+	checkFontIds<MockFontHash>();
+	// identical hashes are resolved by full comparison
+	checkFontIds<CollidingHash>();
+}
+
+static void testKeyCollisions()
+{
+	dmlib_glyph::FontTable<MockFont, CollidingHash, MockFontEqual> fonts;
+	dmlib_glyph::AtlasIndex index;
+	auto addPage = []() { return true; };
+	auto evict = []() {};
+
+	const std::vector<wchar_t> glyphs{ L'<', L'>', L'˄', L'˅', L'⏷', L'»' };
+	std::vector<dmlib_glyph::GlyphKey> keys;
+	for (int dpi : { 96, 120, 144, 168, 192 })
+	{
+		const std::uint32_t fontId = fonts.getId({ scaleHeight(9, dpi), 400, L"Segoe UI" });
+		for (const std::uint32_t color : { kDarkColor, kLightColor })
+		{
+			for (const wchar_t glyph : glyphs)
+			{
+				keys.push_back({ fontId, static_cast<std::uint32_t>(glyph), color });
+			}
+		}
+	}
+
+	const int cellSize = 12;
+	std::set<std::tuple<size_t, int, int>> positions;
+	for (const auto& key : keys)
+	{
+		DMLIB_CHECK(index.find(key) == nullptr);
+		const auto* cell = index.insert(key, cellSize, cellSize, addPage, evict);
+		DMLIB_CHECK(cell != nullptr);
+		if (cell != nullptr)
+		{
+			positions.emplace(cell->m_page, cell->m_x, cell->m_y);
+		}
+	}
+
+	// every DPI and color variant got its own cell
+	DMLIB_CHECK(positions.size() == keys.size());
+	DMLIB_CHECK(index.getCellCount() == keys.size());
+
+	for (const auto& key : keys)
+	{
+		const auto* cell = index.find(key);
+		DMLIB_CHECK(cell != nullptr && cell->m_key == key);
+	}
+
+	// dark and light variants of the same glyph are distinct
+	const dmlib_glyph::GlyphKey dark{ 0, L'<', kDarkColor };
+	const dmlib_glyph::GlyphKey light{ 0, L'<', kLightColor };
+	DMLIB_CHECK(!(dark == light));
+	DMLIB_CHECK(index.find(dark) != index.find(light));
+}
+
+static void testPremultiplied()
+{
+	// full coverage keeps color with opaque alpha
+	DMLIB_CHECK(dmlib_glyph::toPremultipliedPixel(0x00FFFFFF, 0x12, 0x34, 0x56) == 0xFF123456);
+	// no coverage is fully transparent
+	DMLIB_CHECK(dmlib_glyph::toPremultipliedPixel(0x00000000, 0x12, 0x34, 0x56) == 0x00000000);
+	// ClearType pixel uses the strongest channel as coverage
+	DMLIB_CHECK(dmlib_glyph::toPremultipliedPixel(0x00804020, 0xFF, 0xFF, 0xFF) == 0x80808080);
+	DMLIB_CHECK(dmlib_glyph::toPremultipliedPixel(0x00204080, 0xFF, 0x00, 0x80) == 0x80800040);
+
+	static_assert(dmlib_glyph::toPremultipliedPixel(0x00FFFFFF, 1, 2, 3) == 0xFF010203);
+}
+
+int main()
+{
+	testPackerFill();
+	testPackerMixedSizes();
+	testPackerOverflow();
+	testIndexEviction();
+	testIndexPageFailure();
+	testFontIds();
+	testKeyCollisions();
+	testPremultiplied();
+	return dmlib_test::finish("test_atlas");
+}
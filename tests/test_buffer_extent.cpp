@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibBufferExtent.h"
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	using dmlib_subclass::getBufferExtent;
+	using dmlib_subclass::growBufferExtent;
+	using dmlib_subclass::kBufferGranularity;
+
+	static_assert(growBufferExtent(1) == kBufferGranularity);
+	static_assert(getBufferExtent(128, 100) == 128);
+
+	void testGrowth()
+	{
+		DMLIB_CHECK(growBufferExtent(0) == 0);
+		DMLIB_CHECK(growBufferExtent(1) == 32);
+		DMLIB_CHECK(growBufferExtent(26) == 32);
+		DMLIB_CHECK(growBufferExtent(27) == 64);
+		DMLIB_CHECK(growBufferExtent(100) == 128);
+		// exact multiple of granularity still gets headroom
+		DMLIB_CHECK(growBufferExtent(128) == 160);
+
+		for (int required = 1; required <= 4096; ++required)
+		{
+			const int grown = growBufferExtent(required);
+			DMLIB_CHECK(grown % kBufferGranularity == 0);
+			DMLIB_CHECK(grown >= required + (required / 4));
+			DMLIB_CHECK(grown < required + (required / 4) + kBufferGranularity);
+		}
+	}
+
+	void testGrowWhenTooSmall()
+	{
+		// no buffer yet
+		DMLIB_CHECK(getBufferExtent(0, 10) == 32);
+		// one pixel over current extent reallocates with headroom
+		DMLIB_CHECK(getBufferExtent(128, 129) == 192);
+		DMLIB_CHECK(getBufferExtent(128, 128) == 128);
+	}
+
+	void testNoShrinkWithinHysteresis()
+	{
+		// kept down to (current - granularity) / 2
+		DMLIB_CHECK(getBufferExtent(256, 256) == 256);
+		DMLIB_CHECK(getBufferExtent(256, 200) == 256);
+		DMLIB_CHECK(getBufferExtent(256, 112) == 256);
+
+		for (int required = 112; required <= 256; ++required)
+		{
+			DMLIB_CHECK(getBufferExtent(256, required) == 256);
+		}
+	}
+
+	void testShrinkPastThreshold()
+	{
+		DMLIB_CHECK(getBufferExtent(256, 111) == growBufferExtent(111));
+		DMLIB_CHECK(getBufferExtent(256, 111) == 160);
+		DMLIB_CHECK(getBufferExtent(256, 1) == 32);
+
+		// shrunk extent is itself stable for the same requirement
+		const int shrunk = getBufferExtent(256, 111);
+		DMLIB_CHECK(getBufferExtent(shrunk, 111) == shrunk);
+	}
+
+	void testResizeSequence()
+	{
+		// window resized pixel by pixel up and back down
+		int current = 0;
+		int reallocs = 0;
+		const auto step = [&](int required) {
+			const int next = getBufferExtent(current, required);
+			DMLIB_CHECK(next >= required);
+			if (next != current)
+			{
+				++reallocs;
+				current = next;
+			}
+		};
+
+		for (int required = 100; required <= 1000; ++required)
+		{
+			step(required);
+		}
+		const int growReallocs = reallocs;
+		DMLIB_CHECK(growReallocs <= 12);
+
+		for (int required = 1000; required >= 100; --required)
+		{
+			step(required);
+		}
+		DMLIB_CHECK(reallocs - growReallocs <= 4);
+	}
+} // anonymous namespace
+
+int main()
+{
+	testGrowth();
+	testGrowWhenTooSmall();
+	testNoShrinkWithinHysteresis();
+	testShrinkPastThreshold();
+	testResizeSequence();
+	return dmlib_test::finish("test_buffer_extent");
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibMsgFilter.h"
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	using dmlib_subclass::MsgFilter;
+
+	// values from winuser.h and commctrl.h
+	constexpr unsigned int kWmPaint = 0x000F;
+	constexpr unsigned int kWmNcDestroy = 0x0082;
+	constexpr unsigned int kWmMouseMove = 0x0200;
+	constexpr unsigned int kWmUser = 0x0400;
+	constexpr unsigned int kWmApp = 0x8000;
+	constexpr unsigned int kTcmFirst = 0x1300;
+	constexpr unsigned int kTcmSetImageList = kTcmFirst + 3;
+	constexpr unsigned int kTcmSetCurSel = kTcmFirst + 12;
+	constexpr unsigned int kTcmInsertItemW = kTcmFirst + 62;
+
+	constexpr MsgFilter kEdgeFilter{ 0, kWmNcDestroy, MsgFilter::kMaxMsg - 1 };
+
+	static_assert(kEdgeFilter.contains(0));
+	static_assert(kEdgeFilter.contains(MsgFilter::kMaxMsg - 1));
+	static_assert(!kEdgeFilter.contains(MsgFilter::kMaxMsg));
+
+	void testRangeEdges()
+	{
+		DMLIB_CHECK(kEdgeFilter.contains(0));
+		DMLIB_CHECK(kEdgeFilter.contains(kWmNcDestroy));
+		DMLIB_CHECK(kEdgeFilter.contains(MsgFilter::kMaxMsg - 1));
+		DMLIB_CHECK(!kEdgeFilter.contains(1));
+		DMLIB_CHECK(!kEdgeFilter.contains(kWmNcDestroy - 1));
+		DMLIB_CHECK(!kEdgeFilter.contains(kWmNcDestroy + 1));
+		DMLIB_CHECK(!kEdgeFilter.contains(MsgFilter::kMaxMsg - 2));
+
+		// no control range, nothing above kMaxMsg is contained
+		DMLIB_CHECK(!kEdgeFilter.contains(MsgFilter::kMaxMsg));
+		DMLIB_CHECK(!kEdgeFilter.contains(kWmApp));
+		DMLIB_CHECK(!kEdgeFilter.contains(0xFFFFFFFFU));
+	}
+
+	void testWordBoundaries()
+	{
+		constexpr MsgFilter filter{ 63, 64, 127, 128 };
+		DMLIB_CHECK(filter.contains(63));
+		DMLIB_CHECK(filter.contains(64));
+		DMLIB_CHECK(filter.contains(127));
+		DMLIB_CHECK(filter.contains(128));
+		DMLIB_CHECK(!filter.contains(62));
+		DMLIB_CHECK(!filter.contains(65));
+		DMLIB_CHECK(!filter.contains(126));
+		DMLIB_CHECK(!filter.contains(129));
+	}
+
+	void testCtrlRange()
+	{
+		constexpr MsgFilter filter{ kTcmFirst, {
+			kWmNcDestroy, kWmPaint,
+			kTcmFirst, kTcmSetImageList, kTcmSetCurSel, kTcmInsertItemW,
+			kTcmFirst + MsgFilter::kCtrlMsgCount - 1
+		} };
+		static_assert(filter.contains(kTcmInsertItemW));
+
+		DMLIB_CHECK(filter.contains(kWmNcDestroy));
+		DMLIB_CHECK(filter.contains(kWmPaint));
+		DMLIB_CHECK(!filter.contains(kWmMouseMove));
+
+		DMLIB_CHECK(filter.contains(kTcmFirst));
+		DMLIB_CHECK(filter.contains(kTcmSetImageList));
+		DMLIB_CHECK(filter.contains(kTcmSetCurSel));
+		DMLIB_CHECK(filter.contains(kTcmInsertItemW));
+		DMLIB_CHECK(filter.contains(kTcmFirst + MsgFilter::kCtrlMsgCount - 1));
+
+		DMLIB_CHECK(!filter.contains(kTcmFirst - 1));
+		DMLIB_CHECK(!filter.contains(kTcmFirst + 1));
+		DMLIB_CHECK(!filter.contains(kTcmInsertItemW + 1));
+		DMLIB_CHECK(!filter.contains(kTcmFirst + MsgFilter::kCtrlMsgCount));
+
+		// control range bits do not leak into low messages and vice versa
+		DMLIB_CHECK(!filter.contains(kTcmSetCurSel - kTcmFirst));
+		DMLIB_CHECK(!filter.contains(kTcmFirst + kWmPaint));
+	}
+
+	void testLowCtrlRange()
+	{
+		// control range below kMaxMsg, e.g. WM_USER based messages, uses the low bitmap
+		constexpr MsgFilter filter{ kWmUser, { kWmNcDestroy, kWmUser + 1 } };
+		DMLIB_CHECK(filter.contains(kWmNcDestroy));
+		DMLIB_CHECK(filter.contains(kWmUser + 1));
+		DMLIB_CHECK(!filter.contains(kWmUser));
+		DMLIB_CHECK(!filter.contains(kWmUser + 2));
+	}
+} // anonymous namespace
+
+int main()
+{
+	testRangeEdges();
+	testWordBoundaries();
+	testCtrlRange();
+	testLowCtrlRange();
+	return dmlib_test::finish("test_msgfilter");
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	std::ptrdiff_t g_stateBytes = 0;
+
+	/// Shaped like subclass reference data, with members of different alignment.
+	struct Data : public dmlib_subclass::PoolAllocated<Data>
+	{
+		double m_value = 0.0;
+		int m_id = 0;
+		char m_flag = 0;
+	};
+
+	/// Derived type with different size, must bypass the pool.
+	struct BigData : public Data
+	{
+		std::uint64_t m_extra[8]{};
+	};
+
+	void testReuse()
+	{
+		auto* first = new Data{};
+		DMLIB_CHECK(g_stateBytes == static_cast<std::ptrdiff_t>(sizeof(Data)));
+		first->m_id = 1;
+		void* const addr = first;
+		delete first;
+		DMLIB_CHECK(g_stateBytes == 0);
+
+		// freed slot is at the head of the thread-local free list
+		auto pData = std::make_unique<Data>();
+		DMLIB_CHECK(static_cast<void*>(pData.get()) == addr);
+		DMLIB_CHECK(pData->m_id == 0);
+		pData.reset();
+		DMLIB_CHECK(g_stateBytes == 0);
+	}
+
+	void testManyDistinct()
+	{
+		constexpr size_t kCount = 200; // several slabs
+		std::vector<std::unique_ptr<Data>> items;
+		std::set<const void*> addrs;
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			items.push_back(std::make_unique<Data>());
+			items.back()->m_id = static_cast<int>(i);
+			addrs.insert(items.back().get());
+			DMLIB_CHECK(reinterpret_cast<std::uintptr_t>(items.back().get()) % alignof(Data) == 0);
+		}
+		DMLIB_CHECK(addrs.size() == kCount);
+		DMLIB_CHECK(g_stateBytes == static_cast<std::ptrdiff_t>(kCount * sizeof(Data)));
+
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			DMLIB_CHECK(items[i]->m_id == static_cast<int>(i));
+		}
+
+		items.clear();
+		DMLIB_CHECK(g_stateBytes == 0);
+	}
+
+	void testDerivedBypassesPool()
+	{
+		auto pBig = std::make_unique<BigData>();
+		DMLIB_CHECK(g_stateBytes == static_cast<std::ptrdiff_t>(sizeof(BigData)));
+		pBig->m_extra[7] = 42;
+		pBig.reset();
+		DMLIB_CHECK(g_stateBytes == 0);
+	}
+
+	void testCrossThread()
+	{
+		std::vector<Data*> items;
+		std::thread producer([&items]() {
+			for (int i = 0; i < 100; ++i)
+			{
+				items.push_back(new Data{});
+			}
+		});
+		producer.join();
+
+		std::set<const void*> freed;
+		std::thread consumer([&items, &freed]() {
+			for (Data* pData : items)
+			{
+				freed.insert(pData);
+				delete pData;
+			}
+		}); // exiting thread returns its free slots to the shared list
+		consumer.join();
+		DMLIB_CHECK(g_stateBytes == 0);
+
+		// slots freed by the exited thread are reused by another thread
+		std::vector<std::unique_ptr<Data>> reused;
+		size_t hits = 0;
+		std::thread user([&reused, &freed, &hits]() {
+			for (int i = 0; i < 100; ++i)
+			{
+				reused.push_back(std::make_unique<Data>());
+				hits += freed.count(reused.back().get());
+			}
+			reused.clear();
+		});
+		user.join();
+		DMLIB_CHECK(hits > 0);
+		DMLIB_CHECK(g_stateBytes == 0);
+	}
+} // anonymous namespace
+
+void dmlib_subclass::addStateBytes(std::ptrdiff_t delta) noexcept
+{
+	g_stateBytes += delta;
+}
+
+int main()
+{
+	testReuse();
+	testManyDistinct();
+	testDerivedBypassesPool();
+	testCrossThread();
+	return dmlib_test::finish("test_pool");
+}
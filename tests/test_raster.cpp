@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibRaster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	constexpr std::uint32_t kBackground = 0x00000000;
+	constexpr std::uint32_t kWhite = 0x00FFFFFF;
+	constexpr std::uint32_t kFill = 0x00204060;
+	constexpr std::uint32_t kFrame = 0x00C0A080;
+
+	/// Pixel buffer with surface view.
+	struct Canvas
+	{
+		std::vector<std::uint32_t> m_pixels;
+		dmlib_raster::Surface m_surface{};
+
+		Canvas(int width, int height, std::uint32_t color = kBackground)
+			: m_pixels(static_cast<size_t>(width) * static_cast<size_t>(height), color)
+		{
+			m_surface = dmlib_raster::Surface{ m_pixels.data(), width, height, width };
+		}
+
+		[[nodiscard]] std::uint32_t at(int x, int y) const
+		{
+			return m_pixels[(static_cast<size_t>(y) * static_cast<size_t>(m_surface.m_width)) + static_cast<size_t>(x)];
+		}
+
+		[[nodiscard]] dmlib_raster::Rect all() const
+		{
+			return { 0, 0, m_surface.m_width, m_surface.m_height };
+		}
+	};
+
+	/// Reference coverage of pixel center, computed in double precision.
+	double refCoverage(int x, int y, const dmlib_raster::Rect& rc, double radius)
+	{
+		const double hw = (rc.m_right - rc.m_left) / 2.0;
+		const double hh = (rc.m_bottom - rc.m_top) / 2.0;
+		const double r = std::clamp(radius, 0.0, std::min(hw, hh));
+		const double qx = std::fabs(x + 0.5 - (rc.m_left + hw)) - (hw - r);
+		const double qy = std::fabs(y + 0.5 - (rc.m_top + hh)) - (hh - r);
+		const double outside = std::hypot(std::max(qx, 0.0), std::max(qy, 0.0));
+		const double dist = outside + std::min(std::max(qx, qy), 0.0) - r;
+		return std::clamp(0.5 - dist, 0.0, 1.0);
+	}
+
+	int channel(std::uint32_t color, int shift)
+	{
+		return static_cast<int>((color >> shift) & 0xFF);
+	}
+
+	/// Checks that colors differ at most by `tolerance` in each channel.
+	bool isNear(std::uint32_t lhs, std::uint32_t rhs, int tolerance = 1)
+	{
+		for (int shift = 0; shift <= 24; shift += 8)
+		{
+			if (std::abs(channel(lhs, shift) - channel(rhs, shift)) > tolerance)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	dmlib_raster::ShapeStyle fillStyle(std::uint32_t color)
+	{
+		return { color, 0, 0, true };
+	}
+} // anonymous namespace
+
+static void testFillSpan()
+{
+	for (int count : { 0, 1, 3, 4, 5, 7, 8, 9, 16, 17, 33 })
+	{
+		std::vector<std::uint32_t> pixels(static_cast<size_t>(count) + 2, kBackground);
+		dmlib_raster::fillSpan(pixels.data() + 1, count, kWhite);
+		DMLIB_CHECK(pixels.front() == kBackground);
+		DMLIB_CHECK(pixels.back() == kBackground);
+		DMLIB_CHECK(std::count(pixels.begin(), pixels.end(), kWhite) == count);
+	}
+
+	std::uint32_t pixel = kBackground;
+	dmlib_raster::fillSpan(&pixel, -5, kWhite);
+	DMLIB_CHECK(pixel == kBackground);
+}
+
+static void testKnownCoverage()
+{
+	// 20x20 with radius 4, white on black: channel value is coverage * 255
+	Canvas canvas{ 20, 20 };
+	const dmlib_raster::Rect rc{ 0, 0, 20, 20 };
+	dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), rc, 4, fillStyle(kWhite));
+
+	// corner pixel lies outside of the arc
+	DMLIB_CHECK(canvas.at(0, 0) == kBackground);
+	// distance of (1.5, 1.5) from arc center (4, 4) is 3.536, coverage 0.964
+	DMLIB_CHECK(channel(canvas.at(1, 1), 0) == 246);
+	// (0.5, 3.5) distance 3.536 as well
+	DMLIB_CHECK(channel(canvas.at(0, 3), 0) == 246);
+	// (0.5, 1.5) distance 4.301, coverage 0.199
+	DMLIB_CHECK(channel(canvas.at(0, 1), 0) == 51);
+	// (2.5, 0.5) distance 3.808, coverage 0.692
+	DMLIB_CHECK(channel(canvas.at(2, 0), 0) == 176);
+	// straight edges and interior are solid
+	DMLIB_CHECK(canvas.at(10, 0) == kWhite);
+	DMLIB_CHECK(canvas.at(0, 10) == kWhite);
+	DMLIB_CHECK(canvas.at(10, 10) == kWhite);
+
+	for (int radius : { 1, 2, 3, 5, 8, 10, 40 })
+	{
+		Canvas ref{ 24, 16 };
+		const dmlib_raster::Rect rcRef{ 2, 1, 22, 15 };
+		dmlib_raster::paintRoundRect(ref.m_surface, ref.all(), rcRef, radius, fillStyle(kWhite));
+		for (int y = 0; y < 16; ++y)
+		{
+			for (int x = 0; x < 24; ++x)
+			{
+				const bool isInside = x >= rcRef.m_left && x < rcRef.m_right && y >= rcRef.m_top && y < rcRef.m_bottom;
+				const double coverage = isInside ? refCoverage(x, y, rcRef, radius) : 0.0;
+				const int expected = static_cast<int>((coverage * 255.0) + 0.5);
+				DMLIB_CHECK(std::abs(channel(ref.at(x, y), 0) - expected) <= 1);
+			}
+		}
+	}
+}
+
+static void testCornerSymmetry()
+{
+	constexpr int kSize = 17;
+	Canvas canvas{ kSize, kSize };
+	dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), canvas.all(), 6, fillStyle(kWhite));
+
+	for (int y = 0; y < kSize; ++y)
+	{
+		for (int x = 0; x < kSize; ++x)
+		{
+			const std::uint32_t value = canvas.at(x, y);
+			DMLIB_CHECK(value == canvas.at(kSize - 1 - x, y));
+			DMLIB_CHECK(value == canvas.at(x, kSize - 1 - y));
+			DMLIB_CHECK(value == canvas.at(y, x));
+		}
+	}
+}
+
+static void testZeroRadiusMatchesRectangle()
+{
+	Canvas canvas{ 12, 10 };
+	const dmlib_raster::Rect rc{ 2, 2, 10, 8 };
+	const dmlib_raster::ShapeStyle style{ kFill, kFrame, 1, true };
+	dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), rc, 0, style);
+
+	for (int y = 0; y < 10; ++y)
+	{
+		for (int x = 0; x < 12; ++x)
+		{
+			std::uint32_t expected = kBackground;
+			if (x >= 2 && x < 10 && y >= 2 && y < 8)
+			{
+				const bool isEdge = x == 2 || x == 9 || y == 2 || y == 7;
+				expected = isEdge ? kFrame : kFill;
+			}
+			DMLIB_CHECK(canvas.at(x, y) == expected);
+		}
+	}
+}
+
+static void testOnePixel()
+{
+	for (int radius : { 0, 1, 5 })
+	{
+		Canvas canvas{ 5, 5 };
+		dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), { 2, 2, 3, 3 }, radius, fillStyle(kFill));
+		for (int y = 0; y < 5; ++y)
+		{
+			for (int x = 0; x < 5; ++x)
+			{
+				DMLIB_CHECK(canvas.at(x, y) == ((x == 2 && y == 2) ? kFill : kBackground));
+			}
+		}
+	}
+
+	// 1 px wide line with radius is clamped to half width and fully covered
+	Canvas line{ 3, 10 };
+	dmlib_raster::paintRoundRect(line.m_surface, line.all(), { 1, 0, 2, 10 }, 3, fillStyle(kFill));
+	for (int y = 0; y < 10; ++y)
+	{
+		DMLIB_CHECK(line.at(0, y) == kBackground);
+		DMLIB_CHECK(line.at(1, y) == kFill);
+		DMLIB_CHECK(line.at(2, y) == kBackground);
+	}
+
+	// 1 px frame of 1 px rectangle is the frame color only
+	Canvas framed{ 3, 3 };
+	dmlib_raster::paintRoundRect(framed.m_surface, framed.all(), { 1, 1, 2, 2 }, 0, { kFill, kFrame, 1, true });
+	DMLIB_CHECK(framed.at(1, 1) == kFrame);
+}
+
+static void testFrameOnly()
+{
+	Canvas canvas{ 16, 16, kWhite };
+	const dmlib_raster::ShapeStyle style{ 0, kFrame, 2, false };
+	dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), canvas.all(), 4, style);
+
+	DMLIB_CHECK(canvas.at(8, 0) == kFrame);
+	DMLIB_CHECK(canvas.at(8, 1) == kFrame);
+	DMLIB_CHECK(canvas.at(8, 2) == kWhite);
+	DMLIB_CHECK(canvas.at(0, 8) == kFrame);
+	DMLIB_CHECK(canvas.at(15, 8) == kFrame);
+	DMLIB_CHECK(canvas.at(8, 8) == kWhite);
+	// corner outside of the arc keeps destination
+	DMLIB_CHECK(canvas.at(0, 0) == kWhite);
+}
+
+static void testClipAndDegenerate()
+{
+	Canvas canvas{ 10, 10 };
+	const dmlib_raster::Rect clip{ 3, 3, 6, 6 };
+	dmlib_raster::paintRoundRect(canvas.m_surface, clip, canvas.all(), 2, fillStyle(kFill));
+	for (int y = 0; y < 10; ++y)
+	{
+		for (int x = 0; x < 10; ++x)
+		{
+			const bool isClipped = x >= 3 && x < 6 && y >= 3 && y < 6;
+			DMLIB_CHECK(canvas.at(x, y) == (isClipped ? kFill : kBackground));
+		}
+	}
+
+	// shape partly outside of surface
+	Canvas edge{ 6, 6 };
+	dmlib_raster::paintRoundRect(edge.m_surface, { -10, -10, 20, 20 }, { -4, -4, 4, 4 }, 2, fillStyle(kFill));
+	DMLIB_CHECK(edge.at(0, 0) == kFill);
+	DMLIB_CHECK(edge.at(4, 4) == kBackground);
+
+	Canvas empty{ 4, 4 };
+	dmlib_raster::paintRoundRect(empty.m_surface, empty.all(), { 2, 2, 2, 4 }, 1, fillStyle(kFill));
+	dmlib_raster::paintRoundRect(empty.m_surface, empty.all(), { 3, 3, 1, 1 }, 1, fillStyle(kFill));
+	dmlib_raster::paintRoundRect(empty.m_surface, empty.all(), empty.all(), 1, { kFill, kFrame, 0, false });
+	DMLIB_CHECK(std::all_of(empty.m_pixels.begin(), empty.m_pixels.end(), [](std::uint32_t px) { return px == kBackground; }));
+}
+
+static void testBlendKeepsAlpha()
+{
+	Canvas canvas{ 8, 8, 0xFF000000 };
+	dmlib_raster::paintRoundRect(canvas.m_surface, canvas.all(), canvas.all(), 3, fillStyle(kWhite));
+	// antialiased pixel keeps destination alpha byte
+	DMLIB_CHECK((canvas.at(0, 1) & 0xFF000000) == 0xFF000000);
+	const int red = channel(canvas.at(0, 1), 16);
+	DMLIB_CHECK(red > 0 && red < 255);
+	DMLIB_CHECK(isNear(canvas.at(0, 1), 0xFF000000 | (static_cast<std::uint32_t>(red) * 0x010101)));
+}
+
+static void testBottomUpSurface()
+{
+	Canvas topDown{ 9, 7 };
+	dmlib_raster::paintRoundRect(topDown.m_surface, topDown.all(), { 1, 1, 8, 6 }, 2, { kFill, kFrame, 1, true });
+
+	// bottom-up memory: first row in memory is the bottom row
+	std::vector<std::uint32_t> memory(9 * 7, kBackground);
+	dmlib_raster::Surface bottomUp{ memory.data() + (9 * 6), 9, 7, -9 };
+	dmlib_raster::paintRoundRect(bottomUp, { 0, 0, 9, 7 }, { 1, 1, 8, 6 }, 2, { kFill, kFrame, 1, true });
+
+	for (int y = 0; y < 7; ++y)
+	{
+		for (int x = 0; x < 9; ++x)
+		{
+			DMLIB_CHECK(memory[static_cast<size_t>((6 - y) * 9 + x)] == topDown.at(x, y));
+		}
+	}
+}
+
+int main()
+{
+	testFillSpan();
+	testKnownCoverage();
+	testCornerSymmetry();
+	testZeroRadiusMatchesRectangle();
+	testOnePixel();
+	testFrameOnly();
+	testClipAndDegenerate();
+	testBlendKeepsAlpha();
+	testBottomUpSurface();
+	return dmlib_test::finish("test_raster");
+}
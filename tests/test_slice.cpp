@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibSlice.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DmlibTest.h"
+#include "FakeClock.h"
+
+using dmlib_test::FakeClock;
+
+namespace // anonymous
+{
+	/// Simplified asynchronous theming job, processed items are counted per index.
+	struct Job
+	{
+		std::vector<int> m_processed;
+		size_t m_next = 0;
+	};
+
+	/**
+	 * @brief Runs slices until the job is done, each item costs `itemMs`.
+	 *
+	 * @return Number of slices.
+	 */
+	size_t runJob(Job& job, FakeClock::rep budgetMs, FakeClock::rep itemMs)
+	{
+		size_t slices = 0;
+		bool isDone = false;
+		while (!isDone)
+		{
+			++slices;
+			isDone = dmlib_slice::runSlice<FakeClock>(FakeClock::duration{ budgetMs }, [&job, itemMs]() -> bool {
+				if (job.m_next >= job.m_processed.size())
+				{
+					return false;
+				}
+				++job.m_processed[job.m_next++];
+				FakeClock::advance(itemMs);
+				return job.m_next < job.m_processed.size();
+			});
+		}
+		return slices;
+	}
+
+	/**
+	 * @struct MockTree
+	 * @brief Window tree shaped like a property sheet, node `0` means no node.
+	 *
+	 * Node 1 is the root, nodes are added in pre-order like `EnumChildWindows` returns them.
+	 */
+	struct MockTree
+	{
+		struct Node
+		{
+			int m_parent = 0;
+			bool m_isVisible = true;
+		};
+
+		std::vector<Node> m_nodes{ Node{}, Node{} }; // unused 0 and root 1
+
+		int add(int parent, bool isVisible)
+		{
+			m_nodes.push_back(Node{ parent, isVisible });
+			return static_cast<int>(m_nodes.size()) - 1;
+		}
+
+		[[nodiscard]] int findHidden(int node) const
+		{
+			return dmlib_slice::findHiddenAncestor(node, 1,
+				[this](int current) { return m_nodes[static_cast<size_t>(current)].m_parent; },
+				[this](int current) { return m_nodes[static_cast<size_t>(current)].m_isVisible; });
+		}
+
+		[[nodiscard]] bool isShown(int node) const
+		{
+			return m_nodes[static_cast<size_t>(node)].m_isVisible && findHidden(node) == 0;
+		}
+	};
+
+	bool isEachProcessedOnce(const Job& job)
+	{
+		for (const int count : job.m_processed)
+		{
+			if (count != 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+} // anonymous namespace
+
+static void testSliceMs()
+{
+	DMLIB_CHECK(dmlib_slice::getSliceMs(0) == dmlib_slice::kDefaultSliceMs);
+	DMLIB_CHECK(dmlib_slice::getSliceMs(1) == 1);
+	DMLIB_CHECK(dmlib_slice::getSliceMs(50) == 50);
+}
+
+static void testEmpty()
+{
+	int calls = 0;
+	const bool isDone = dmlib_slice::runSlice<FakeClock>(FakeClock::duration{ 8 }, [&calls]() -> bool {
+		++calls;
+		return false;
+	});
+	DMLIB_CHECK(isDone);
+	DMLIB_CHECK(calls == 1);
+}
+
+static void testBudget()
+{
+	Job job;
+	job.m_processed.resize(100);
+
+	// 1 ms per item, 8 ms budget: 8 items per slice
+	const size_t slices = runJob(job, 8, 1);
+	DMLIB_CHECK(slices == 13);
+	DMLIB_CHECK(isEachProcessedOnce(job));
+}
+
+static void testBudgetExactMultiple()
+{
+	Job job;
+	job.m_processed.resize(64);
+
+	// last item reports no more items, no empty trailing slice
+	const size_t slices = runJob(job, 8, 1);
+	DMLIB_CHECK(slices == 8);
+	DMLIB_CHECK(isEachProcessedOnce(job));
+}
+
+static void testSlowItems()
+{
+	Job job;
+	job.m_processed.resize(10);
+
+	// item longer than budget, still one item per slice
+	const size_t slices = runJob(job, 8, 20);
+	DMLIB_CHECK(slices == 10);
+	DMLIB_CHECK(isEachProcessedOnce(job));
+}
+
+static void testFreeItems()
+{
+	Job job;
+	job.m_processed.resize(1000);
+
+	const size_t slices = runJob(job, 8, 0);
+	DMLIB_CHECK(slices == 1);
+	DMLIB_CHECK(isEachProcessedOnce(job));
+}
+
+/**
+ * Simulates re-entrant job list changes: while an item is processed,
+ * jobs can be restarted (replaced by a new job with new id) or removed.
+ * Items are taken by re-looking up the job by its id, as the timer procedure does.
+ */
+static void testStressReentrant()
+{
+	std::mt19937 rng{ 12345 };
+	std::uniform_int_distribution<int> costDist{ 0, 3 };
+	std::uniform_int_distribution<int> eventDist{ 0, 999 };
+	std::uniform_int_distribution<int> sizeDist{ 0, 300 };
+
+	std::map<unsigned, Job> jobs;
+	unsigned nextId = 1;
+	for (int i = 0; i < 16; ++i)
+	{
+		jobs[nextId++].m_processed.resize(static_cast<size_t>(sizeDist(rng)));
+	}
+
+	std::vector<Job> finished;
+	size_t totalSlices = 0;
+	while (!jobs.empty() && totalSlices < 1000000)
+	{
+		const unsigned id = jobs.begin()->first;
+		++totalSlices;
+
+		const bool isDone = dmlib_slice::runSlice<FakeClock>(FakeClock::duration{ 8 }, [&]() -> bool {
+			auto it = jobs.find(id);
+			if (it == jobs.end() || it->second.m_next >= it->second.m_processed.size())
+			{
+				return false;
+			}
+
+			Job& job = it->second;
+			++job.m_processed[job.m_next++];
+			const bool hasMore = job.m_next < job.m_processed.size();
+			FakeClock::advance(costDist(rng));
+
+			// re-entrant changes, invalidate references into the job list
+			const int event = eventDist(rng);
+			if (event < 2)
+			{
+				// restart: old job dropped, new job with new id
+				jobs.erase(it);
+				jobs[nextId++].m_processed.resize(static_cast<size_t>(sizeDist(rng)));
+				return false;
+			}
+			if (event == 2)
+			{
+				jobs[nextId++].m_processed.resize(static_cast<size_t>(sizeDist(rng)));
+			}
+			return hasMore;
+		});
+
+		if (isDone)
+		{
+			auto it = jobs.find(id);
+			if (it != jobs.end())
+			{
+				finished.push_back(std::move(it->second));
+				jobs.erase(it);
+			}
+		}
+	}
+
+	DMLIB_CHECK(jobs.empty());
+	DMLIB_CHECK(!finished.empty());
+	for (const auto& job : finished)
+	{
+		DMLIB_CHECK(isEachProcessedOnce(job));
+	}
+}
+
+static void testHiddenAncestor()
+{
+	MockTree tree;
+	const int shownPage = tree.add(1, true);
+	const int shownCtrl = tree.add(shownPage, true);
+	const int hiddenCtrl = tree.add(shownPage, false);
+	const int hiddenPage = tree.add(1, false);
+	const int hiddenGroup = tree.add(hiddenPage, false);
+	const int nestedCtrl = tree.add(hiddenGroup, true);
+	const int groupOnHidden = tree.add(hiddenPage, true);
+	const int ctrlInGroup = tree.add(groupOnHidden, true);
+
+	DMLIB_CHECK(tree.findHidden(shownPage) == 0);
+	DMLIB_CHECK(tree.findHidden(shownCtrl) == 0);
+	// node itself is not checked
+	DMLIB_CHECK(tree.findHidden(hiddenCtrl) == 0);
+	DMLIB_CHECK(tree.findHidden(hiddenPage) == 0);
+	// outermost hidden ancestor, closest to the root
+	DMLIB_CHECK(tree.findHidden(nestedCtrl) == hiddenPage);
+	DMLIB_CHECK(tree.findHidden(ctrlInGroup) == hiddenPage);
+
+	// hidden root is not checked
+	tree.m_nodes[1].m_isVisible = false;
+	DMLIB_CHECK(tree.findHidden(shownCtrl) == 0);
+
+	// walk stops after node without parent, e.g. window without `WS_CHILD`
+	tree.m_nodes[static_cast<size_t>(hiddenGroup)].m_parent = 0;
+	DMLIB_CHECK(tree.findHidden(nestedCtrl) == hiddenGroup);
+}
+
+static void testShownFirstOrder()
+{
+	MockTree tree;
+	std::vector<int> items;
+	const int page1 = tree.add(1, false);
+	items.push_back(page1);
+	items.push_back(tree.add(page1, true));
+	items.push_back(tree.add(page1, true));
+	const int page2 = tree.add(1, true);
+	items.push_back(page2);
+	const int group = tree.add(page2, true);
+	items.push_back(group);
+	items.push_back(tree.add(group, true));
+	items.push_back(tree.add(group, false));
+	items.push_back(tree.add(page2, true));
+	const int page3 = tree.add(1, false);
+	items.push_back(page3);
+	items.push_back(tree.add(page3, true));
+
+	const auto itHidden = dmlib_slice::orderShownFirst(items.begin(), items.end(), [&tree](int node) {
+		return tree.isShown(node);
+	});
+
+	// shown items first, both groups keep pre-order
+	const std::vector<int> expected{ 5, 6, 7, 9, 2, 3, 4, 8, 10, 11 };
+	DMLIB_CHECK(items == expected);
+	DMLIB_CHECK(itHidden - items.begin() == 4);
+	DMLIB_CHECK(std::all_of(items.begin(), itHidden, [&tree](int node) { return tree.isShown(node); }));
+	DMLIB_CHECK(std::none_of(itHidden, items.end(), [&tree](int node) { return tree.isShown(node); }));
+
+	std::vector<int> empty;
+	DMLIB_CHECK(dmlib_slice::orderShownFirst(empty.begin(), empty.end(), [](int) { return true; }) == empty.end());
+}
+
+int main()
+{
+	testSliceMs();
+	testEmpty();
+	testBudget();
+	testBudgetExactMultiple();
+	testSlowItems();
+	testFreeItems();
+	testStressReentrant();
+	testHiddenAncestor();
+	testShownFirstOrder();
+	return dmlib_test::finish("test_slice");
+}
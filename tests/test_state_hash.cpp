@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MPL-2.0
+
+/*
+ * Copyright (c) 2025 ozone10
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// This file is part of darkmodelib library.
+
+
+#include "DmlibStateHash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "DmlibTest.h"
+
+namespace // anonymous
+{
+	// values from vsstyle.h
+	constexpr int kBpRadioButton = 2;
+	constexpr int kBpCheckBox = 3;
+	constexpr int kCbsUncheckedNormal = 1;
+	constexpr int kCbsMixedDisabled = 12;
+
+	constexpr std::uint32_t kDarkText = 0x00E0E0E0;
+	constexpr std::uint32_t kLightText = 0x00000000;
+
+	const std::wstring g_text = L"&Enable option";
+
+	dmlib_subclass::ButtonPaintKey makeKey()
+	{
+		dmlib_subclass::ButtonPaintKey key{};
+		key.m_partID = kBpCheckBox;
+		key.m_stateID = kCbsUncheckedNormal;
+		key.m_width = 120;
+		key.m_height = 17;
+		key.m_dpi = 96;
+		key.m_theme = 0x10020;
+		key.m_hasFocus = false;
+		key.m_isEnabled = true;
+		key.m_textColor = kDarkText;
+		key.m_disabledTextColor = 0x00808080;
+		key.m_bgColor = 0x00202020;
+		key.m_originX = 12;
+		key.m_originY = 40;
+		key.m_parentBrush = 0x1900A4;
+		key.m_parentBrushColor = 0x00202020;
+		key.m_text = g_text.c_str();
+		key.m_textLength = g_text.size();
+		return key;
+	}
+
+	using Mutation = std::function<void(dmlib_subclass::ButtonPaintKey&)>;
+} // anonymous namespace
+
+static void testDeterministic()
+{
+	const auto key = makeKey();
+	DMLIB_CHECK(dmlib_subclass::hashButtonPaintKey(key) == dmlib_subclass::hashButtonPaintKey(makeKey()));
+
+	// same text in different buffer gives same hash
+	const std::wstring copy = g_text;
+	auto keyCopy = makeKey();
+	keyCopy.m_text = copy.c_str();
+	DMLIB_CHECK(dmlib_subclass::hashButtonPaintKey(key) == dmlib_subclass::hashButtonPaintKey(keyCopy));
+
+	static_assert(dmlib_subclass::StateHash{}.add(1).value() == dmlib_subclass::StateHash{}.add(1).value());
+	static_assert(dmlib_subclass::StateHash{}.add(1).add(2).value() != dmlib_subclass::StateHash{}.add(2).add(1).value());
+}
+
+static void testEveryInputChangesHash()
+{
+	const std::wstring otherText = L"&Enable options";
+	const std::wstring sameLengthText = L"&Disable optio";
+
+	const std::vector<std::pair<const char*, Mutation>> mutations{
+		{ "part", [](auto& key) { key.m_partID = kBpRadioButton; } },
+		{ "state", [](auto& key) { key.m_stateID = kCbsMixedDisabled; } },
+		{ "hot state", [](auto& key) { key.m_stateID = kCbsUncheckedNormal + 1; } },
+		{ "pressed state", [](auto& key) { key.m_stateID = kCbsUncheckedNormal + 2; } },
+		{ "width", [](auto& key) { key.m_width += 1; } },
+		{ "height", [](auto& key) { key.m_height += 1; } },
+		{ "dpi", [](auto& key) { key.m_dpi = 144; } },
+		{ "theme", [](auto& key) { key.m_theme += 8; } },
+		{ "focus", [](auto& key) { key.m_hasFocus = true; } },
+		{ "enabled", [](auto& key) { key.m_isEnabled = false; } },
+		{ "text color", [](auto& key) { key.m_textColor = kLightText; } },
+		{ "disabled text color", [](auto& key) { key.m_disabledTextColor = 0x00808081; } },
+		{ "background color", [](auto& key) { key.m_bgColor = 0x00F0F0F0; } },
+		{ "moved x", [](auto& key) { key.m_originX += 1; } },
+		{ "moved y", [](auto& key) { key.m_originY += 1; } },
+		{ "swapped origin", [](auto& key) { key.m_originX = 40; key.m_originY = 12; } },
+		{ "parent brush", [](auto& key) { key.m_parentBrush += 4; } },
+		{ "parent brush color", [](auto& key) { key.m_parentBrushColor = 0x00303030; } },
+		{ "text", [&otherText](auto& key) { key.m_text = otherText.c_str(); key.m_textLength = otherText.size(); } },
+		{ "same length text", [&sameLengthText](auto& key) { key.m_text = sameLengthText.c_str(); } },
+		{ "text length", [](auto& key) { key.m_textLength -= 1; } },
+		{ "no text", [](auto& key) { key.m_text = nullptr; } },
+	};
+
+	const auto baseHash = dmlib_subclass::hashButtonPaintKey(makeKey());
+	std::set<std::uint64_t> hashes{ baseHash };
+	for (const auto& [name, mutate] : mutations)
+	{
+		auto key = makeKey();
+		mutate(key);
+		const auto hash = dmlib_subclass::hashButtonPaintKey(key);
+		if (hash == baseHash)
+		{
+			std::fprintf(stderr, "input not covered by hash: %s\n", name);
+		}
+		DMLIB_CHECK(hash != baseHash);
+		hashes.insert(hash);
+	}
+	// mutations also do not collide with each other
+	DMLIB_CHECK(hashes.size() == mutations.size() + 1);
+}
+
+static void testNoCollisionsInStateSpace()
+{
+	// all realistic combinations of state, focus, enabled, size, DPI, and mode colors
+	std::set<std::uint64_t> hashes;
+	size_t count = 0;
+	for (int part : { kBpRadioButton, kBpCheckBox })
+	{
+		for (int state = 1; state <= 20; ++state)
+		{
+			for (bool hasFocus : { false, true })
+			{
+				for (bool isEnabled : { false, true })
+				{
+					for (unsigned int dpi : { 96U, 120U, 144U, 168U, 192U, 288U })
+					{
+						for (std::uint32_t textColor : { kDarkText, kLightText })
+						{
+							for (int width = 10; width < 200; width += 7)
+							{
+								auto key = makeKey();
+								key.m_partID = part;
+								key.m_stateID = state;
+								key.m_hasFocus = hasFocus;
+								key.m_isEnabled = isEnabled;
+								key.m_dpi = dpi;
+								key.m_textColor = textColor;
+								key.m_width = width;
+								key.m_height = static_cast<int>((dpi * 13) / 96);
+								hashes.insert(dmlib_subclass::hashButtonPaintKey(key));
+								++count;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	DMLIB_CHECK(hashes.size() == count);
+}
+
+static void testTextBoundaries()
+{
+	// text length is hashed, so texts cannot shift into neighbouring inputs
+	const wchar_t ab[] = L"ab";
+	const auto lhs = dmlib_subclass::StateHash{}.addText(ab, 1).add(static_cast<std::uint16_t>(L'b')).value();
+	const auto rhs = dmlib_subclass::StateHash{}.addText(ab, 2).value();
+	DMLIB_CHECK(lhs != rhs);
+
+	const auto empty = dmlib_subclass::StateHash{}.addText(nullptr, 0).value();
+	DMLIB_CHECK(empty != dmlib_subclass::StateHash{}.value());
+}
+
+int main()
+{
+	testDeterministic();
+	testEveryInputChangesHash();
+	testNoCollisionsInStateSpace();
+	testTextBoundaries();
+	return dmlib_test::finish("test_state_hash");
+}